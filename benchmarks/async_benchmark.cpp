@@ -0,0 +1,77 @@
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "cuid2/async.hpp"
+#include "cuid2/pool.hpp"
+
+namespace {
+    /// Fire-and-forget coroutine that starts immediately.
+    struct Task {
+        struct promise_type {
+            Task get_return_object() noexcept {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() noexcept {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept {
+                return {};
+            }
+
+            void return_void() noexcept {}
+
+            void unhandled_exception() noexcept {
+                std::terminate();
+            }
+        };
+    };
+
+    /// Awaits one request and raises done once the coroutine has resumed.
+    Task await_ids(const std::size_t COUNT, visus::cuid2::AsyncOptions options, std::atomic<bool>& done) {
+        benchmark::DoNotOptimize(co_await visus::cuid2::async_generate(COUNT, std::move(options)));
+
+        done.store(true, std::memory_order_release);
+        done.notify_one();
+    }
+
+    /// Round trip through the shared worker thread, including the hand-off
+    /// and resumption on the worker.
+    void BM_AsyncGenerateWorker(benchmark::State& state) {
+        const auto COUNT = static_cast<std::size_t>(state.range(0));
+
+        for (auto _ : state) {
+            std::atomic<bool> done{false};
+            await_ids(COUNT, {}, done);
+            done.wait(false, std::memory_order_acquire);
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(COUNT));
+    }
+
+    /// Requests served from a pool without suspending.
+    void BM_AsyncGeneratePool(benchmark::State& state) {
+        const auto COUNT = static_cast<std::size_t>(state.range(0));
+        visus::cuid2::Pool pool({.capacity = 65536});
+
+        for (auto _ : state) {
+            std::atomic<bool> done{false};
+            await_ids(COUNT, {.pool = &pool}, done);
+            done.wait(false, std::memory_order_acquire);
+        }
+
+        state.counters["hit_rate"] = pool.stats().hit_rate();
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(COUNT));
+    }
+} // anonymous namespace
+
+BENCHMARK(BM_AsyncGenerateWorker)->ArgName("count")->Arg(1)->Arg(64)->UseRealTime();
+
+BENCHMARK(BM_AsyncGeneratePool)->ArgName("count")->Arg(1)->Arg(64)->UseRealTime();
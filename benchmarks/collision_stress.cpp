@@ -0,0 +1,861 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "cuid2/cuid2.hpp"
+#include "cuid2/generator.hpp"
+#include "cuid2/utils.hpp"
+
+#include <fmt/core.h>
+
+namespace {
+    /// Longest identifier whose base-36 value fits in 128 bits.
+    constexpr int MAX_STRESS_LENGTH = 24;
+
+    /// Longest identifier whose base-36 value fits in 64 bits.
+    constexpr int MAX_NARROW_LENGTH = 12;
+
+    constexpr std::size_t RADIX = visus::cuid2::utils::BASE36_ALPHABET.size();
+
+    /// Key type for lengths above MAX_NARROW_LENGTH (a GCC and Clang extension).
+    __extension__ typedef unsigned __int128 WideKey;
+
+    /// Hash characters counted jointly, starting at position 1: the leading
+    /// digits of one number, which are correlated with each other.
+    constexpr std::size_t JOINT_FIRST = 1;
+    constexpr std::size_t JOINT_POSITIONS = 3;
+    constexpr std::size_t JOINT_CELLS = RADIX * RADIX * RADIX;
+
+    /// Identifiers generated per batch call and claimed per work item.
+    constexpr uint64_t BATCH_SIZE = 4096;
+
+    /// Keys buffered per shard by each thread before being appended to disk.
+    constexpr std::size_t SHARD_BUFFER_KEYS = 512;
+
+    /// Bounds on the number of shards; each process keeps one file per shard open.
+    constexpr unsigned MIN_SHARDS = 16;
+    constexpr unsigned MAX_SHARDS = 512;
+
+    /// Upper bounds for --threads and --processes.
+    constexpr unsigned MAX_THREADS = 1024;
+    constexpr unsigned MAX_PROCESSES = 256;
+
+    /// Duplicated identifiers listed in the report.
+    constexpr std::size_t MAX_EXAMPLES = 8;
+
+    /// Standard normal quantile for a one-sided tail of 1e-6, used for the
+    /// chi-squared limit and the --check margin.
+    constexpr double Z_LIMIT = 4.753;
+
+    /// Interval between progress lines on stderr.
+    constexpr auto PROGRESS_INTERVAL = std::chrono::seconds(10);
+
+    /// Parsed command-line options.
+    struct Options {
+        int length = 12;
+        uint64_t count = 100'000'000;
+        unsigned threads = std::max(1U, std::thread::hardware_concurrency());
+        unsigned processes = 1;
+        uint64_t memory_mib = 1024;
+        std::filesystem::path directory = std::filesystem::temp_directory_path();
+        bool histogram = false;
+        bool check = false;
+    };
+
+    /// Counters shared by every process of a run.
+    ///
+    /// Lives in an anonymous shared mapping created before fork(), so children
+    /// publish their results with plain atomic adds and need no pipe protocol.
+    struct SharedCounts {
+        /// Occurrences of each character at each position.
+        std::array<std::array<std::atomic<uint64_t>, RADIX>, MAX_STRESS_LENGTH> characters{};
+
+        /// Occurrences of each combination of the JOINT_POSITIONS characters after the first.
+        std::array<std::atomic<uint64_t>, JOINT_CELLS> leading{};
+
+        /// Identifiers generated so far, for progress reports.
+        std::atomic<uint64_t> generated{0};
+
+        /// Records holding a character outside the base-36 alphabet.
+        std::atomic<uint64_t> malformed{0};
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "counters are shared between processes");
+
+    /// Per-thread character counts, merged into SharedCounts once at the end.
+    using Histogram = std::array<std::array<uint64_t, RADIX>, MAX_STRESS_LENGTH>;
+
+    /// Base-36 digit values by character; 0xFF for characters outside the alphabet.
+    constexpr std::array<uint8_t, 256> DIGIT_VALUES = [] {
+        std::array<uint8_t, 256> values{};
+        values.fill(0xFF);
+
+        for (std::size_t idx = 0; idx < RADIX; ++idx) {
+            values[static_cast<uint8_t>(visus::cuid2::utils::BASE36_ALPHABET[idx])] = static_cast<uint8_t>(idx);
+        }
+
+        return values;
+    }();
+
+    /// Collision statistics gathered while counting the shards.
+    struct Duplicates {
+        /// Identifiers equal to one generated earlier (samples minus distinct values).
+        uint64_t repeats = 0;
+
+        /// Some of the values seen more than once.
+        std::vector<std::string> examples;
+    };
+
+    void print_help(std::string_view program_name) noexcept {
+        fmt::print(
+            "Usage: {} [OPTIONS]\n\n"
+            "Generate identifiers at scale, count exact collisions and compare them with the\n"
+            "birthday bound, and check the per-position character distribution.\n\n"
+            "Options:\n"
+            "  -l, --length <num>     Identifier length (default: 12, min: 4, max: {})\n"
+            "  -n, --count <num>      Total identifiers to generate (default: 100000000)\n"
+            "  -t, --threads <num>    Threads per process (default: hardware threads, max: {})\n"
+            "  -p, --processes <num>  Forked processes sharing the work (default: 1, max: {})\n"
+            "  -m, --memory <MiB>     Memory budget for counting (default: 1024)\n"
+            "  -d, --directory <dir>  Where shard files are written (default: system temp dir)\n"
+            "  --histogram            Print the relative frequency of every character\n"
+            "  --check                Exit with status 2 if collisions exceed the bound\n"
+            "  -h, --help             Display this help message and exit\n\n"
+            "Shard files take 8 bytes per identifier up to length {} and 16 above.\n\n"
+            "Examples:\n"
+            "  {} -l 12 -n 10000000000 -t 16 -p 4 -d /scratch\n"
+            "  {} -l 8 -n 2000000 --check\n",
+            program_name, MAX_STRESS_LENGTH, MAX_THREADS, MAX_PROCESSES, MAX_NARROW_LENGTH, program_name,
+            program_name);
+    }
+
+    [[nodiscard]] constexpr bool is_help_flag(std::string_view arg) noexcept {
+        return arg == "-h" || arg == "--help";
+    }
+
+    [[nodiscard]] constexpr bool is_length_flag(std::string_view arg) noexcept {
+        return arg == "-l" || arg == "--length";
+    }
+
+    [[nodiscard]] constexpr bool is_count_flag(std::string_view arg) noexcept {
+        return arg == "-n" || arg == "--count";
+    }
+
+    [[nodiscard]] constexpr bool is_threads_flag(std::string_view arg) noexcept {
+        return arg == "-t" || arg == "--threads";
+    }
+
+    [[nodiscard]] constexpr bool is_processes_flag(std::string_view arg) noexcept {
+        return arg == "-p" || arg == "--processes";
+    }
+
+    [[nodiscard]] constexpr bool is_memory_flag(std::string_view arg) noexcept {
+        return arg == "-m" || arg == "--memory";
+    }
+
+    [[nodiscard]] constexpr bool is_directory_flag(std::string_view arg) noexcept {
+        return arg == "-d" || arg == "--directory";
+    }
+
+    /// Parses the whole of VALUE as a decimal integer.
+    ///
+    /// @return true if VALUE is a valid number representable by T
+    template <typename T>
+    [[nodiscard]] bool parse_number(std::string_view VALUE, T& out) noexcept {
+        const auto [ptr, ec] = std::from_chars(VALUE.data(), VALUE.data() + VALUE.size(), out);
+
+        return ec == std::errc{} && ptr == VALUE.data() + VALUE.size();
+    }
+
+    /// Mixes a key into a shard index (the splitmix64 finalizer).
+    ///
+    /// Keys are not uniform in their leading digits, so their high bits cannot
+    /// be used directly.
+    [[nodiscard]] constexpr uint64_t mix(uint64_t value) noexcept {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+
+        return value ^ (value >> 31);
+    }
+
+    template <typename Key>
+    [[nodiscard]] constexpr uint64_t fold(const Key KEY) noexcept {
+        if constexpr (sizeof(Key) > sizeof(uint64_t)) {
+            return static_cast<uint64_t>(KEY) ^ static_cast<uint64_t>(KEY >> 64);
+        } else {
+            return KEY;
+        }
+    }
+
+    /// Converts a key back into the identifier it was packed from.
+    template <typename Key>
+    [[nodiscard]] std::string unpack(Key key, const int LENGTH) {
+        std::string id(static_cast<std::size_t>(LENGTH), '0');
+
+        for (auto it = id.rbegin(); it != id.rend(); ++it) {
+            *it = visus::cuid2::utils::BASE36_ALPHABET[static_cast<std::size_t>(key % RADIX)];
+            key /= RADIX;
+        }
+
+        return id;
+    }
+
+    /// Path of the file holding one process's keys for one shard.
+    [[nodiscard]] std::filesystem::path shard_path(const std::filesystem::path& DIRECTORY, const unsigned SHARD,
+                                                   const unsigned PROCESS) {
+        return DIRECTORY / fmt::format("shard-{:03}.{:03}", SHARD, PROCESS);
+    }
+
+    /// Append-only shard files of one process, shared by its threads.
+    template <typename Key>
+    class ShardFiles {
+        struct Shard {
+            std::mutex mutex;
+            std::FILE* file = nullptr;
+        };
+
+        std::unique_ptr<Shard[]> shards_;
+        unsigned count_;
+
+    public:
+        ShardFiles(const std::filesystem::path& DIRECTORY, const unsigned SHARDS, const unsigned PROCESS)
+            : shards_(std::make_unique<Shard[]>(SHARDS)), count_(SHARDS) {
+            for (unsigned idx = 0; idx < SHARDS; ++idx) {
+                shards_[idx].file = std::fopen(shard_path(DIRECTORY, idx, PROCESS).c_str(), "wb");
+
+                if (shards_[idx].file == nullptr) [[unlikely]] {
+                    throw std::system_error(errno, std::generic_category(), "cannot create shard file");
+                }
+            }
+        }
+
+        ShardFiles(const ShardFiles&) = delete;
+        ShardFiles& operator=(const ShardFiles&) = delete;
+
+        ~ShardFiles() {
+            for (unsigned idx = 0; idx < count_; ++idx) {
+                std::fclose(shards_[idx].file);
+            }
+        }
+
+        /// Appends keys to one shard.
+        ///
+        /// @throws std::system_error if the write fails, e.g. on a full disk
+        void append(const unsigned SHARD, const std::span<const Key> KEYS) {
+            Shard& shard = shards_[SHARD];
+            const std::scoped_lock LOCK(shard.mutex);
+
+            if (std::fwrite(KEYS.data(), sizeof(Key), KEYS.size(), shard.file) != KEYS.size()) [[unlikely]] {
+                throw std::system_error(errno, std::generic_category(), "cannot write shard file");
+            }
+        }
+
+        /// Flushes every shard to disk.
+        ///
+        /// @throws std::system_error if a flush fails
+        void flush() {
+            for (unsigned idx = 0; idx < count_; ++idx) {
+                if (std::fflush(shards_[idx].file) != 0) [[unlikely]] {
+                    throw std::system_error(errno, std::generic_category(), "cannot write shard file");
+                }
+            }
+        }
+    };
+
+    /// Generates identifiers for one thread and spreads their keys over the shards.
+    ///
+    /// @param next Index of the next identifier to claim within this process
+    /// @param TOTAL Identifiers this process must generate
+    template <typename Key>
+    void generate_keys(const Options& OPTIONS, const unsigned SHARD_BITS, ShardFiles<Key>& files,
+                       std::atomic<uint64_t>& next, const uint64_t TOTAL, SharedCounts& counts) {
+        const auto LENGTH = static_cast<std::size_t>(OPTIONS.length);
+        const unsigned SHARDS = 1U << SHARD_BITS;
+
+        visus::cuid2::Generator generator({.length = OPTIONS.length});
+
+        std::vector<char> column(BATCH_SIZE * LENGTH);
+        std::vector<std::vector<Key>> buffers(SHARDS);
+        for (auto& buffer : buffers) {
+            buffer.reserve(SHARD_BUFFER_KEYS);
+        }
+
+        auto histogram = std::make_unique<Histogram>();
+        std::vector<uint64_t> leading(JOINT_CELLS);
+        uint64_t malformed = 0;
+
+        for (;;) {
+            const uint64_t START = next.fetch_add(BATCH_SIZE, std::memory_order_relaxed);
+            if (START >= TOTAL) {
+                break;
+            }
+
+            const auto BATCH = static_cast<std::size_t>(std::min(BATCH_SIZE, TOTAL - START));
+            generator.next_batch_into(column, LENGTH, BATCH, OPTIONS.length);
+
+            for (std::size_t idx = 0; idx < BATCH; ++idx) {
+                const char* record = column.data() + idx * LENGTH;
+                Key key = 0;
+                uint8_t invalid = 0;
+
+                for (std::size_t pos = 0; pos < LENGTH; ++pos) {
+                    const uint8_t DIGIT = DIGIT_VALUES[static_cast<uint8_t>(record[pos])];
+
+                    invalid |= static_cast<uint8_t>(DIGIT == 0xFF);
+                    key = key * RADIX + (DIGIT % RADIX);
+                    ++(*histogram)[pos][DIGIT % RADIX];
+                }
+
+                malformed += invalid;
+
+                std::size_t cell = 0;
+                for (std::size_t pos = JOINT_FIRST; pos < JOINT_FIRST + JOINT_POSITIONS; ++pos) {
+                    cell = cell * RADIX + DIGIT_VALUES[static_cast<uint8_t>(record[pos])] % RADIX;
+                }
+                ++leading[cell];
+
+                const auto SHARD = static_cast<unsigned>(mix(fold(key)) >> (64 - SHARD_BITS));
+                auto& buffer = buffers[SHARD];
+
+                buffer.push_back(key);
+                if (buffer.size() == SHARD_BUFFER_KEYS) {
+                    files.append(SHARD, buffer);
+                    buffer.clear();
+                }
+            }
+
+            counts.generated.fetch_add(BATCH, std::memory_order_relaxed);
+        }
+
+        for (unsigned shard = 0; shard < SHARDS; ++shard) {
+            if (!buffers[shard].empty()) {
+                files.append(shard, buffers[shard]);
+            }
+        }
+
+        for (std::size_t pos = 0; pos < LENGTH; ++pos) {
+            for (std::size_t digit = 0; digit < RADIX; ++digit) {
+                counts.characters[pos][digit].fetch_add((*histogram)[pos][digit], std::memory_order_relaxed);
+            }
+        }
+
+        for (std::size_t cell = 0; cell < JOINT_CELLS; ++cell) {
+            counts.leading[cell].fetch_add(leading[cell], std::memory_order_relaxed);
+        }
+
+        counts.malformed.fetch_add(malformed, std::memory_order_relaxed);
+    }
+
+    /// Generates TOTAL identifiers with OPTIONS.threads threads into this process's shard files.
+    ///
+    /// @throws std::system_error if a shard file cannot be written
+    /// @throws std::runtime_error if the entropy source fails
+    template <typename Key>
+    void run_process(const Options& OPTIONS, const std::filesystem::path& DIRECTORY, const unsigned SHARD_BITS,
+                     const unsigned PROCESS, const uint64_t TOTAL, SharedCounts& counts) {
+        ShardFiles<Key> files(DIRECTORY, 1U << SHARD_BITS, PROCESS);
+        std::atomic<uint64_t> next{0};
+
+        std::mutex error_mutex;
+        std::exception_ptr error;
+
+        const auto WORK = [&] {
+            try {
+                generate_keys<Key>(OPTIONS, SHARD_BITS, files, next, TOTAL, counts);
+            } catch (...) {
+                const std::scoped_lock LOCK(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+
+                // Let the other threads run out of work
+                next.store(TOTAL, std::memory_order_relaxed);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned idx = 1; idx < OPTIONS.threads; ++idx) {
+            workers.emplace_back(WORK);
+        }
+
+        WORK();
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+
+        files.flush();
+    }
+
+    /// Sorts each shard and counts values seen more than once.
+    ///
+    /// Shards are claimed by up to THREADS workers, each holding one shard in
+    /// memory at a time; files are deleted once read.
+    ///
+    /// @throws std::system_error if a shard file cannot be read
+    template <typename Key>
+    Duplicates count_duplicates(const Options& OPTIONS, const std::filesystem::path& DIRECTORY, const unsigned SHARDS,
+                                const unsigned THREADS) {
+        std::atomic<unsigned> next{0};
+        std::mutex result_mutex;
+        Duplicates result;
+        std::exception_ptr error;
+
+        const auto WORK = [&] {
+            try {
+                std::vector<Key> keys;
+
+                for (unsigned shard = next.fetch_add(1); shard < SHARDS; shard = next.fetch_add(1)) {
+                    keys.clear();
+
+                    for (unsigned process = 0; process < OPTIONS.processes; ++process) {
+                        const std::filesystem::path PATH = shard_path(DIRECTORY, shard, process);
+                        const auto SIZE = static_cast<std::size_t>(std::filesystem::file_size(PATH) / sizeof(Key));
+                        const std::size_t OFFSET = keys.size();
+
+                        keys.resize(OFFSET + SIZE);
+
+                        const std::unique_ptr<std::FILE, int (*)(std::FILE*)> INPUT(std::fopen(PATH.c_str(), "rb"),
+                                                                                    &std::fclose);
+                        if (!INPUT || std::fread(keys.data() + OFFSET, sizeof(Key), SIZE, INPUT.get()) != SIZE) [[unlikely]] {
+                            throw std::system_error(errno, std::generic_category(), "cannot read shard file");
+                        }
+
+                        std::filesystem::remove(PATH);
+                    }
+
+                    std::sort(keys.begin(), keys.end());
+
+                    uint64_t repeats = 0;
+                    std::vector<std::string> examples;
+
+                    for (auto it = std::adjacent_find(keys.begin(), keys.end()); it != keys.end();
+                         it = std::adjacent_find(it, keys.end())) {
+                        const auto RUN_END = std::find_if(it, keys.end(), [VALUE = *it](const Key KEY) { return KEY != VALUE; });
+
+                        repeats += static_cast<uint64_t>(RUN_END - it) - 1;
+                        if (examples.size() < MAX_EXAMPLES) {
+                            examples.push_back(unpack(*it, OPTIONS.length));
+                        }
+
+                        it = RUN_END;
+                    }
+
+                    const std::scoped_lock LOCK(result_mutex);
+                    result.repeats += repeats;
+                    for (auto& example : examples) {
+                        if (result.examples.size() < MAX_EXAMPLES) {
+                            result.examples.push_back(std::move(example));
+                        }
+                    }
+                }
+            } catch (...) {
+                const std::scoped_lock LOCK(result_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+
+                next.store(SHARDS);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned idx = 1; idx < THREADS; ++idx) {
+            workers.emplace_back(WORK);
+        }
+
+        WORK();
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+
+        return result;
+    }
+
+    /// Expected number of repeated values among N draws from K equally likely values.
+    ///
+    /// N minus the expected number of distinct values, N - K(1 - e^(-N/K)),
+    /// reduces to the birthday approximation N^2 / 2K while N is far below K.
+    [[nodiscard]] double expected_repeats(const double N, const double K) noexcept {
+        const double X = N / K;
+
+        return N * (1.0 + std::expm1(-X) / X);
+    }
+
+    /// Probability that N draws from K equally likely values contain a repeat.
+    [[nodiscard]] double collision_probability(const double N, const double K) noexcept {
+        return -std::expm1(-N * (N - 1.0) / (2.0 * K));
+    }
+
+    /// Estimates -log2 of the probability that two samples fall in the same cell.
+    ///
+    /// @param CELLS Occurrences of each value among N samples
+    template <typename Count>
+    [[nodiscard]] double match_bits(const std::span<const Count> CELLS, const double N) noexcept {
+        double match = 0.0;
+
+        for (const auto& CELL : CELLS) {
+            const auto OBSERVED = static_cast<double>(CELL);
+            match += OBSERVED * (OBSERVED - 1.0);
+        }
+
+        // Unbiased estimate of the sum of squared cell probabilities
+        return -std::log2(match / (N * (N - 1.0)));
+    }
+
+    /// Chi-squared value exceeded with probability 1e-6 (Wilson-Hilferty approximation).
+    [[nodiscard]] double chi_squared_limit(const double DOF) noexcept {
+        const double SCALE = 2.0 / (9.0 * DOF);
+
+        return DOF * std::pow(1.0 - SCALE + Z_LIMIT * std::sqrt(SCALE), 3.0);
+    }
+
+    /// Prints the distribution and collision report.
+    ///
+    /// The measured key space is the inverse of the probability that two
+    /// identifiers match, estimated from the histograms: jointly for the
+    /// correlated characters at JOINT_FIRST, per position elsewhere, and
+    /// multiplied across the parts. It assumes the parts are independent,
+    /// so it is a model rather than a bound.
+    ///
+    /// @return Process exit status: 2 if OPTIONS.check is set and the
+    ///         measured repeats are implausibly high for the measured key space
+    int report(const Options& OPTIONS, const SharedCounts& COUNTS, const Duplicates& DUPLICATES,
+               const double GENERATE_SECONDS, const double COUNT_SECONDS, const unsigned SHARDS) {
+        const auto N = static_cast<double>(OPTIONS.count);
+        const auto LENGTH = static_cast<std::size_t>(OPTIONS.length);
+
+        fmt::print("{} identifiers of length {} from {} process(es) x {} thread(s)\n", OPTIONS.count, OPTIONS.length,
+                   OPTIONS.processes, OPTIONS.threads);
+        fmt::print("generated in {:.1f} s ({:.2f} M/s), counted in {:.1f} s over {} shards\n\n", GENERATE_SECONDS,
+                   N / GENERATE_SECONDS / 1e6, COUNT_SECONDS, SHARDS);
+
+        double uniform_bits = std::log2(static_cast<double>(visus::cuid2::utils::LOWERCASE_LETTER_COUNT));
+        double measured_bits = 0.0;
+        double joint_marginal_bits = 0.0;
+
+        fmt::print("{:>8} {:>14} {:>5} {:>12} {:>8}\n", "position", "chi-squared", "dof", "limit", "bits");
+
+        for (std::size_t pos = 0; pos < LENGTH; ++pos) {
+            // The leading character is always a letter
+            const std::size_t FIRST = pos == 0 ? RADIX - visus::cuid2::utils::LOWERCASE_LETTER_COUNT : 0;
+            const auto SYMBOLS = static_cast<double>(RADIX - FIRST);
+
+            double chi_squared = 0.0;
+
+            for (std::size_t digit = FIRST; digit < RADIX; ++digit) {
+                const auto OBSERVED = static_cast<double>(COUNTS.characters[pos][digit].load());
+                const double EXPECTED = N / SYMBOLS;
+
+                chi_squared += (OBSERVED - EXPECTED) * (OBSERVED - EXPECTED) / EXPECTED;
+            }
+
+            const double BITS = match_bits(std::span<const std::atomic<uint64_t>>(COUNTS.characters[pos]), N);
+            const double LIMIT = chi_squared_limit(SYMBOLS - 1.0);
+
+            if (pos >= JOINT_FIRST && pos < JOINT_FIRST + JOINT_POSITIONS) {
+                joint_marginal_bits += BITS;
+            } else {
+                measured_bits += BITS;
+            }
+
+            if (pos > 0) {
+                uniform_bits += std::log2(static_cast<double>(RADIX));
+            }
+
+            fmt::print("{:>8} {:>14.1f} {:>5} {:>12.1f} {:>8.3f}{}\n", pos, chi_squared, SYMBOLS - 1.0, LIMIT, BITS,
+                       chi_squared > LIMIT ? "  non-uniform" : "");
+        }
+
+        if (OPTIONS.histogram) {
+            fmt::print("\nrelative frequency (1.000 = uniform)\n{:>8}", "position");
+            for (const char CHARACTER : visus::cuid2::utils::BASE36_ALPHABET) {
+                fmt::print(" {:>5}", CHARACTER);
+            }
+
+            for (std::size_t pos = 0; pos < LENGTH; ++pos) {
+                const std::size_t FIRST = pos == 0 ? RADIX - visus::cuid2::utils::LOWERCASE_LETTER_COUNT : 0;
+                const double EXPECTED = N / static_cast<double>(RADIX - FIRST);
+
+                fmt::print("\n{:>8}", pos);
+                for (std::size_t digit = 0; digit < RADIX; ++digit) {
+                    fmt::print(" {:>5.3f}", static_cast<double>(COUNTS.characters[pos][digit].load()) / EXPECTED);
+                }
+            }
+
+            fmt::print("\n");
+        }
+
+        const double JOINT_BITS = match_bits(std::span<const std::atomic<uint64_t>>(COUNTS.leading), N);
+        measured_bits += JOINT_BITS;
+
+        fmt::print("\npositions {}-{} jointly: {:.3f} bits ({:.3f} if independent, {:.3f} if uniform)\n", JOINT_FIRST,
+                   JOINT_FIRST + JOINT_POSITIONS - 1, JOINT_BITS, joint_marginal_bits,
+                   JOINT_POSITIONS * std::log2(static_cast<double>(RADIX)));
+
+        const double UNIFORM_SPACE = std::exp2(uniform_bits);
+        const double MEASURED_SPACE = std::exp2(measured_bits);
+        const double EXPECTED_UNIFORM = expected_repeats(N, UNIFORM_SPACE);
+        const double EXPECTED_MEASURED = expected_repeats(N, MEASURED_SPACE);
+
+        fmt::print("\n{:<22} {:>12} {:>12}\n", "", "uniform", "measured");
+        fmt::print("{:<22} {:>12.2f} {:>12.2f}\n", "key space (bits)", uniform_bits, measured_bits);
+        fmt::print("{:<22} {:>12.4g} {:>12.4g}\n", "expected repeats", EXPECTED_UNIFORM, EXPECTED_MEASURED);
+        fmt::print("{:<22} {:>12.4g} {:>12.4g}\n", "P(any collision)", collision_probability(N, UNIFORM_SPACE),
+                   collision_probability(N, MEASURED_SPACE));
+        fmt::print("\nrepeats: {}\n", DUPLICATES.repeats);
+
+        for (const auto& EXAMPLE : DUPLICATES.examples) {
+            fmt::print("  {}\n", EXAMPLE);
+        }
+
+        const uint64_t MALFORMED = COUNTS.malformed.load();
+        if (MALFORMED > 0) {
+            fmt::print("malformed identifiers: {}\n", MALFORMED);
+        }
+
+        // Repeats are close to Poisson-distributed around their expectation
+        const double UPPER = EXPECTED_MEASURED + Z_LIMIT * std::sqrt(EXPECTED_MEASURED) + 1.0;
+        const bool PASSED = MALFORMED == 0 && static_cast<double>(DUPLICATES.repeats) <= UPPER;
+
+        if (OPTIONS.check) {
+            fmt::print("check: {} (at most {:.1f} repeats allowed)\n", PASSED ? "passed" : "FAILED", UPPER);
+        }
+
+        return OPTIONS.check && !PASSED ? 2 : 0;
+    }
+
+    /// Runs the whole stress test with keys of type Key.
+    ///
+    /// Processes 1 to processes - 1 are forked before any thread is started;
+    /// the parent generates the first share, waits for the children, then
+    /// counts every shard.
+    ///
+    /// @return Process exit status
+    template <typename Key>
+    int run(const Options& OPTIONS) {
+        const double KEY_BYTES = static_cast<double>(OPTIONS.count) * sizeof(Key);
+        const double MEMORY = static_cast<double>(OPTIONS.memory_mib) * 1024.0 * 1024.0;
+
+        // Enough shards that one per counting thread fits in the budget, with
+        // a quarter to spare for uneven shards; fewer threads count if not
+        const auto WANTED = static_cast<uint64_t>(std::ceil(KEY_BYTES * 1.25 * OPTIONS.threads / MEMORY));
+        const unsigned SHARDS = static_cast<unsigned>(std::clamp<uint64_t>(std::bit_ceil(std::max<uint64_t>(WANTED, 1)),
+                                                                           MIN_SHARDS, MAX_SHARDS));
+        const unsigned SHARD_BITS = static_cast<unsigned>(std::countr_zero(SHARDS));
+        const double SHARD_BYTES = KEY_BYTES * 1.25 / SHARDS;
+
+        if (SHARD_BYTES > MEMORY) {
+            fmt::print(stderr, "Error: --memory must be at least {} MiB for {} identifiers\n",
+                       static_cast<uint64_t>(std::ceil(SHARD_BYTES / 1024.0 / 1024.0)), OPTIONS.count);
+            return 1;
+        }
+
+        const auto COUNT_THREADS = static_cast<unsigned>(
+            std::clamp<double>(std::floor(MEMORY / SHARD_BYTES), 1.0, static_cast<double>(OPTIONS.threads)));
+
+        std::string pattern = (OPTIONS.directory / "cuid2-stress-XXXXXX").string();
+        if (mkdtemp(pattern.data()) == nullptr) {
+            throw std::system_error(errno, std::generic_category(), "cannot create work directory");
+        }
+
+        const std::filesystem::path DIRECTORY = pattern;
+        const std::unique_ptr<const std::filesystem::path, void (*)(const std::filesystem::path*)> CLEANUP(
+            &DIRECTORY, [](const std::filesystem::path* path) {
+                std::error_code ignored;
+                std::filesystem::remove_all(*path, ignored);
+            });
+
+        void* mapping = mmap(nullptr, sizeof(SharedCounts), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "cannot map shared counters");
+        }
+
+        const std::unique_ptr<SharedCounts, void (*)(SharedCounts*)> COUNTS(
+            new (mapping) SharedCounts, [](SharedCounts* counts) { munmap(counts, sizeof(SharedCounts)); });
+
+        const uint64_t SHARE = OPTIONS.count / OPTIONS.processes;
+        const auto START = std::chrono::steady_clock::now();
+
+        // Nothing buffered may be inherited and written twice
+        std::fflush(stdout);
+
+        std::vector<pid_t> children;
+        for (unsigned process = 1; process < OPTIONS.processes; ++process) {
+            const pid_t PID = fork();
+
+            if (PID < 0) {
+                throw std::system_error(errno, std::generic_category(), "cannot fork");
+            }
+
+            if (PID == 0) {
+                int status = 0;
+
+                try {
+                    run_process<Key>(OPTIONS, DIRECTORY, SHARD_BITS, process, SHARE, *COUNTS);
+                } catch (const std::exception& e) {
+                    fmt::print(stderr, "Error in process {}: {}\n", process, e.what());
+                    status = 1;
+                }
+
+                std::fflush(stdout);
+                _exit(status);
+            }
+
+            children.push_back(PID);
+        }
+
+        std::atomic<bool> done{false};
+        std::thread progress([&] {
+            auto last = std::chrono::steady_clock::now();
+
+            while (!done.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+                if (std::chrono::steady_clock::now() - last >= PROGRESS_INTERVAL) {
+                    last = std::chrono::steady_clock::now();
+                    fmt::print(stderr, "generated {} of {}\n", COUNTS->generated.load(), OPTIONS.count);
+                }
+            }
+        });
+
+        std::exception_ptr error;
+        try {
+            // The parent also takes the remainder of the division
+            run_process<Key>(OPTIONS, DIRECTORY, SHARD_BITS, 0, OPTIONS.count - SHARE * (OPTIONS.processes - 1),
+                             *COUNTS);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        bool children_ok = true;
+        for (const pid_t CHILD : children) {
+            int status = 0;
+            waitpid(CHILD, &status, 0);
+            children_ok = children_ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+
+        done.store(true);
+        progress.join();
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+
+        if (!children_ok) {
+            fmt::print(stderr, "Error: a worker process failed\n");
+            return 1;
+        }
+
+        const auto GENERATED = std::chrono::steady_clock::now();
+        const Duplicates DUPLICATES = count_duplicates<Key>(OPTIONS, DIRECTORY, SHARDS, COUNT_THREADS);
+        const auto COUNTED = std::chrono::steady_clock::now();
+
+        return report(OPTIONS, *COUNTS, DUPLICATES, std::chrono::duration<double>(GENERATED - START).count(),
+                      std::chrono::duration<double>(COUNTED - GENERATED).count(), SHARDS);
+    }
+} // anonymous namespace
+
+int main(const int argc, char* argv[]) {
+    Options options;
+
+    int i = 1;
+    while (i < argc) {
+        const std::string_view ARG{argv[i]};
+
+        if (is_help_flag(ARG)) {
+            print_help(argv[0]);
+            return 0;
+        }
+
+        if (ARG == "--histogram" || ARG == "--check") {
+            (ARG == "--check" ? options.check : options.histogram) = true;
+            ++i;
+            continue;
+        }
+
+        if (!is_length_flag(ARG) && !is_count_flag(ARG) && !is_threads_flag(ARG) && !is_processes_flag(ARG) &&
+            !is_memory_flag(ARG) && !is_directory_flag(ARG)) {
+            fmt::print(stderr, "Error: Unknown option '{}'\n\n", ARG);
+            print_help(argv[0]);
+            return 1;
+        }
+
+        if (i + 1 >= argc) {
+            fmt::print(stderr, "Error: {} requires an argument\n\n", ARG);
+            print_help(argv[0]);
+            return 1;
+        }
+
+        ++i;
+        const std::string_view VALUE{argv[i]};
+        bool valid = true;
+
+        if (is_length_flag(ARG)) {
+            valid = parse_number(VALUE, options.length) && options.length >= visus::cuid2::MIN_CUID2_LENGTH &&
+                    options.length <= MAX_STRESS_LENGTH;
+        } else if (is_count_flag(ARG)) {
+            valid = parse_number(VALUE, options.count) && options.count >= 2;
+        } else if (is_threads_flag(ARG)) {
+            valid = parse_number(VALUE, options.threads) && options.threads > 0 && options.threads <= MAX_THREADS;
+        } else if (is_processes_flag(ARG)) {
+            valid = parse_number(VALUE, options.processes) && options.processes > 0 &&
+                    options.processes <= MAX_PROCESSES;
+        } else if (is_memory_flag(ARG)) {
+            valid = parse_number(VALUE, options.memory_mib) && options.memory_mib > 0;
+        } else {
+            options.directory = std::filesystem::path(VALUE);
+        }
+
+        if (!valid) {
+            fmt::print(stderr, "Error: Invalid {} value '{}'\n\n", ARG, VALUE);
+            print_help(argv[0]);
+            return 1;
+        }
+
+        ++i;
+    }
+
+    try {
+        if (options.length <= MAX_NARROW_LENGTH) {
+            return run<uint64_t>(options);
+        }
+
+        return run<WideKey>(options);
+    } catch (const std::exception& e) {
+        fmt::print(stderr, "Error: {}\n", e.what());
+        return 1;
+    }
+}
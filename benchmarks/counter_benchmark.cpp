@@ -0,0 +1,69 @@
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "cuid2/counter.hpp"
+#include "cuid2/platform.hpp"
+
+namespace {
+    /// Measures Counter::next() with the given per-thread block size.
+    ///
+    /// Every thread increments the counter as fast as possible, so with a block
+    /// size of 1 the shared cache line bounces between all running cores.
+    void BM_CounterNext(benchmark::State& state) {
+        if (state.thread_index() == 0) {
+            visus::cuid2::Counter::set_thread_block_size(state.range(0));
+        }
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(visus::cuid2::Counter::next());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+
+        if (state.thread_index() == 0) {
+            visus::cuid2::Counter::set_thread_block_size(1);
+        }
+    }
+
+    /// Measures Counter::next() with per-NUMA-node partitions.
+    ///
+    /// On a single-node host this only adds the node lookup; the partitions
+    /// pay off on multi-socket hosts, where threads pinned across sockets
+    /// otherwise bounce the shared counter's cache line over the interconnect.
+    /// Compare against BM_CounterNext/block:1 at the same thread count, e.g.
+    /// with numactl --cpunodebind=0,1.
+    void BM_CounterNextNuma(benchmark::State& state) {
+        if (state.thread_index() == 0) {
+            visus::cuid2::Counter::set_numa_partitioned(true);
+        }
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(visus::cuid2::Counter::next());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+
+        if (state.thread_index() == 0) {
+            visus::cuid2::Counter::set_numa_partitioned(false);
+        }
+    }
+
+    /// Measures the NUMA node lookup on its own.
+    void BM_GetNumaNode(benchmark::State& state) {
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(visus::cuid2::platform::get_numa_node());
+        }
+    }
+} // anonymous namespace
+
+BENCHMARK(BM_CounterNext)
+    ->ArgName("block")
+    ->Arg(1)
+    ->Arg(1024)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+BENCHMARK(BM_CounterNextNuma)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK(BM_GetNumaNode);
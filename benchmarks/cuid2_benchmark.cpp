@@ -0,0 +1,155 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "cuid2/cuid2.h"
+#include "cuid2/cuid2.hpp"
+#include "cuid2/generator.hpp"
+
+namespace {
+    void BM_Generate(benchmark::State& state) {
+        const auto LENGTH = static_cast<int>(state.range(0));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(visus::cuid2::generate(LENGTH));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    template <int N>
+    void BM_GenerateFixed(benchmark::State& state) {
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(visus::cuid2::generate<N>());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_GenerateBatch(benchmark::State& state) {
+        const auto BATCH_SIZE = static_cast<size_t>(state.range(0));
+        const auto LENGTH = static_cast<int>(state.range(1));
+
+        std::vector<std::string> ids(BATCH_SIZE);
+
+        for (auto _ : state) {
+            visus::cuid2::generate_batch(ids, LENGTH);
+            benchmark::DoNotOptimize(ids.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BATCH_SIZE));
+    }
+
+    /// generate() with the string allocated from a stack arena that is
+    /// released every iteration, as a per-request arena would be.
+    void BM_GeneratePmr(benchmark::State& state) {
+        const auto LENGTH = static_cast<int>(state.range(0));
+        std::array<std::byte, 256> storage{};
+
+        for (auto _ : state) {
+            std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size());
+            benchmark::DoNotOptimize(visus::cuid2::generate(&arena, LENGTH));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /// generate_batch() with the vector and strings allocated from an arena.
+    void BM_GenerateBatchPmr(benchmark::State& state) {
+        const auto BATCH_SIZE = static_cast<size_t>(state.range(0));
+        const auto LENGTH = static_cast<int>(state.range(1));
+        std::vector<std::byte> storage(BATCH_SIZE * 128);
+
+        for (auto _ : state) {
+            std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size());
+            benchmark::DoNotOptimize(visus::cuid2::generate_batch(BATCH_SIZE, &arena, LENGTH));
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BATCH_SIZE));
+    }
+
+    void BM_GenerateIntoC(benchmark::State& state) {
+        char buffer[CUID2_DEFAULT_LENGTH];
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(cuid2_generate_into(buffer, CUID2_DEFAULT_LENGTH));
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_GenerateBatchC(benchmark::State& state) {
+        const auto BATCH_SIZE = static_cast<size_t>(state.range(0));
+        const auto LENGTH = static_cast<int>(state.range(1));
+        const auto STRIDE = static_cast<size_t>(LENGTH) + 1;
+
+        // NUL-terminated rows, as a binding would hand to its runtime
+        std::vector<char> rows(BATCH_SIZE * STRIDE, '\0');
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(cuid2_generate_batch(rows.data(), STRIDE, BATCH_SIZE, LENGTH));
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BATCH_SIZE));
+    }
+
+    void BM_GeneratorNext(benchmark::State& state) {
+        visus::cuid2::Generator generator;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(generator.next());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_GeneratorNextTimestamp(benchmark::State& state) {
+        const auto SOURCE = static_cast<visus::cuid2::TimestampSource>(state.range(0));
+        visus::cuid2::Generator generator({.timestamp = SOURCE});
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(generator.next());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+} // anonymous namespace
+
+BENCHMARK(BM_Generate)
+    ->ArgName("length")
+    ->Arg(visus::cuid2::MIN_CUID2_LENGTH)
+    ->Arg(visus::cuid2::DEFAULT_LENGTH)
+    ->Arg(visus::cuid2::MAX_CUID2_LENGTH);
+
+BENCHMARK(BM_GenerateFixed<visus::cuid2::MIN_CUID2_LENGTH>);
+BENCHMARK(BM_GenerateFixed<visus::cuid2::DEFAULT_LENGTH>);
+BENCHMARK(BM_GenerateFixed<visus::cuid2::MAX_CUID2_LENGTH>);
+
+BENCHMARK(BM_GenerateBatch)
+    ->ArgNames({"batch", "length"})
+    ->ArgsProduct({{1, 16, 256, 4096}, {visus::cuid2::DEFAULT_LENGTH}});
+
+BENCHMARK(BM_GeneratePmr)->ArgName("length")->Arg(visus::cuid2::DEFAULT_LENGTH);
+
+BENCHMARK(BM_GenerateBatchPmr)
+    ->ArgNames({"batch", "length"})
+    ->ArgsProduct({{1, 16, 256, 4096}, {visus::cuid2::DEFAULT_LENGTH}});
+
+BENCHMARK(BM_GenerateIntoC);
+
+BENCHMARK(BM_GenerateBatchC)
+    ->ArgNames({"batch", "length"})
+    ->ArgsProduct({{1, 16, 256, 4096}, {visus::cuid2::DEFAULT_LENGTH}});
+
+BENCHMARK(BM_GeneratorNext)->ThreadRange(1, 64)->UseRealTime();
+
+// 0 = precise, 1 = coarse, 2 = cached
+BENCHMARK(BM_GeneratorNextTimestamp)->ArgName("source")->DenseRange(0, 2);
@@ -0,0 +1,93 @@
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "cuid2/generator.hpp"
+#include "cuid2/hash.hpp"
+#include "cuid2/platform.hpp"
+
+namespace {
+    /// Timestamp and counter header plus random bytes for a default-length ID.
+    constexpr size_t HEADER_SIZE = 16;
+    constexpr size_t RANDOM_SIZE = 24;
+
+    /// Full fingerprint construction: hostname, process ID, environment
+    /// capture and the digest. Mirrors Fingerprint::generate(), which only
+    /// runs once per process and cannot be re-run through the singleton.
+    void BM_FingerprintGenerate(benchmark::State& state) {
+        visus::cuid2::HashContext context;
+
+        for (auto _ : state) {
+            const std::string HOSTNAME = visus::cuid2::platform::get_hostname();
+            const auto PID = static_cast<uint32_t>(visus::cuid2::platform::get_process_id());
+
+            std::vector<uint8_t> fingerprint(HOSTNAME.begin(), HOSTNAME.end());
+            for (size_t shift = 0; shift < 32; shift += 8) {
+                fingerprint.push_back(static_cast<uint8_t>(PID >> shift));
+            }
+            visus::cuid2::platform::append_environment(fingerprint);
+
+            benchmark::DoNotOptimize(context.hash(fingerprint));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /// Per-identifier hash when the raw fingerprint is absorbed every time.
+    void BM_HashRawFingerprint(benchmark::State& state) {
+        const std::vector<uint8_t> fingerprint(static_cast<size_t>(state.range(0)), 'x');
+        const std::array<uint8_t, HEADER_SIZE + RANDOM_SIZE> other{};
+        visus::cuid2::HashContext context;
+
+        for (auto _ : state) {
+            context.init();
+            context.update(std::span(other).first(HEADER_SIZE));
+            context.update(fingerprint);
+            context.update(std::span(other).last(RANDOM_SIZE));
+            benchmark::DoNotOptimize(context.finalize());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /// Per-identifier hash when only the 64-byte fingerprint digest is absorbed.
+    void BM_HashFingerprintDigest(benchmark::State& state) {
+        const visus::cuid2::utils::Digest digest{};
+        const std::array<uint8_t, HEADER_SIZE + RANDOM_SIZE> other{};
+        visus::cuid2::HashContext context;
+
+        for (auto _ : state) {
+            context.init();
+            context.update(std::span(other).first(HEADER_SIZE));
+            context.update(digest);
+            context.update(std::span(other).last(RANDOM_SIZE));
+            benchmark::DoNotOptimize(context.finalize());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /// End-to-end generation throughput for a given fingerprint size.
+    void BM_GeneratorFingerprintSize(benchmark::State& state) {
+        visus::cuid2::Generator generator({
+            .fingerprint = std::vector<uint8_t>(static_cast<size_t>(state.range(0)), 'x'),
+        });
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(generator.next());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+} // anonymous namespace
+
+BENCHMARK(BM_FingerprintGenerate);
+
+BENCHMARK(BM_HashRawFingerprint)->ArgName("env_bytes")->RangeMultiplier(8)->Range(256, 65536);
+
+BENCHMARK(BM_HashFingerprintDigest);
+
+BENCHMARK(BM_GeneratorFingerprintSize)->ArgName("env_bytes")->RangeMultiplier(8)->Range(256, 65536);
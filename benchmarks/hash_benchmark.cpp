@@ -0,0 +1,92 @@
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include <benchmark/benchmark.h>
+#include <openssl/evp.h>
+
+#include "cuid2/cuid2.hpp"
+#include "cuid2/hash.hpp"
+
+namespace {
+    /// Representative per-identifier hash input: header, fingerprint and entropy.
+    constexpr size_t HASH_INPUT_SIZE = 128;
+
+    struct EVPContextDeleter {
+        void operator()(EVP_MD_CTX* ctx) const noexcept {
+            EVP_MD_CTX_free(ctx);
+        }
+    };
+
+    /// Per-identifier hash as performed by the generator: header, fingerprint
+    /// digest and one random byte per character, absorbed in three updates.
+    void BM_ComputeHash(benchmark::State& state) {
+        const auto LENGTH = static_cast<size_t>(state.range(0));
+        const std::array<uint8_t, 2 * sizeof(uint64_t)> header{};
+        const visus::cuid2::utils::Digest fingerprint{};
+        const std::array<uint8_t, visus::cuid2::MAX_CUID2_LENGTH> random{};
+        visus::cuid2::HashContext context;
+
+        for (auto _ : state) {
+            context.init();
+            context.update(header);
+            context.update(fingerprint);
+            context.update(std::span(random).first(LENGTH));
+            benchmark::DoNotOptimize(context.finalize());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /// Previous behaviour: a fresh context and an implicit algorithm fetch per hash.
+    void BM_HashFreshContext(benchmark::State& state) {
+        const std::array<uint8_t, HASH_INPUT_SIZE> input{};
+        std::array<uint8_t, EVP_MAX_MD_SIZE> digest{};
+
+        for (auto _ : state) {
+            const std::unique_ptr<EVP_MD_CTX, EVPContextDeleter> CTX(EVP_MD_CTX_new());
+            unsigned int digest_len = 0;
+
+            EVP_DigestInit_ex(CTX.get(), EVP_sha3_512(), nullptr);
+            EVP_DigestUpdate(CTX.get(), input.data(), input.size());
+            EVP_DigestFinal_ex(CTX.get(), digest.data(), &digest_len);
+
+            benchmark::DoNotOptimize(digest.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_HashReusedContext(benchmark::State& state) {
+        const std::array<uint8_t, HASH_INPUT_SIZE> input{};
+        visus::cuid2::HashContext context;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(context.hash(input));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_GenerateThreaded(benchmark::State& state) {
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(visus::cuid2::generate());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+} // anonymous namespace
+
+BENCHMARK(BM_ComputeHash)
+    ->ArgName("length")
+    ->Arg(visus::cuid2::MIN_CUID2_LENGTH)
+    ->Arg(visus::cuid2::DEFAULT_LENGTH)
+    ->Arg(visus::cuid2::MAX_CUID2_LENGTH);
+
+BENCHMARK(BM_HashFreshContext)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK(BM_HashReusedContext)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK(BM_GenerateThreaded)->ThreadRange(1, 64)->UseRealTime();
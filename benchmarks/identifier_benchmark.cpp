@@ -0,0 +1,108 @@
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "cuid2/cuid2.hpp"
+#include "cuid2/identifier.hpp"
+
+namespace {
+    constexpr size_t SAMPLE_COUNT = 1024;
+
+    std::vector<std::string> make_texts() {
+        return visus::cuid2::generate_batch(SAMPLE_COUNT);
+    }
+
+    std::vector<visus::cuid2::Cuid2> make_values(const std::vector<std::string>& texts) {
+        std::vector<visus::cuid2::Cuid2> result;
+        result.reserve(texts.size());
+
+        for (const auto& text : texts) {
+            result.push_back(visus::cuid2::Cuid2::parse(text));
+        }
+
+        return result;
+    }
+
+    void BM_Cuid2Parse(benchmark::State& state) {
+        const auto TEXTS = make_texts();
+        size_t idx = 0;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(visus::cuid2::Cuid2::parse(TEXTS[idx++ % SAMPLE_COUNT]));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_Cuid2ToString(benchmark::State& state) {
+        const auto VALUES = make_values(make_texts());
+        size_t idx = 0;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(VALUES[idx++ % SAMPLE_COUNT].str());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_HashString(benchmark::State& state) {
+        const auto TEXTS = make_texts();
+        size_t idx = 0;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(std::hash<std::string>{}(TEXTS[idx++ % SAMPLE_COUNT]));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_HashCuid2(benchmark::State& state) {
+        const auto VALUES = make_values(make_texts());
+        size_t idx = 0;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(std::hash<visus::cuid2::Cuid2>{}(VALUES[idx++ % SAMPLE_COUNT]));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_CompareString(benchmark::State& state) {
+        const auto TEXTS = make_texts();
+        size_t idx = 0;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(TEXTS[idx % SAMPLE_COUNT] < TEXTS[(idx + 1) % SAMPLE_COUNT]);
+            ++idx;
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_CompareCuid2(benchmark::State& state) {
+        const auto VALUES = make_values(make_texts());
+        size_t idx = 0;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(VALUES[idx % SAMPLE_COUNT] < VALUES[(idx + 1) % SAMPLE_COUNT]);
+            ++idx;
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+} // anonymous namespace
+
+BENCHMARK(BM_Cuid2Parse);
+
+BENCHMARK(BM_Cuid2ToString);
+
+BENCHMARK(BM_HashString);
+
+BENCHMARK(BM_HashCuid2);
+
+BENCHMARK(BM_CompareString);
+
+BENCHMARK(BM_CompareCuid2);
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "cuid2/generator.hpp"
+
+namespace {
+    /// Number of keys in the benchmarked table.
+    constexpr std::size_t TABLE_ROWS = 200'000;
+
+    /// Keys per leaf page, roughly an 8 KiB page of 24-character keys and
+    /// row pointers.
+    constexpr std::size_t PAGE_CAPACITY = 256;
+
+    /// Leaf level of a B+-tree primary key index.
+    ///
+    /// Pages are keyed by their smallest identifier. A full page is split in
+    /// half, except that an append to the rightmost page starts a new page
+    /// and leaves the old one full, as Postgres and InnoDB do. Split and fill
+    /// counts expose the page churn a key pattern causes.
+    class LeafIndex {
+        std::map<std::string, std::vector<std::string>, std::less<>> pages_{{std::string(), {}}};
+        std::size_t splits_ = 0;
+        std::size_t rows_ = 0;
+
+    public:
+        void insert(const std::string& key) {
+            auto page = std::prev(pages_.upper_bound(key));
+            auto& keys = page->second;
+
+            const auto POSITION = std::upper_bound(keys.begin(), keys.end(), key);
+            const bool APPEND = POSITION == keys.end() && std::next(page) == pages_.end();
+
+            keys.insert(POSITION, key);
+            ++rows_;
+
+            if (keys.size() > PAGE_CAPACITY) {
+                const auto MIDDLE = APPEND ? std::prev(keys.end())
+                                           : keys.begin() + static_cast<std::ptrdiff_t>(keys.size() / 2);
+                std::vector<std::string> upper(MIDDLE, keys.end());
+                keys.erase(MIDDLE, keys.end());
+
+                std::string first = upper.front();
+                pages_.emplace_hint(std::next(page), std::move(first), std::move(upper));
+                ++splits_;
+            }
+        }
+
+        [[nodiscard]] std::size_t splits() const noexcept {
+            return splits_;
+        }
+
+        /// Share of leaf slots holding a key.
+        [[nodiscard]] double fill_factor() const noexcept {
+            return static_cast<double>(rows_) / static_cast<double>(pages_.size() * PAGE_CAPACITY);
+        }
+    };
+
+    /// Generates the table's keys in creation order, in batches as a busy
+    /// service would.
+    std::vector<std::string> make_keys(const bool SORTABLE) {
+        visus::cuid2::Generator generator({.sortable = SORTABLE});
+
+        std::vector<std::string> keys(TABLE_ROWS);
+        for (std::size_t offset = 0; offset < TABLE_ROWS; offset += 1000) {
+            generator.next_batch(std::span(keys).subspan(offset, std::min<std::size_t>(1000, TABLE_ROWS - offset)));
+        }
+
+        return keys;
+    }
+
+    /// Inserts TABLE_ROWS keys into an empty index in creation order.
+    ///
+    /// Random keys land on any page of the index; sortable keys land on the
+    /// few rightmost pages, which stay hot in cache.
+    void BM_IndexInsert(benchmark::State& state) {
+        const bool SORTABLE = state.range(0) != 0;
+        const std::vector<std::string> KEYS = make_keys(SORTABLE);
+
+        std::size_t splits = 0;
+        double fill_factor = 0.0;
+
+        for (auto _ : state) {
+            LeafIndex index;
+            for (const auto& key : KEYS) {
+                index.insert(key);
+            }
+
+            splits = index.splits();
+            fill_factor = index.fill_factor();
+            benchmark::DoNotOptimize(splits);
+        }
+
+        state.counters["splits"] = static_cast<double>(splits);
+        state.counters["fill"] = fill_factor;
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(TABLE_ROWS));
+    }
+} // anonymous namespace
+
+BENCHMARK(BM_IndexInsert)->ArgName("sortable")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,70 @@
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "cuid2/cuid2.hpp"
+#include "cuid2/generator.hpp"
+
+// Unlike cuid2_bench, this binary links the built cuid2 target, so every call
+// crosses the library boundary the way an application's would. Each run is
+// labelled with the linkage it was built with; build once with the default
+// shared library and once with -DBUILD_STATIC=ON, both in Release, and compare
+// the two JSON outputs.
+
+namespace {
+    void BM_LinkedGenerate(benchmark::State& state) {
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(visus::cuid2::generate());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+        state.SetLabel(CUID2_LINKAGE);
+    }
+
+    void BM_LinkedGenerateInto(benchmark::State& state) {
+        std::array<char, visus::cuid2::DEFAULT_LENGTH> buffer{};
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(visus::cuid2::generate_into(buffer.data(), buffer.size()));
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+        state.SetLabel(CUID2_LINKAGE);
+    }
+
+    void BM_LinkedGeneratorNextInto(benchmark::State& state) {
+        visus::cuid2::Generator generator;
+        std::array<char, visus::cuid2::DEFAULT_LENGTH> buffer{};
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(generator.next_into(buffer));
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+        state.SetLabel(CUID2_LINKAGE);
+    }
+
+    /// A call short enough for the cross-module call overhead to show.
+    void BM_LinkedIsCuid2(benchmark::State& state) {
+        const std::string ID = visus::cuid2::generate();
+
+        for (auto _ : state) {
+            std::string_view view = ID;
+            benchmark::DoNotOptimize(view);
+            benchmark::DoNotOptimize(visus::cuid2::is_cuid2(view));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+        state.SetLabel(CUID2_LINKAGE);
+    }
+} // anonymous namespace
+
+BENCHMARK(BM_LinkedGenerate);
+BENCHMARK(BM_LinkedGenerateInto);
+BENCHMARK(BM_LinkedGeneratorNextInto);
+BENCHMARK(BM_LinkedIsCuid2);
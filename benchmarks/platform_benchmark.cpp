@@ -0,0 +1,103 @@
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <openssl/rand.h>
+
+#include "cuid2/platform.hpp"
+
+namespace {
+    using visus::cuid2::platform::EntropyBackend;
+
+    constexpr size_t MAX_REQUEST_SIZE = 4096;
+
+    constexpr std::array<EntropyBackend, 4> ALL_BACKENDS = {
+        EntropyBackend::openssl, EntropyBackend::system, EntropyBackend::chacha20, EntropyBackend::aes_ctr};
+
+    void BM_RandBytesDirect(benchmark::State& state) {
+        const auto LEN = static_cast<int>(state.range(0));
+        std::array<unsigned char, MAX_REQUEST_SIZE> buffer{};
+
+        for (auto _ : state) {
+            RAND_bytes(buffer.data(), LEN);
+            benchmark::DoNotOptimize(buffer.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetBytesProcessed(state.iterations() * LEN);
+    }
+
+    void BM_GetRandomBytes(benchmark::State& state) {
+        const auto LEN = static_cast<size_t>(state.range(0));
+        std::array<unsigned char, MAX_REQUEST_SIZE> buffer{};
+
+        for (auto _ : state) {
+            visus::cuid2::platform::get_random_bytes(buffer.data(), LEN);
+            benchmark::DoNotOptimize(buffer.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(LEN));
+    }
+
+    /// Raw throughput of each entropy source; 4096 bytes is one pool refill.
+    void BM_EntropySource(benchmark::State& state) {
+        const auto SOURCE = visus::cuid2::platform::make_entropy_source(ALL_BACKENDS[static_cast<size_t>(state.range(0))]);
+        const auto LEN = static_cast<size_t>(state.range(1));
+        std::array<uint8_t, MAX_REQUEST_SIZE> buffer{};
+
+        for (auto _ : state) {
+            SOURCE->fill(std::span<uint8_t>(buffer.data(), LEN));
+            benchmark::DoNotOptimize(buffer.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetLabel(std::string(SOURCE->name()));
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(LEN));
+    }
+
+    /// Pooled requests with each source selected; the pool hides most of the
+    /// difference for small requests.
+    void BM_GetRandomBytesWithSource(benchmark::State& state) {
+        visus::cuid2::platform::set_entropy_source(ALL_BACKENDS[static_cast<size_t>(state.range(0))]);
+        const auto LEN = static_cast<size_t>(state.range(1));
+        std::array<unsigned char, MAX_REQUEST_SIZE> buffer{};
+
+        for (auto _ : state) {
+            visus::cuid2::platform::get_random_bytes(buffer.data(), LEN);
+            benchmark::DoNotOptimize(buffer.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetLabel(visus::cuid2::platform::entropy_source_name());
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(LEN));
+
+        visus::cuid2::platform::set_entropy_source(EntropyBackend::openssl);
+    }
+
+    /// Environment capture used by the fingerprint.
+    void BM_AppendEnvironment(benchmark::State& state) {
+        std::vector<uint8_t> out;
+
+        for (auto _ : state) {
+            out.clear();
+            visus::cuid2::platform::append_environment(out);
+            benchmark::DoNotOptimize(out.data());
+        }
+
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(out.size()));
+    }
+} // anonymous namespace
+
+// 1 byte: prefix; 33 bytes: one 32-character identifier; 4096: bypasses the pool
+BENCHMARK(BM_RandBytesDirect)->ArgName("bytes")->Arg(1)->Arg(8)->Arg(33)->Arg(256)->Arg(1024)->Arg(4096);
+
+BENCHMARK(BM_GetRandomBytes)->ArgName("bytes")->Arg(1)->Arg(8)->Arg(33)->Arg(256)->Arg(1024)->Arg(4096);
+
+BENCHMARK(BM_EntropySource)->ArgNames({"source", "bytes"})->ArgsProduct({{0, 1, 2, 3}, {33, 4096}});
+
+BENCHMARK(BM_GetRandomBytesWithSource)->ArgNames({"source", "bytes"})->ArgsProduct({{0, 1, 2, 3}, {33, 4096}});
+
+BENCHMARK(BM_AppendEnvironment);
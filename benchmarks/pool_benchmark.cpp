@@ -0,0 +1,55 @@
+#include <array>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "cuid2/cuid2.hpp"
+#include "cuid2/pool.hpp"
+
+namespace {
+    /// Baseline: every identifier generated on the calling thread.
+    void BM_GenerateInline(benchmark::State& state) {
+        std::array<char, visus::cuid2::DEFAULT_LENGTH> buffer{};
+
+        for (auto _ : state) {
+            visus::cuid2::generate_into(buffer);
+            benchmark::DoNotOptimize(buffer.data());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /// Pool large enough that the refill thread keeps up; on a single core
+    /// the refill thread competes with the benchmark for the CPU.
+    void BM_PoolAcquireInto(benchmark::State& state) {
+        visus::cuid2::Pool pool({.capacity = static_cast<std::size_t>(state.range(0))});
+        std::array<char, visus::cuid2::DEFAULT_LENGTH> buffer{};
+
+        for (auto _ : state) {
+            pool.acquire_into(buffer);
+            benchmark::DoNotOptimize(buffer.data());
+        }
+
+        const auto STATS = pool.stats();
+        state.counters["hit_rate"] = STATS.hit_rate();
+        state.counters["max_refill_lag_us"] = static_cast<double>(STATS.max_refill_lag.count()) / 1000.0;
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_PoolAcquire(benchmark::State& state) {
+        visus::cuid2::Pool pool({.capacity = static_cast<std::size_t>(state.range(0))});
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(pool.acquire());
+        }
+
+        state.counters["hit_rate"] = pool.stats().hit_rate();
+        state.SetItemsProcessed(state.iterations());
+    }
+} // anonymous namespace
+
+BENCHMARK(BM_GenerateInline);
+
+BENCHMARK(BM_PoolAcquireInto)->Arg(1024)->Arg(65536);
+
+BENCHMARK(BM_PoolAcquire)->Arg(65536);
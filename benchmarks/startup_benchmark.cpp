@@ -0,0 +1,119 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <type_traits>
+
+#include <benchmark/benchmark.h>
+
+#include <dlfcn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+    /// Itanium-mangled name of visus::cuid2::generate_into(char*, std::size_t).
+    constexpr const char* GENERATE_INTO_SYMBOL = std::is_same_v<std::size_t, unsigned long>
+        ? "_ZN5visus5cuid213generate_intoEPcm"
+        : "_ZN5visus5cuid213generate_intoEPcy";
+
+    using GenerateIntoFunction = std::size_t (*)(char*, std::size_t);
+
+    /// Size of each padding environment variable used to grow the environment.
+    constexpr size_t PAD_VALUE_SIZE = 1024;
+
+    /// Adds ENV_KB one-kilobyte variables so the fingerprint scan has more to do.
+    void pad_environment(const int64_t ENV_KB, const bool ENABLE) {
+        const std::string VALUE(PAD_VALUE_SIZE, 'x');
+
+        for (int64_t idx = 0; idx < ENV_KB; ++idx) {
+            const std::string NAME = "CUID2_BENCH_PAD_" + std::to_string(idx);
+
+            if (ENABLE) {
+                setenv(NAME.c_str(), VALUE.c_str(), 1);
+            } else {
+                unsetenv(NAME.c_str());
+            }
+        }
+    }
+
+    /// Loads libcuid2 in a fresh child process and returns the elapsed time.
+    ///
+    /// Each iteration forks so that the library's static initialization runs
+    /// every time; the child times dlopen() (and optionally the first
+    /// identifier) and reports the result through a pipe.
+    ///
+    /// @param FIRST_ID Whether to generate one identifier after loading
+    /// @return Elapsed seconds measured in the child, or a negative value on failure
+    double time_startup(const bool FIRST_ID) {
+        std::array<int, 2> pipe_fds{};
+        if (pipe(pipe_fds.data()) != 0) {
+            return -1.0;
+        }
+
+        const pid_t PID = fork();
+        if (PID == 0) {
+            const auto START = std::chrono::steady_clock::now();
+
+            void* handle = dlopen(CUID2_LIBRARY_PATH, RTLD_NOW | RTLD_LOCAL);
+            bool succeeded = handle != nullptr;
+
+            if (succeeded && FIRST_ID) {
+                const auto GENERATE_INTO = reinterpret_cast<GenerateIntoFunction>(dlsym(handle, GENERATE_INTO_SYMBOL));
+                std::array<char, 24> buffer{};
+                succeeded = GENERATE_INTO != nullptr && GENERATE_INTO(buffer.data(), buffer.size()) == buffer.size();
+            }
+
+            const auto ELAPSED = std::chrono::duration<double>(std::chrono::steady_clock::now() - START).count();
+            const double RESULT = succeeded ? ELAPSED : -1.0;
+
+            const bool WRITTEN = write(pipe_fds[1], &RESULT, sizeof(RESULT)) == static_cast<ssize_t>(sizeof(RESULT));
+            _exit(WRITTEN ? 0 : 1);
+        }
+
+        close(pipe_fds[1]);
+
+        double elapsed = -1.0;
+        if (PID < 0 || read(pipe_fds[0], &elapsed, sizeof(elapsed)) != static_cast<ssize_t>(sizeof(elapsed))) {
+            elapsed = -1.0;
+        }
+
+        close(pipe_fds[0]);
+
+        if (PID > 0) {
+            int status = 0;
+            waitpid(PID, &status, 0);
+        }
+
+        return elapsed;
+    }
+
+    void run_startup(benchmark::State& state, const bool FIRST_ID) {
+        const int64_t ENV_KB = state.range(0);
+        pad_environment(ENV_KB, true);
+
+        for (auto _ : state) {
+            const double ELAPSED = time_startup(FIRST_ID);
+            if (ELAPSED < 0) {
+                state.SkipWithError("failed to load libcuid2 in child process");
+                break;
+            }
+
+            state.SetIterationTime(ELAPSED);
+        }
+
+        pad_environment(ENV_KB, false);
+    }
+
+    void BM_StartupDlopen(benchmark::State& state) {
+        run_startup(state, false);
+    }
+
+    void BM_StartupFirstId(benchmark::State& state) {
+        run_startup(state, true);
+    }
+} // anonymous namespace
+
+BENCHMARK(BM_StartupDlopen)->ArgName("env_kb")->Arg(0)->Arg(64)->UseManualTime()->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_StartupFirstId)->ArgName("env_kb")->Arg(0)->Arg(64)->UseManualTime()->Unit(benchmark::kMicrosecond);
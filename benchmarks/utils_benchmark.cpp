@@ -0,0 +1,70 @@
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include <benchmark/benchmark.h>
+
+#include "cuid2/cuid2.hpp"
+#include "cuid2/utils.hpp"
+
+namespace {
+    /// Non-trivial digest so the base-36 division does not short-circuit.
+    visus::cuid2::utils::Digest make_digest() {
+        visus::cuid2::utils::Digest digest{};
+
+        for (size_t idx = 0; idx < digest.size(); ++idx) {
+            digest[idx] = static_cast<uint8_t>(0xA5 ^ (idx * 37));
+        }
+
+        return digest;
+    }
+
+    /// Full base-36 encoding of a SHA3-512 digest.
+    void BM_EncodeBase36(benchmark::State& state) {
+        const auto DIGEST = make_digest();
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(visus::cuid2::utils::encode_base36(DIGEST));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /// Non-allocating prefix encoding, as used for each identifier.
+    void BM_EncodeBase36Prefix(benchmark::State& state) {
+        const auto DIGEST = make_digest();
+        const auto DIGITS = static_cast<size_t>(state.range(0));
+        std::array<char, visus::cuid2::MAX_CUID2_LENGTH> out{};
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(visus::cuid2::utils::encode_base36_prefix(DIGEST, std::span(out).first(DIGITS)));
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_TimestampTicks(benchmark::State& state) {
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(visus::cuid2::utils::get_timestamp_ticks());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_CoarseTimestampTicks(benchmark::State& state) {
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(visus::cuid2::utils::get_coarse_timestamp_ticks());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+} // anonymous namespace
+
+BENCHMARK(BM_EncodeBase36);
+
+// Digits after the prefix letter for lengths 4, 24 and 32
+BENCHMARK(BM_EncodeBase36Prefix)->ArgName("digits")->Arg(3)->Arg(23)->Arg(31);
+
+BENCHMARK(BM_TimestampTicks);
+BENCHMARK(BM_CoarseTimestampTicks);
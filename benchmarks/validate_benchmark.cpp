@@ -0,0 +1,134 @@
+#include <array>
+#include <memory>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "cuid2/cuid2.hpp"
+#include "validate_kernels.hpp"
+
+namespace {
+    using visus::cuid2::validation::Backend;
+
+    constexpr size_t SAMPLE_COUNT = 1024;
+
+    constexpr std::array<Backend, 4> ALL_BACKENDS = {Backend::scalar, Backend::sse42, Backend::avx2, Backend::neon};
+
+    /// Returns SAMPLE_COUNT identifiers of LENGTH characters stored back to back.
+    std::string make_column(const int LENGTH) {
+        std::string result;
+        result.reserve(SAMPLE_COUNT * static_cast<size_t>(LENGTH));
+
+        for (const auto& id : visus::cuid2::generate_batch(SAMPLE_COUNT, LENGTH)) {
+            result += id;
+        }
+
+        return result;
+    }
+
+    /// Returns views of each record in a column built by make_column().
+    std::vector<std::string_view> make_views(const std::string& column, const int LENGTH) {
+        std::vector<std::string_view> result;
+        result.reserve(SAMPLE_COUNT);
+
+        for (size_t idx = 0; idx < SAMPLE_COUNT; ++idx) {
+            result.push_back(std::string_view(column).substr(idx * static_cast<size_t>(LENGTH), static_cast<size_t>(LENGTH)));
+        }
+
+        return result;
+    }
+
+    void BM_IsCuid2(benchmark::State& state) {
+        const int LENGTH = static_cast<int>(state.range(0));
+        const std::string COLUMN = make_column(LENGTH);
+        const auto VIEWS = make_views(COLUMN, LENGTH);
+        size_t idx = 0;
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(visus::cuid2::is_cuid2(VIEWS[idx++ % SAMPLE_COUNT]));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /// Baseline: the regular expression services wrote before is_cuid2() existed.
+    void BM_IsCuid2Regex(benchmark::State& state) {
+        const int LENGTH = static_cast<int>(state.range(0));
+        const std::string COLUMN = make_column(LENGTH);
+        const auto VIEWS = make_views(COLUMN, LENGTH);
+        const std::regex PATTERN("[a-z][0-9a-z]{3,31}");
+        size_t idx = 0;
+
+        for (auto _ : state) {
+            const std::string_view VIEW = VIEWS[idx++ % SAMPLE_COUNT];
+            benchmark::DoNotOptimize(std::regex_match(VIEW.begin(), VIEW.end(), PATTERN));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /// Exact-read kernel of each backend; unsupported backends are skipped.
+    void BM_ValidateKernel(benchmark::State& state) {
+        const Backend BACKEND = ALL_BACKENDS[static_cast<size_t>(state.range(0))];
+        const int LENGTH = static_cast<int>(state.range(1));
+
+        if (!visus::cuid2::validation::is_supported(BACKEND)) {
+            state.SkipWithError("backend not supported on this CPU");
+            return;
+        }
+
+        const auto KERNEL = visus::cuid2::validation::kernels_for(BACKEND).exact;
+        const std::string COLUMN = make_column(LENGTH);
+        const auto VIEWS = make_views(COLUMN, LENGTH);
+        size_t idx = 0;
+
+        for (auto _ : state) {
+            const std::string_view VIEW = VIEWS[idx++ % SAMPLE_COUNT];
+            benchmark::DoNotOptimize(KERNEL(VIEW.data(), VIEW.size()));
+        }
+
+        state.SetLabel(std::string(visus::cuid2::validation::backend_name(BACKEND)));
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_ValidateBatchViews(benchmark::State& state) {
+        const int LENGTH = static_cast<int>(state.range(0));
+        const std::string COLUMN = make_column(LENGTH);
+        const auto VIEWS = make_views(COLUMN, LENGTH);
+        const auto RESULTS = std::make_unique<bool[]>(SAMPLE_COUNT);
+
+        for (auto _ : state) {
+            visus::cuid2::validate_batch(VIEWS, std::span<bool>(RESULTS.get(), SAMPLE_COUNT));
+            benchmark::DoNotOptimize(RESULTS.get());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SAMPLE_COUNT));
+    }
+
+    void BM_ValidateColumn(benchmark::State& state) {
+        const int LENGTH = static_cast<int>(state.range(0));
+        const std::string COLUMN = make_column(LENGTH);
+        const auto RESULTS = std::make_unique<bool[]>(SAMPLE_COUNT);
+
+        for (auto _ : state) {
+            visus::cuid2::validate_batch(COLUMN, static_cast<size_t>(LENGTH), LENGTH,
+                std::span<bool>(RESULTS.get(), SAMPLE_COUNT));
+            benchmark::DoNotOptimize(RESULTS.get());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SAMPLE_COUNT));
+    }
+} // anonymous namespace
+
+BENCHMARK(BM_IsCuid2)->Arg(4)->Arg(24)->Arg(32);
+
+BENCHMARK(BM_IsCuid2Regex)->Arg(24);
+
+BENCHMARK(BM_ValidateKernel)->ArgsProduct({{0, 1, 2, 3}, {4, 24, 32}});
+
+BENCHMARK(BM_ValidateBatchViews)->Arg(24);
+
+BENCHMARK(BM_ValidateColumn)->Arg(24)->Arg(32);
@@ -0,0 +1,131 @@
+/// @file async.hpp
+/// @brief Awaitable identifier generation for coroutine-based event loops
+///
+/// Provides async_generate(), which returns a C++20 awaitable so that an event
+/// loop never hashes or waits on the entropy source on its own thread. The
+/// identifiers are taken from a Pool when one is given and has enough ready,
+/// without suspending; otherwise the awaiting coroutine is suspended, the
+/// identifiers are generated by an executor, and the coroutine is resumed.
+/// Executors are plain callables, so any runtime (asio, io_uring loops, a
+/// thread pool) can be plugged in without this library depending on it.
+///
+/// Example usage with asio:
+/// @code
+///   #include <cuid2/async.hpp>
+///
+///   asio::awaitable<void> handle(asio::io_context& io, asio::thread_pool& workers) {
+///       const visus::cuid2::AsyncOptions OPTIONS{
+///           .executor = [&](auto job) { asio::post(workers, std::move(job)); },
+///           .resume = [&](auto job) { asio::post(io, std::move(job)); },
+///       };
+///
+///       std::vector<std::string> ids = co_await visus::cuid2::async_generate(16, OPTIONS);
+///   }
+/// @endcode
+
+#ifndef LIBCUID2_ASYNC_HPP
+#define LIBCUID2_ASYNC_HPP
+
+#include <cuid2/cuid2_export.hpp>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "cuid2/cuid2.hpp"
+
+namespace visus::cuid2 {
+    class Pool;
+
+    /// Runs a unit of work, typically by posting it to another thread.
+    ///
+    /// Must run the job exactly once; it may do so before returning.
+    using AsyncExecutor = std::function<void(std::function<void()>)>;
+
+    /// Options for async_generate().
+    struct AsyncOptions {
+        /// Identifier length (min: 4, max: 32); must match pool's if set.
+        int length = DEFAULT_LENGTH;
+
+        /// Pool whose ready identifiers are taken first, without suspending;
+        /// must outlive the awaitable.
+        Pool* pool = nullptr;
+
+        /// Generates the identifiers the pool could not supply; the library's
+        /// shared worker thread if empty.
+        AsyncExecutor executor{};
+
+        /// Resumes the awaiting coroutine after generation; the coroutine is
+        /// resumed directly on the generating thread if empty.
+        AsyncExecutor resume{};
+    };
+
+    /// Awaitable returned by async_generate().
+    ///
+    /// co_await yields a vector of identifiers and rethrows any error raised
+    /// while generating them, such as std::runtime_error from a failed
+    /// entropy source. Await it at most once.
+    class CUID2_API GenerateAwaitable {
+        /// Number of identifiers requested.
+        std::size_t count_;
+
+        /// Length, pool and executors.
+        AsyncOptions options_;
+
+        /// Results; the first taken_ come from the pool.
+        std::vector<std::string> ids_;
+
+        /// Identifiers taken from the pool by await_ready().
+        std::size_t taken_ = 0;
+
+        /// Error raised on the executor, rethrown by await_resume().
+        std::exception_ptr error_;
+
+        /// Generates the identifiers not taken from the pool.
+        void generate_remaining() noexcept;
+
+    public:
+        /// Prepares COUNT identifiers' worth of storage.
+        ///
+        /// @param COUNT Number of identifiers to produce
+        /// @param options Validated length, pool and executors
+        GenerateAwaitable(std::size_t COUNT, AsyncOptions options);
+
+        /// Takes identifiers from the pool if one was given.
+        ///
+        /// @return true if every identifier is already available
+        [[nodiscard]] bool await_ready();
+
+        /// Hands the remaining work to the executor.
+        ///
+        /// @param handle Coroutine to resume once the identifiers are ready
+        void await_suspend(std::coroutine_handle<> handle);
+
+        /// Returns the identifiers.
+        ///
+        /// @return COUNT identifiers of the requested length
+        /// @throws the error raised while generating, if any
+        [[nodiscard]] std::vector<std::string> await_resume();
+    };
+
+    /// Generates identifiers without blocking the awaiting thread.
+    ///
+    /// With a pool holding COUNT ready identifiers, co_await completes
+    /// immediately and costs COUNT copies. Otherwise the shortfall is
+    /// generated as one batch by options.executor and the coroutine resumes
+    /// through options.resume. The shared worker thread used when no executor
+    /// is given starts on first use, is replaced in a forked child, and runs
+    /// until the process exits.
+    ///
+    /// @param COUNT Number of identifiers to generate
+    /// @param options Length, pool and executors
+    /// @return Awaitable yielding a vector of COUNT identifiers
+    /// @throws std::invalid_argument if options.length is outside [4, 32] or
+    ///         differs from the pool's length
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    [[nodiscard]] CUID2_API GenerateAwaitable async_generate(std::size_t COUNT, AsyncOptions options = {});
+} // namespace visus::cuid2
+
+#endif // LIBCUID2_ASYNC_HPP
@@ -4,11 +4,16 @@
 /// Provides a singleton counter that generates monotonically increasing values
 /// for CUID2 identifier generation. The counter is initialized with a
 /// cryptographically random seed to ensure uniqueness across process restarts.
+/// An optional per-thread block mode trades global ordering for contention-free
+/// increments on many-core systems, and an optional NUMA mode gives each
+/// memory node its own partition of the counter range.
 
 #ifndef LIBCUID2_COUNTER_HPP
 #define LIBCUID2_COUNTER_HPP
 
+#include <array>
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 
 namespace visus::cuid2 {
@@ -18,7 +23,30 @@ namespace visus::cuid2 {
     /// with a cryptographically random initial value. The counter provides
     /// monotonically increasing values that ensure uniqueness within the same
     /// timestamp across concurrent requests.
+    ///
+    /// By default every call performs one atomic increment on the shared value.
+    /// With set_thread_block_size() each thread instead reserves a block of
+    /// values with a single increment and hands them out locally, so the shared
+    /// cache line is only touched once per block. Every value is still returned
+    /// at most once process-wide; only the global ordering between threads is
+    /// given up.
+    ///
+    /// When the process generation changes (in the child after fork(), or
+    /// after reseed()), the next call advances the shared value by a fresh
+    /// random offset and discards any thread block reserved earlier, so a
+    /// forked child does not repeat its parent's sequence.
+    ///
+    /// With set_numa_partitioned() each NUMA node draws from its own range of
+    /// values, carved out of the shared value 2^40 at a time, so threads on
+    /// different sockets never increment the same cache line. Values remain
+    /// unique process-wide; ordering holds only among threads on one node.
     class Counter {
+        /// Number of per-node partitions; nodes beyond it share partitions.
+        static constexpr std::size_t MAX_NUMA_NODES = 64;
+
+        /// Range of counter values owned by one node; defined in counter.cpp.
+        struct Partition;
+
         /// Singleton instance with thread-safe initialization.
         ///
         /// @note Defined outside class after type is complete
@@ -32,15 +60,103 @@ namespace visus::cuid2 {
         /// Atomic counter value, safe for concurrent access.
         std::atomic<int64_t> value_{generate_initial_counter_value()};
 
+        /// Number of values each thread reserves at once (1 = no blocks).
+        std::atomic<int64_t> block_size_{1};
+
+        /// Process generation the value was last seeded for. Reading it also
+        /// registers the fork handler before any value is handed out.
+        std::atomic<uint64_t> generation_{current_generation()};
+
+        /// Whether values are drawn from per-node partitions.
+        std::atomic<bool> numa_partitioned_{false};
+
+        /// Current partition of each node, created on first use from it.
+        std::array<std::atomic<Partition*>, MAX_NUMA_NODES> partitions_{};
+
+        /// Returns the current process generation.
+        static uint64_t current_generation() noexcept;
+
+        /// Advances the shared value by COUNT, first re-seeding it if it was
+        /// seeded for an older generation.
+        ///
+        /// @param COUNT Number of values to take
+        /// @param GENERATION Current process generation
+        /// @return The first value taken
+        static int64_t take(int64_t COUNT, uint64_t GENERATION);
+
+        /// Takes COUNT values from the calling thread's node partition,
+        /// replacing the partition once it is used up or outdated.
+        ///
+        /// @param COUNT Number of values to take
+        /// @param GENERATION Current process generation
+        /// @return The first value taken
+        static int64_t take_local(int64_t COUNT, uint64_t GENERATION);
+
+        /// Takes COUNT values in the configured mode.
+        ///
+        /// @param COUNT Number of values to take
+        /// @param GENERATION Current process generation
+        /// @return The first value taken
+        static int64_t draw(int64_t COUNT, uint64_t GENERATION);
+
         /// Private constructor, initializes counter with random seed.
         Counter() = default;
 
     public:
         /// Returns the next counter value in a thread-safe manner.
         ///
+        /// In block mode the value comes from the calling thread's reserved
+        /// block, and consecutive calls are only sequential within a thread.
+        ///
         /// @return The next sequential counter value
         /// @note Thread-safe: Can be called concurrently from multiple threads
         [[nodiscard]] static int64_t next();
+
+        /// Reserves a contiguous range of counter values in a thread-safe manner.
+        ///
+        /// Performs a single atomic increment by COUNT and returns the first value
+        /// of the reserved range. The caller owns the values [first, first + COUNT)
+        /// exclusively; no other call to next() or reserve() will return them.
+        ///
+        /// @param COUNT Number of consecutive counter values to reserve
+        /// @return The first counter value of the reserved range
+        /// @note Thread-safe: Can be called concurrently from multiple threads
+        [[nodiscard]] static int64_t reserve(int64_t COUNT);
+
+        /// Sets how many values next() reserves per thread at once.
+        ///
+        /// A size of 1 (the default) makes every next() call increment the
+        /// shared counter. Larger sizes, such as 1024, let each thread reserve a
+        /// block with one atomic increment. Values already reserved by a thread
+        /// are used up before the new size takes effect for that thread, so
+        /// changing the size never causes a value to be returned twice.
+        ///
+        /// @param SIZE Number of values per thread block (must be at least 1)
+        /// @throws std::invalid_argument if SIZE is less than 1
+        /// @note Thread-safe: Can be called concurrently with next()
+        static void set_thread_block_size(int64_t SIZE);
+
+        /// Returns the current per-thread block size.
+        ///
+        /// @return Number of values reserved per thread block (1 = no blocks)
+        [[nodiscard]] static int64_t thread_block_size() noexcept;
+
+        /// Enables or disables per-NUMA-node counter partitions.
+        ///
+        /// When enabled, next(), reserve() and thread blocks take values from
+        /// a partition owned by the calling thread's node (see
+        /// platform::get_numa_node()), refreshed every few hundred calls as
+        /// threads migrate. Switching modes at any time never causes a value
+        /// to be returned twice. Worth enabling only on multi-socket hosts.
+        ///
+        /// @param ENABLED true to partition by node, false for one shared value
+        /// @note Thread-safe: Can be called concurrently with next()
+        static void set_numa_partitioned(bool ENABLED) noexcept;
+
+        /// Returns whether per-NUMA-node counter partitions are enabled.
+        ///
+        /// @return true if values are drawn from per-node partitions
+        [[nodiscard]] static bool numa_partitioned() noexcept;
     };
 
     /// Inline static definition of singleton instance.
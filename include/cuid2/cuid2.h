@@ -0,0 +1,138 @@
+/// @file cuid2.h
+/// @brief Stable C interface for foreign-function callers
+///
+/// Exposes identifier generation to C and to runtimes that bind C symbols
+/// (Python ctypes/cffi, Go cgo, Rust FFI) without a C++ shim. Every function
+/// writes into caller-owned memory, never allocates on the caller's behalf,
+/// never throws and reports failures through an int status code. A batch of
+/// any size is one call across the language boundary.
+///
+/// Identifiers are exactly those produced by the C++ API: each thread draws
+/// from the same per-thread default generator used by visus::cuid2::generate().
+///
+/// Example usage:
+/// @code
+///   #include <cuid2/cuid2.h>
+///
+///   char id[CUID2_DEFAULT_LENGTH + 1] = {0};
+///   if (cuid2_generate_into(id, CUID2_DEFAULT_LENGTH) != CUID2_OK) {
+///       // handle error
+///   }
+///
+///   // 1000 NUL-terminated identifiers of 24 characters, 25 bytes apart
+///   char rows[1000][25] = {{0}};
+///   int status = cuid2_generate_batch(&rows[0][0], 25, 1000, 24);
+///   if (status != CUID2_OK) {
+///       fprintf(stderr, "cuid2: %s\n", cuid2_strerror(status));
+///   }
+/// @endcode
+
+#ifndef LIBCUID2_CUID2_H
+#define LIBCUID2_CUID2_H
+
+#include <stddef.h>
+
+#include <cuid2/cuid2_export.hpp>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Version of this C interface; incremented only on incompatible changes.
+#define CUID2_C_API_VERSION 1
+
+/// Default identifier length in characters.
+#define CUID2_DEFAULT_LENGTH 24
+
+/// Minimum allowed identifier length.
+#define CUID2_MIN_LENGTH 4
+
+/// Maximum allowed identifier length.
+#define CUID2_MAX_LENGTH 32
+
+/// Expected length accepted by cuid2_is_cuid2() for any valid length.
+#define CUID2_ANY_LENGTH 0
+
+/// Status codes returned by the C interface. Values are fixed and will not
+/// be renumbered.
+enum cuid2_status {
+    /// The call succeeded.
+    CUID2_OK = 0,
+
+    /// A pointer was NULL, a length was outside [4, 32] or a stride was
+    /// shorter than the length.
+    CUID2_ERROR_INVALID_ARGUMENT = -1,
+
+    /// The random source or the SHA3-512 digest failed.
+    CUID2_ERROR_RUNTIME = -2,
+
+    /// Per-thread state could not be allocated.
+    CUID2_ERROR_OUT_OF_MEMORY = -3,
+
+    /// Any other failure, such as an exception from a custom entropy source.
+    CUID2_ERROR_UNKNOWN = -4
+};
+
+/// Returns the version of the C interface implemented by the loaded library.
+///
+/// Compare with CUID2_C_API_VERSION to detect a header/library mismatch at
+/// run time, where bindings cannot check it at compile time.
+///
+/// @return CUID2_C_API_VERSION of the library build
+CUID2_API int cuid2_abi_version(void);
+
+/// Writes one identifier of the given length into caller memory.
+///
+/// Exactly length characters are written and no NUL terminator is appended.
+///
+/// @param out Destination for length characters
+/// @param length Identifier length (min: 4, max: 32)
+/// @return CUID2_OK, or a negative cuid2_status on failure; out is left in
+///         an unspecified state on failure
+/// @note Thread-safe: Can be called concurrently from multiple threads
+CUID2_API int cuid2_generate_into(char* out, size_t length);
+
+/// Writes count identifiers as fixed-width records at a fixed stride.
+///
+/// Record i occupies bytes [i * stride, i * stride + length) of buf, so buf
+/// must hold (count - 1) * stride + length bytes. The bytes between records
+/// are left untouched, which keeps pre-written NUL terminators or padding
+/// intact (stride == length + 1 yields an array of C strings). The timestamp
+/// read, counter reservation and random-byte requests are amortized over the
+/// whole batch, and nothing is allocated.
+///
+/// @param buf Destination for count records; may be NULL if count is 0
+/// @param stride Distance in bytes between consecutive records (at least length)
+/// @param count Number of identifiers to write
+/// @param length Identifier length (min: 4, max: 32)
+/// @return CUID2_OK, or a negative cuid2_status on failure; buf is left in an
+///         unspecified state on failure
+/// @note Thread-safe: Can be called concurrently from multiple threads
+CUID2_API int cuid2_generate_batch(char* buf, size_t stride, size_t count, int length);
+
+/// Checks whether size bytes of text form a well-formed identifier.
+///
+/// @param text Text to check; may be NULL if size is 0
+/// @param size Number of bytes of text
+/// @param expected_length Required length, or CUID2_ANY_LENGTH for 4 to 32
+/// @return 1 if text is a lowercase letter followed by lowercase base-36
+///         digits and has the expected length, 0 otherwise
+/// @note Thread-safe: Can be called concurrently from multiple threads
+CUID2_API int cuid2_is_cuid2(const char* text, size_t size, int expected_length);
+
+/// Refreshes all process-derived state, as after fork().
+///
+/// @note Thread-safe: Can be called concurrently from multiple threads
+CUID2_API void cuid2_reseed(void);
+
+/// Describes a status code.
+///
+/// @param status Value returned by another function of this interface
+/// @return Static NUL-terminated English description; never NULL
+CUID2_API const char* cuid2_strerror(int status);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // LIBCUID2_CUID2_H
@@ -2,8 +2,10 @@
 /// @brief Main CUID2 identifier generation API
 ///
 /// This is the primary public interface for the libcuid2 library. It provides
-/// collision-resistant, sortable unique identifiers suitable for use as database
-/// keys, distributed system identifiers, and URL-safe tokens.
+/// collision-resistant, uniformly random unique identifiers suitable for use as
+/// database keys, distributed system identifiers, and URL-safe tokens.
+/// Generators created with GeneratorOptions::sortable order identifiers by
+/// creation time instead.
 ///
 /// Example usage:
 /// @code
@@ -14,14 +16,36 @@
 ///
 ///   // Generate with custom length (16 characters)
 ///   std::string short_id = visus::cuid2::generate(16);
+///
+///   // Generate many identifiers at once, amortizing per-call overhead
+///   std::vector<std::string> ids = visus::cuid2::generate_batch(1000);
+///
+///   // Allocate the result from a per-request arena
+///   std::pmr::monotonic_buffer_resource arena;
+///   std::pmr::string pooled_id = visus::cuid2::generate(&arena);
+///
+///   // Write straight into caller-owned memory without allocating
+///   std::array<char, 24> buffer{};
+///   visus::cuid2::generate_into(buffer);
+///
+///   // Fixed length known at compile time: no allocation, no length check
+///   visus::cuid2::id<24> fixed = visus::cuid2::generate<24>();
+///
+///   // Check the shape of an identifier received from elsewhere
+///   bool valid = visus::cuid2::is_cuid2(id);
 /// @endcode
 
 #ifndef LIBCUID2_CUID2_HPP
 #define LIBCUID2_CUID2_HPP
 
 #include <cuid2/cuid2_export.hpp>
+#include <cstddef>
+#include <memory_resource>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace visus::cuid2 {
     /// Default CUID2 identifier length in characters.
@@ -38,8 +62,10 @@ namespace visus::cuid2 {
 
     /// Generates a CUID2 identifier of the specified length.
     ///
-    /// Creates a collision-resistant, sortable unique identifier by combining:
-    /// - Current timestamp (for sortability)
+    /// Creates a collision-resistant, uniformly random unique identifier by
+    /// combining:
+    /// - Current timestamp (for uniqueness over time; hashed, so identifiers do
+    ///   not sort by time, which only GeneratorOptions::sortable provides)
     /// - Atomic counter (for uniqueness within same timestamp)
     /// - System fingerprint (for uniqueness across processes/machines)
     /// - Cryptographic random bytes (for collision resistance)
@@ -53,6 +79,194 @@ namespace visus::cuid2 {
     /// @throws std::invalid_argument if MAX_LENGTH is outside valid range [4, 32]
     /// @note Thread-safe: Can be called concurrently from multiple threads
     CUID2_API std::string generate(int MAX_LENGTH = DEFAULT_LENGTH);
+
+    /// Generates a CUID2 identifier whose storage comes from a memory resource.
+    ///
+    /// Lets services that allocate from per-request std::pmr arenas keep
+    /// identifiers off the global heap. The string's buffer is the only
+    /// allocation; the generation pipeline itself uses stack buffers.
+    ///
+    /// @param resource Resource for the string's storage, such as a
+    ///        std::pmr::monotonic_buffer_resource
+    /// @param MAX_LENGTH Desired identifier length (default: 24, min: 4, max: 32)
+    /// @return A CUID2 identifier string of exact length MAX_LENGTH
+    /// @throws std::invalid_argument if resource is null or MAX_LENGTH is
+    ///         outside valid range [4, 32]
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    CUID2_API std::pmr::string generate(std::pmr::memory_resource* resource, int MAX_LENGTH = DEFAULT_LENGTH);
+
+    /// Writes a CUID2 identifier of the specified length into caller memory.
+    ///
+    /// Zero-allocation form of generate() for callers that store identifiers in
+    /// preallocated buffers (row buffers, arenas, fixed-width records). Exactly
+    /// LENGTH characters are written and no NUL terminator is appended. All
+    /// intermediate state lives in fixed-size stack buffers.
+    ///
+    /// @param out Destination for LENGTH characters
+    /// @param LENGTH Identifier length to write (min: 4, max: 32)
+    /// @return Number of characters written (always LENGTH in practice)
+    /// @throws std::invalid_argument if LENGTH is outside valid range [4, 32]
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    CUID2_API std::size_t generate_into(char* out, std::size_t LENGTH);
+
+    /// Writes a CUID2 identifier filling the whole of a caller-provided buffer.
+    ///
+    /// @param out Destination buffer; its size is the identifier length (min: 4, max: 32)
+    /// @return Number of characters written (always out.size() in practice)
+    /// @throws std::invalid_argument if out.size() is outside valid range [4, 32]
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    CUID2_API std::size_t generate_into(std::span<char> out);
+
+    /// Generates a CUID2 identifier into every element of a caller-provided range.
+    ///
+    /// Produces the same identifiers as repeated calls to generate(), but
+    /// amortizes the per-identifier overhead across the whole batch:
+    /// - One timestamp read for the batch
+    /// - One atomic counter reservation for the batch
+    /// - Random bytes drawn in bulk rather than twice per identifier
+    /// - One SHA3-512 digest context reused for every identifier
+    ///
+    /// Existing string capacity in the output range is reused where possible.
+    ///
+    /// @param out Range of strings to overwrite with newly generated identifiers
+    /// @param MAX_LENGTH Desired identifier length (default: 24, min: 4, max: 32)
+    /// @throws std::invalid_argument if MAX_LENGTH is outside valid range [4, 32]
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    CUID2_API void generate_batch(std::span<std::string> out, int MAX_LENGTH = DEFAULT_LENGTH);
+
+    /// Generates COUNT CUID2 identifiers of the specified length.
+    ///
+    /// Convenience wrapper around generate_batch(std::span<std::string>, int)
+    /// that allocates and returns the result vector.
+    ///
+    /// @param COUNT Number of identifiers to generate
+    /// @param MAX_LENGTH Desired identifier length (default: 24, min: 4, max: 32)
+    /// @return A vector of COUNT CUID2 identifiers of exact length MAX_LENGTH
+    /// @throws std::invalid_argument if MAX_LENGTH is outside valid range [4, 32]
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    CUID2_API std::vector<std::string> generate_batch(std::size_t COUNT, int MAX_LENGTH = DEFAULT_LENGTH);
+
+    /// Generates a CUID2 identifier into every element of a range of strings
+    /// allocating from their own memory resources.
+    ///
+    /// Behaves like generate_batch(std::span<std::string>, int); each string
+    /// grows, if at all, through its own allocator.
+    ///
+    /// @param out Range of strings to overwrite with newly generated identifiers
+    /// @param MAX_LENGTH Desired identifier length (default: 24, min: 4, max: 32)
+    /// @throws std::invalid_argument if MAX_LENGTH is outside valid range [4, 32]
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    CUID2_API void generate_batch(std::span<std::pmr::string> out, int MAX_LENGTH = DEFAULT_LENGTH);
+
+    /// Generates COUNT CUID2 identifiers with all storage from a memory resource.
+    ///
+    /// The vector and every string in it allocate from resource, so a batch
+    /// drawn from a monotonic arena costs no global heap allocations.
+    ///
+    /// @param COUNT Number of identifiers to generate
+    /// @param resource Resource for the vector's and the strings' storage
+    /// @param MAX_LENGTH Desired identifier length (default: 24, min: 4, max: 32)
+    /// @return A vector of COUNT CUID2 identifiers of exact length MAX_LENGTH
+    /// @throws std::invalid_argument if resource is null or MAX_LENGTH is
+    ///         outside valid range [4, 32]
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    CUID2_API std::pmr::vector<std::pmr::string> generate_batch(std::size_t COUNT, std::pmr::memory_resource* resource,
+                                                                int MAX_LENGTH = DEFAULT_LENGTH);
+
+    /// Writes COUNT CUID2 identifiers as fixed-width records at a fixed stride.
+    ///
+    /// Zero-allocation form of generate_batch() for columnar and FFI callers:
+    /// record i occupies bytes [i * STRIDE, i * STRIDE + MAX_LENGTH) of column,
+    /// which matches Arrow FixedSizeBinary (STRIDE == MAX_LENGTH), padded
+    /// CHAR(n) fields and NUL-terminated C strings (STRIDE > MAX_LENGTH). Every
+    /// record is filled completely; the bytes between records are left
+    /// untouched. Batch costs are amortized exactly as in generate_batch().
+    ///
+    /// @param column Buffer receiving COUNT records
+    /// @param STRIDE Distance in bytes between consecutive records
+    /// @param COUNT Number of identifiers to write
+    /// @param MAX_LENGTH Desired identifier length (default: 24, min: 4, max: 32, at most STRIDE)
+    /// @throws std::invalid_argument if MAX_LENGTH is outside [4, 32], STRIDE
+    ///         is below MAX_LENGTH or column is too small for COUNT records
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    CUID2_API void generate_batch_into(std::span<char> column, std::size_t STRIDE, std::size_t COUNT,
+                                       int MAX_LENGTH = DEFAULT_LENGTH);
+
+    /// Description of the implementation backing identifier generation.
+    ///
+    /// Intended for diagnostics and for comparing performance across hosts,
+    /// where the same binary may pick different code paths.
+    struct BackendInfo {
+        /// Cryptographic library and version providing SHA3-512 and the CSPRNG.
+        std::string crypto_library{};
+
+        /// SHA3-512 implementation used for single identifiers.
+        std::string hash_backend{};
+
+        /// SHA3-512 implementation used by batch generation.
+        std::string batch_hash_backend{};
+
+        /// Source of random bytes, including the per-thread buffer size.
+        std::string random_backend{};
+
+        /// Range-check kernel used by is_cuid2() and validate_batch().
+        std::string validation_backend{};
+
+        /// Size of the raw system fingerprint in bytes.
+        std::size_t fingerprint_size = 0;
+    };
+
+    /// Refreshes all process-derived state, as happens automatically in the
+    /// child after fork().
+    ///
+    /// fork() is detected through pthread_atfork(). Call this after any other
+    /// duplication of the process the library cannot see, such as restoring a
+    /// VM snapshot or checkpoint, or a custom spawn mechanism on Windows. The
+    /// next identifier then uses a fingerprint with the current process ID, a
+    /// shared counter advanced by a new random offset, re-seeded
+    /// generator-owned counters and empty random buffers. The environment is
+    /// not scanned again, so the call itself costs one atomic increment.
+    ///
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    CUID2_API void reseed() noexcept;
+
+    /// Environment variable holding the node identifier used by default.
+    constexpr const char* NODE_ID_VARIABLE = "CUID2_NODE_ID";
+
+    /// Uses an explicit node identifier in place of the hostname and
+    /// environment in the process fingerprint.
+    ///
+    /// Container replicas often share a hostname, most of their environment
+    /// and PID 1, so the default fingerprint does little to tell them apart.
+    /// A per-replica value such as the Kubernetes pod UID does. The fingerprint
+    /// becomes NODE_ID and the process ID, so workers sharing a node
+    /// identifier still differ. Setting CUID2_NODE_ID has the same effect from
+    /// the first identifier on. Either way, the hostname and environment are
+    /// not read, which removes the environment scan from the first
+    /// generate() call.
+    ///
+    /// Identifiers generated afterwards use the new fingerprint; the calling
+    /// process is responsible for keeping node identifiers unique.
+    ///
+    /// @param NODE_ID Node identifier, or empty to restore the default
+    ///        fingerprint (CUID2_NODE_ID if set, else hostname and environment)
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    CUID2_API void set_node_id(std::string_view NODE_ID);
+
+    /// Reports the backends in use by this build on this CPU.
+    ///
+    /// Computes the system fingerprint if it has not been computed yet.
+    ///
+    /// @return Description of the active hash and random backends
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    [[nodiscard]] CUID2_API BackendInfo backend_info();
 } // namespace visus::cuid2
 
+// Fixed-length id<N> and generate<N>(); included last because it builds on the
+// length constants above
+#include "cuid2/id.hpp"
+
+// is_cuid2() and validate_batch()
+#include "cuid2/validate.hpp"
+
 #endif //LIBCUID2_CUID2_HPP
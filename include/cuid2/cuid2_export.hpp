@@ -9,13 +9,16 @@
 /// which triggers __declspec(dllexport) to export symbols. When other code uses the
 /// library, __declspec(dllimport) is used to import the symbols.
 ///
+/// Static builds (BUILD_STATIC) define CUID2_STATIC for the library and everything
+/// linking it, so the macro also expands to nothing there.
+///
 /// Note: Test executables also define cuid2_EXPORTS since they compile library sources
 /// directly for testing internal components. This ensures consistent symbol visibility.
 
 #ifndef LIBCUID2_EXPORT_HPP
 #define LIBCUID2_EXPORT_HPP
 
-#ifdef _WIN32
+#if defined(_WIN32) && !defined(CUID2_STATIC)
   #ifdef cuid2_EXPORTS
     /// @brief Symbol export/import decoration for Windows DLL builds
     /// Expands to __declspec(dllexport) when building the library,
@@ -3,49 +3,127 @@
 ///
 /// Provides a singleton fingerprint that uniquely identifies the current system
 /// and process. The fingerprint combines hostname, process ID, and environment
-/// variables into a deterministic byte sequence.
+/// variables into a deterministic byte sequence, or an explicit node identifier
+/// and the process ID when one is configured.
 
 #ifndef LIBCUID2_FINGERPRINT_HPP
 #define LIBCUID2_FINGERPRINT_HPP
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <string_view>
 #include <vector>
 
+#include "cuid2/utils.hpp"
+
 namespace visus::cuid2 {
     /// System fingerprint singleton for CUID2 generation.
     ///
-    /// This class uses C++17 inline static variable for singleton implementation
-    /// with a cached fingerprint value computed once during initialization. The
-    /// fingerprint combines hostname, process ID (little-endian), and sorted
-    /// environment variables to create a unique identifier for the system/process.
+    /// This class uses a function-local static for singleton implementation, and
+    /// the fingerprint is computed on first use rather than during static
+    /// initialization of the library; threads racing on first use may each
+    /// compute it, and one result is kept. The fingerprint combines hostname, process
+    /// ID (little-endian), and sorted environment variables to create a unique
+    /// identifier for the system/process. When a node identifier is set, through
+    /// set_node_id() or the CUID2_NODE_ID environment variable, it replaces the
+    /// hostname and environment, which are then never read.
+    ///
+    /// When the process generation changes (in the child after fork(), or
+    /// after reseed()), the next access publishes a new version with the
+    /// current process ID patched in and a fresh digest. The hostname and
+    /// environment bytes are reused rather than scanned again. Versions are
+    /// immutable and kept until the singleton is destroyed, so references
+    /// returned earlier stay valid.
     class Fingerprint {
-        /// Singleton instance with thread-safe initialization.
-        ///
-        /// @note Defined outside class after type is complete
-        static Fingerprint instance;
+        /// Fingerprint bytes and digest for one process generation.
+        struct Version {
+            /// Concatenated fingerprint data.
+            std::vector<uint8_t> bytes{};
+
+            /// SHA3-512 digest of bytes.
+            utils::Digest digest{};
+
+            /// Offset of the four process ID bytes, which follow the hostname
+            /// or node identifier.
+            std::size_t pid_offset = 0;
+
+            /// Process generation the version was built for.
+            uint64_t generation = 0;
+
+            /// Version this one replaced, or nullptr for the first.
+            const Version* previous = nullptr;
+        };
 
         /// Generates the system fingerprint byte sequence.
         ///
+        /// @param pid_offset Receives the offset of the process ID bytes
         /// @return A byte vector containing the concatenated fingerprint data
-        static std::vector<uint8_t> generate();
+        static std::vector<uint8_t> generate(std::size_t& pid_offset);
 
-        /// Cached fingerprint byte sequence, computed once during construction.
-        std::vector<uint8_t> cached_value_{generate()};
+        /// Builds the fingerprint for an explicit node identifier.
+        ///
+        /// @param NODE_ID Node identifier bytes
+        /// @param pid_offset Receives the offset of the process ID bytes
+        /// @return NODE_ID followed by the process ID
+        static std::vector<uint8_t> generate(std::string_view NODE_ID, std::size_t& pid_offset);
+
+        /// Builds a version for GENERATION from fresh fingerprint bytes.
+        ///
+        /// @param bytes Fingerprint data
+        /// @param PID_OFFSET Offset of the process ID bytes within bytes
+        /// @param GENERATION Process generation the bytes were built for
+        static std::unique_ptr<Version> make_version(std::vector<uint8_t> bytes, std::size_t PID_OFFSET,
+                                                     uint64_t GENERATION);
+
+        /// Most recently published version, or nullptr before first use.
+        std::atomic<const Version*> current_{nullptr};
 
-        /// Private constructor, computes and caches the fingerprint.
         Fingerprint() = default;
 
+        /// Releases every published version.
+        ~Fingerprint();
+
+        /// Returns the singleton instance, constructing it on first use.
+        static Fingerprint& instance();
+
+        /// Returns the version for the current process generation.
+        const Version& current();
+
+        /// Publishes a version for GENERATION derived from LATEST.
+        ///
+        /// @param latest Most recent version seen by the caller, or nullptr
+        /// @param GENERATION Process generation to build for
+        /// @return The published version for GENERATION or a newer one
+        const Version& refresh(const Version* latest, uint64_t GENERATION);
+
     public:
-        /// Returns the cached system fingerprint.
+        Fingerprint(const Fingerprint&) = delete;
+        Fingerprint& operator=(const Fingerprint&) = delete;
+
+        /// Returns the cached system fingerprint, computing it on first use.
         ///
         /// @return Const reference to the fingerprint byte vector
         /// @note Thread-safe: Can be called concurrently from multiple threads
         [[nodiscard]] static const std::vector<uint8_t>& get();
-    };
 
-    /// Inline static definition of singleton instance.
-    /// Must be defined after the class is complete.
-    inline Fingerprint Fingerprint::instance{};
+        /// Returns the SHA3-512 digest of the system fingerprint.
+        ///
+        /// Identifiers hash this fixed 64-byte digest rather than the raw
+        /// fingerprint bytes, which can be several kilobytes in large
+        /// environments.
+        ///
+        /// @return Const reference to the 64-byte fingerprint digest
+        /// @note Thread-safe: Can be called concurrently from multiple threads
+        [[nodiscard]] static const utils::Digest& digest();
+
+        /// Replaces the hostname and environment with a node identifier.
+        ///
+        /// @param NODE_ID Node identifier, or empty to restore the default
+        /// @note Thread-safe: Can be called concurrently from multiple threads
+        static void set_node_id(std::string_view NODE_ID);
+    };
 } // namespace visus::cuid2
 
 #endif // LIBCUID2_FINGERPRINT_HPP
\ No newline at end of file
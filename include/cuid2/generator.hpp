@@ -0,0 +1,322 @@
+/// @file generator.hpp
+/// @brief Reusable CUID2 generator with explicit per-instance state
+///
+/// Provides a generator object that owns everything needed to mint identifiers
+/// (counter, fingerprint bytes, digest context and entropy source), so that
+/// each worker can hold its own instance without touching shared state. The
+/// free functions in cuid2.hpp are thin wrappers over a per-thread default
+/// instance.
+///
+/// Example usage:
+/// @code
+///   #include <cuid2/generator.hpp>
+///
+///   visus::cuid2::Generator generator({.length = 16});
+///
+///   std::string id = generator.next();
+///
+///   std::vector<std::string> ids(1000);
+///   generator.next_batch(ids);
+/// @endcode
+
+#ifndef LIBCUID2_GENERATOR_HPP
+#define LIBCUID2_GENERATOR_HPP
+
+#include <cuid2/cuid2_export.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "cuid2/cuid2.hpp"
+#include "cuid2/hash.hpp"
+#include "cuid2/id.hpp"
+
+namespace visus::cuid2 {
+    namespace detail {
+        struct FixedAccess;
+    } // namespace detail
+
+    /// Callback that fills a buffer with random bytes.
+    ///
+    /// Must fill every byte of the span. Bytes should come from a
+    /// cryptographically secure source unless identifiers are only used for
+    /// testing or replay.
+    using EntropyCallback = std::function<void(std::span<uint8_t>)>;
+
+    /// Leading characters of a sortable identifier that encode its creation
+    /// time: one letter followed by eight base-36 digits, together counting
+    /// milliseconds since the Unix epoch.
+    constexpr int SORTABLE_TIME_LENGTH = 9;
+
+    /// Shortest sortable identifier, leaving at least seven hashed characters
+    /// (about 36 bits) after the time.
+    constexpr int MIN_SORTABLE_LENGTH = 16;
+
+    /// How a Generator reads the timestamp hashed into each identifier.
+    ///
+    /// Each strategy takes one reading per next() call and one per
+    /// next_batch() call, shared by every identifier of the batch; the
+    /// strategies differ in what a reading costs. The timestamp feeds the hash
+    /// and leads sortable identifiers; uniqueness rests on the counter and
+    /// random bytes, so a coarser timestamp never causes collisions.
+    enum class TimestampSource : uint8_t {
+        /// Query the precise system clock on every reading.
+        precise,
+
+        /// Query the operating system's coarse real-time clock on every
+        /// reading, which stays cheap where the precise clock needs a system
+        /// call; its resolution is the scheduler tick. Same as precise where
+        /// unavailable.
+        coarse,
+
+        /// Query the precise clock on one reading and reuse the value for the
+        /// next timestamp_refresh - 1 readings, that is, next() calls or whole
+        /// next_batch() calls. A generator left idle keeps its last reading, so
+        /// use this only for tight generation loops.
+        cached,
+    };
+
+    /// Construction options for Generator.
+    struct GeneratorOptions {
+        /// Identifier length used by next() and next_batch() (min: 4, max: 32).
+        int length = DEFAULT_LENGTH;
+
+        /// Custom fingerprint bytes; the system fingerprint is used if unset.
+        /// Only the SHA3-512 digest of these bytes is kept and hashed per ID.
+        std::optional<std::vector<uint8_t>> fingerprint{};
+
+        /// Custom entropy source; the platform CSPRNG is used if empty.
+        EntropyCallback entropy{};
+
+        /// Draw counter values from the process-wide Counter instead of a
+        /// counter owned by the generator.
+        bool shared_counter = false;
+
+        /// Clock read for each next() or next_batch() call.
+        TimestampSource timestamp = TimestampSource::precise;
+
+        /// next() or next_batch() calls sharing one clock reading when
+        /// timestamp is TimestampSource::cached (min: 1).
+        std::uint32_t timestamp_refresh = 64;
+
+        /// Lead every identifier with its creation time instead of a random
+        /// letter, so identifiers sort by time and database inserts append to
+        /// the end of a B-tree index (min length: MIN_SORTABLE_LENGTH).
+        bool sortable = false;
+    };
+
+    /// CUID2 generator with its own counter, fingerprint, hash context and
+    /// entropy source.
+    ///
+    /// Produces identifiers with the same construction as generate(). Unless
+    /// shared_counter is set, the counter is private to the instance and seeded
+    /// from the entropy source, so a generator never touches a cache line shared
+    /// with other threads. Uniqueness between instances rests on the random
+    /// counter seed and per-identifier entropy, exactly as it does between
+    /// processes. An instance-owned counter is seeded again on first use in a
+    /// new process generation, so a generator inherited across fork() does not
+    /// repeat its parent's sequence.
+    ///
+    /// A generator is not thread-safe; give each thread its own instance.
+    class CUID2_API Generator {
+        /// Default identifier length, validated at construction.
+        std::size_t length_;
+
+        /// Digest of the custom fingerprint, or empty to use the system fingerprint.
+        std::optional<utils::Digest> fingerprint_;
+
+        /// Custom entropy source, or empty to use the platform CSPRNG.
+        EntropyCallback entropy_;
+
+        /// Whether counter values come from the process-wide Counter.
+        bool shared_counter_;
+
+        /// Next value of the instance-owned counter (unused if shared).
+        uint64_t counter_ = 0;
+
+        /// Process generation the instance-owned counter was seeded in.
+        uint64_t generation_ = 0;
+
+        /// Clock read for each next() or next_batch() call.
+        TimestampSource timestamp_;
+
+        /// Readings reused per clock read in TimestampSource::cached mode.
+        std::uint32_t timestamp_refresh_;
+
+        /// Readings left before the cached timestamp is refreshed.
+        std::uint32_t timestamp_remaining_ = 0;
+
+        /// Last precise clock reading in TimestampSource::cached mode.
+        int64_t cached_timestamp_ = 0;
+
+        /// Whether identifiers lead with their creation time.
+        bool sortable_;
+
+        /// Digest context reused for every identifier.
+        HashContext hash_;
+
+        /// Lets generate<N>() reach write_fixed() on the default generator.
+        friend struct detail::FixedAccess;
+
+    public:
+        /// Creates a generator with default options.
+        ///
+        /// @throws std::runtime_error if the digest context cannot be created
+        Generator();
+
+        /// Creates a generator with the given options.
+        ///
+        /// @param options Length, fingerprint, entropy, counter, timestamp and
+        ///        layout configuration
+        /// @throws std::invalid_argument if options.length is outside valid range [4, 32]
+        ///         (or below MIN_SORTABLE_LENGTH when sortable), or
+        ///         options.timestamp_refresh is 0
+        /// @throws std::runtime_error if the digest context cannot be created
+        explicit Generator(GeneratorOptions options);
+
+        /// Releases the digest context.
+        ~Generator();
+
+        Generator(const Generator&) = delete;
+        Generator& operator=(const Generator&) = delete;
+
+        /// Transfers the generator state.
+        ///
+        /// @param other Generator to move from; must not be used afterwards
+        Generator(Generator&& other) noexcept;
+
+        /// Transfers the generator state.
+        ///
+        /// @param other Generator to move from; must not be used afterwards
+        /// @return Reference to this generator
+        Generator& operator=(Generator&& other) noexcept;
+
+        /// Generates an identifier of the configured length.
+        ///
+        /// @return A CUID2 identifier string of the configured length
+        [[nodiscard]] std::string next();
+
+        /// Generates an identifier of the configured length whose storage
+        /// comes from a memory resource.
+        ///
+        /// @param resource Resource for the string's storage, such as a
+        ///        per-request std::pmr::monotonic_buffer_resource
+        /// @return A CUID2 identifier string of the configured length
+        /// @throws std::invalid_argument if resource is null
+        [[nodiscard]] std::pmr::string next(std::pmr::memory_resource* resource);
+
+        /// Writes an identifier filling the whole of a caller-provided buffer.
+        ///
+        /// @param out Destination buffer; its size is the identifier length (min: 4, max: 32)
+        /// @return Number of characters written (always out.size() in practice)
+        /// @throws std::invalid_argument if out.size() is outside valid range [4, 32]
+        std::size_t next_into(std::span<char> out);
+
+        /// Generates an identifier of the configured length into every element
+        /// of a caller-provided range.
+        ///
+        /// Reads the timestamp once, reserves out.size() counter values at once
+        /// and draws random bytes in bulk.
+        ///
+        /// @param out Range of strings to overwrite with newly generated identifiers
+        void next_batch(std::span<std::string> out);
+
+        /// Generates identifiers of the given length into every element of a
+        /// caller-provided range.
+        ///
+        /// @param out Range of strings to overwrite with newly generated identifiers
+        /// @param MAX_LENGTH Identifier length for this batch (min: 4, max: 32)
+        /// @throws std::invalid_argument if MAX_LENGTH is outside valid range [4, 32]
+        void next_batch(std::span<std::string> out, int MAX_LENGTH);
+
+        /// Generates identifiers of the given length into every element of a
+        /// range of strings allocating from their own memory resources.
+        ///
+        /// @param out Range of strings to overwrite with newly generated identifiers
+        /// @param MAX_LENGTH Identifier length for this batch (min: 4, max: 32)
+        /// @throws std::invalid_argument if MAX_LENGTH is outside valid range [4, 32]
+        void next_batch(std::span<std::pmr::string> out, int MAX_LENGTH);
+
+        /// Writes identifiers of the given length as fixed-width records at a
+        /// fixed stride, without allocating.
+        ///
+        /// Record i occupies bytes [i * STRIDE, i * STRIDE + MAX_LENGTH) of
+        /// column and is filled completely; the bytes between records are left
+        /// untouched and no NUL terminators are written. Otherwise behaves like
+        /// next_batch().
+        ///
+        /// @param column Buffer receiving COUNT records
+        /// @param STRIDE Distance in bytes between consecutive records
+        /// @param COUNT Number of identifiers to write
+        /// @param MAX_LENGTH Identifier length for this batch (min: 4, max: 32, at most STRIDE)
+        /// @throws std::invalid_argument if MAX_LENGTH is outside [4, 32], STRIDE
+        ///         is below MAX_LENGTH or column is too small for COUNT records
+        void next_batch_into(std::span<char> column, std::size_t STRIDE, std::size_t COUNT, int MAX_LENGTH);
+
+        /// Returns the configured identifier length.
+        ///
+        /// @return Length used by next() and next_batch()
+        [[nodiscard]] int length() const noexcept;
+
+        /// Generates an identifier whose length is fixed at compile time.
+        ///
+        /// Ignores the configured length. Skips the run-time length check and
+        /// never allocates.
+        ///
+        /// @tparam N Identifier length (min: 4, max: 32)
+        /// @return A CUID2 identifier of exactly N characters
+        template <int N>
+            requires(N >= MIN_CUID2_LENGTH && N <= MAX_CUID2_LENGTH)
+        [[nodiscard]] id<N> next_id() {
+            std::array<char, static_cast<std::size_t>(N)> chars;
+            write_fixed(chars.data(), N);
+
+            return id<N>(chars);
+        }
+
+    private:
+        /// Seeds the instance-owned counter from the entropy source.
+        void seed_counter();
+
+        /// Returns the counter value for the next identifier.
+        int64_t next_counter();
+
+        /// Reserves COUNT consecutive counter values and returns the first.
+        int64_t reserve_counter(std::size_t COUNT);
+
+        /// Returns the timestamp for the next identifier or batch.
+        int64_t next_timestamp() noexcept;
+
+        /// Fills a buffer from the configured entropy source.
+        void fill_entropy(std::span<uint8_t> out);
+
+        /// Returns the fingerprint digest hashed into every identifier.
+        [[nodiscard]] const utils::Digest& fingerprint() const;
+
+        /// Rejects lengths too short for the sortable layout, if enabled.
+        void validate_layout(std::size_t LENGTH) const;
+
+        /// Writes one identifier of a pre-validated length.
+        std::size_t write_unchecked(char* out, std::size_t LENGTH);
+
+        /// Fills a batch of records with identifiers of a pre-validated length.
+        template <typename Slots>
+        void write_batch_unchecked(Slots slots, std::size_t LENGTH);
+
+        /// Writes exactly LENGTH characters through the pipeline specialized
+        /// for LENGTH; LENGTH must be in [4, 32].
+        void write_fixed(char* out, int LENGTH);
+
+        /// Pipeline for one compile-time length, selected by write_fixed().
+        template <std::size_t LENGTH>
+        void write_fixed(char* out);
+    };
+} // namespace visus::cuid2
+
+#endif // LIBCUID2_GENERATOR_HPP
@@ -0,0 +1,83 @@
+/// @file hash.hpp
+/// @brief Reusable SHA3-512 hashing context for CUID2 generation
+///
+/// Provides a thin RAII wrapper over an OpenSSL digest context bound to an
+/// explicitly fetched NIST FIPS-202 SHA3-512 implementation. Each Generator owns
+/// a context, so the per-identifier hash does not allocate a context or go
+/// through OpenSSL's implicit algorithm fetch.
+
+#ifndef LIBCUID2_HASH_HPP
+#define LIBCUID2_HASH_HPP
+
+#include <cstdint>
+#include <span>
+
+#include "cuid2/utils.hpp"
+
+/// Opaque OpenSSL digest context type (EVP_MD_CTX).
+struct evp_md_ctx_st;
+
+namespace visus::cuid2 {
+    /// Reusable SHA3-512 digest context.
+    ///
+    /// Wraps a single EVP_MD_CTX that is allocated once and re-initialized for
+    /// every hash. The SHA3-512 algorithm is fetched from the OpenSSL provider
+    /// once per process and shared by all contexts, avoiding the provider lookup
+    /// and lock taken by implicit fetches such as EVP_sha3_512() on OpenSSL 3.
+    ///
+    /// A context is not thread-safe; each thread or Generator needs its own.
+    class HashContext {
+        /// Owned OpenSSL digest context.
+        evp_md_ctx_st* ctx_;
+
+    public:
+        /// Allocates a new digest context.
+        ///
+        /// @throws std::runtime_error if OpenSSL cannot allocate the context or
+        ///         provide a SHA3-512 implementation
+        HashContext();
+
+        /// Releases the digest context.
+        ~HashContext();
+
+        HashContext(const HashContext&) = delete;
+        HashContext& operator=(const HashContext&) = delete;
+
+        /// Transfers ownership of the digest context.
+        ///
+        /// @param other Context to move from; left without a digest context
+        HashContext(HashContext&& other) noexcept;
+
+        /// Transfers ownership of the digest context, releasing the current one.
+        ///
+        /// @param other Context to move from; left without a digest context
+        /// @return Reference to this context
+        HashContext& operator=(HashContext&& other) noexcept;
+
+        /// Starts a new SHA3-512 computation, discarding any previous state.
+        ///
+        /// @throws std::runtime_error if the digest cannot be initialized
+        void init();
+
+        /// Absorbs bytes into the current computation.
+        ///
+        /// @param data Bytes to hash
+        /// @throws std::runtime_error if the update fails
+        void update(std::span<const uint8_t> data);
+
+        /// Completes the current computation and returns the digest.
+        ///
+        /// @return 64-byte SHA3-512 digest
+        /// @throws std::runtime_error if finalization fails
+        [[nodiscard]] utils::Digest finalize();
+
+        /// Hashes a single contiguous buffer.
+        ///
+        /// @param data Bytes to hash
+        /// @return 64-byte SHA3-512 digest
+        /// @throws std::runtime_error if OpenSSL reports a failure
+        [[nodiscard]] utils::Digest hash(std::span<const uint8_t> data);
+    };
+} // namespace visus::cuid2
+
+#endif // LIBCUID2_HASH_HPP
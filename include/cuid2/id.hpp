@@ -0,0 +1,133 @@
+/// @file id.hpp
+/// @brief Fixed-length CUID2 identifier value type
+///
+/// Provides id<N>, an identifier stored inline in a std::array<char, N>, and
+/// generate<N>(), which writes it without heap allocation or a run-time length
+/// check. Use this when the identifier length is fixed by a schema.
+///
+/// Example usage:
+/// @code
+///   #include <cuid2/cuid2.hpp>
+///
+///   const visus::cuid2::id<24> ID = visus::cuid2::generate<24>();
+///   std::string_view text = ID;
+/// @endcode
+
+#ifndef LIBCUID2_ID_HPP
+#define LIBCUID2_ID_HPP
+
+#include <cuid2/cuid2_export.hpp>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "cuid2/cuid2.hpp"
+
+namespace visus::cuid2 {
+    /// CUID2 identifier of exactly N characters, stored inline.
+    ///
+    /// A trivially copyable value type that never allocates, compares like
+    /// its string form and converts implicitly to std::string_view. The
+    /// characters are not NUL-terminated.
+    ///
+    /// @tparam N Identifier length (min: 4, max: 32)
+    template <int N>
+        requires(N >= MIN_CUID2_LENGTH && N <= MAX_CUID2_LENGTH)
+    class id {
+        std::array<char, static_cast<std::size_t>(N)> chars_{};
+
+    public:
+        /// Identifier length in characters.
+        static constexpr std::size_t LENGTH = static_cast<std::size_t>(N);
+
+        /// Creates a placeholder holding N NUL characters.
+        constexpr id() noexcept = default;
+
+        /// Wraps existing characters without validating them.
+        ///
+        /// @param chars Identifier characters
+        constexpr explicit id(const std::array<char, LENGTH>& chars) noexcept : chars_(chars) {}
+
+        /// Returns a pointer to the first of N characters (not NUL-terminated).
+        [[nodiscard]] constexpr const char* data() const noexcept {
+            return chars_.data();
+        }
+
+        /// Returns the identifier length.
+        [[nodiscard]] static constexpr std::size_t size() noexcept {
+            return LENGTH;
+        }
+
+        /// Returns the underlying characters.
+        [[nodiscard]] constexpr const std::array<char, LENGTH>& chars() const noexcept {
+            return chars_;
+        }
+
+        [[nodiscard]] constexpr auto begin() const noexcept {
+            return chars_.begin();
+        }
+
+        [[nodiscard]] constexpr auto end() const noexcept {
+            return chars_.end();
+        }
+
+        /// Returns a view of the identifier characters.
+        [[nodiscard]] constexpr std::string_view view() const noexcept {
+            return {chars_.data(), LENGTH};
+        }
+
+        /// Returns a view of the identifier characters.
+        constexpr operator std::string_view() const noexcept {
+            return view();
+        }
+
+        /// Copies the identifier into a std::string.
+        [[nodiscard]] std::string str() const {
+            return std::string(view());
+        }
+
+        friend constexpr bool operator==(const id&, const id&) noexcept = default;
+        friend constexpr auto operator<=>(const id&, const id&) noexcept = default;
+    };
+
+    namespace detail {
+        /// Writes exactly LENGTH characters using the calling thread's default
+        /// generator. Backs generate<N>(); LENGTH is not validated.
+        ///
+        /// @param out Destination for LENGTH characters
+        /// @param LENGTH Identifier length, already known to be in [4, 32]
+        CUID2_API void generate_fixed(char* out, int LENGTH);
+    } // namespace detail
+
+    /// Generates a CUID2 identifier whose length is fixed at compile time.
+    ///
+    /// Produces the same identifiers as generate(N) but skips the run-time
+    /// length check and the std::string allocation. The library uses a
+    /// pipeline specialized for N, so the entropy and encoding buffers are
+    /// sized exactly and the encoder produces exactly N - 1 digits.
+    ///
+    /// @tparam N Identifier length (min: 4, max: 32)
+    /// @return A CUID2 identifier of exactly N characters
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    template <int N>
+        requires(N >= MIN_CUID2_LENGTH && N <= MAX_CUID2_LENGTH)
+    [[nodiscard]] id<N> generate() {
+        std::array<char, static_cast<std::size_t>(N)> chars;
+        detail::generate_fixed(chars.data(), N);
+
+        return id<N>(chars);
+    }
+} // namespace visus::cuid2
+
+/// Hashes an identifier like its string form.
+template <int N>
+struct std::hash<visus::cuid2::id<N>> {
+    std::size_t operator()(const visus::cuid2::id<N>& value) const noexcept {
+        return std::hash<std::string_view>{}(value.view());
+    }
+};
+
+#endif // LIBCUID2_ID_HPP
@@ -0,0 +1,132 @@
+/// @file identifier.hpp
+/// @brief Compact binary CUID2 value type
+///
+/// Provides Cuid2, a 24-byte packed representation of any CUID2 identifier of
+/// up to MAX_CUID2_LENGTH characters, for use as a key in large in-memory
+/// indexes and hash maps. Each character is stored as a 6-bit code, most
+/// significant first, with 0 marking unused positions, so comparing the packed
+/// words orders values exactly like their strings.
+///
+/// Example usage:
+/// @code
+///   #include <cuid2/identifier.hpp>
+///
+///   const auto KEY = visus::cuid2::Cuid2::parse(visus::cuid2::generate());
+///
+///   std::unordered_map<visus::cuid2::Cuid2, Row> index;
+///   index.emplace(KEY, row);
+///
+///   std::string text = KEY.str();
+/// @endcode
+
+#ifndef LIBCUID2_IDENTIFIER_HPP
+#define LIBCUID2_IDENTIFIER_HPP
+
+#include <cuid2/cuid2_export.hpp>
+#include <array>
+#include <charconv>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "cuid2/cuid2.hpp"
+
+namespace visus::cuid2 {
+    /// CUID2 identifier packed into three 64-bit words.
+    ///
+    /// Trivially copyable and 24 bytes regardless of length. Equality, ordering
+    /// and hashing work on the packed words and agree with the identifier
+    /// text. A default-constructed value is empty and orders before every
+    /// identifier.
+    class CUID2_API Cuid2 {
+    public:
+        /// Number of 64-bit words in the packed form.
+        static constexpr std::size_t LIMB_COUNT = 3;
+
+        /// Packed words, most significant first.
+        using Limbs = std::array<uint64_t, LIMB_COUNT>;
+
+    private:
+        Limbs limbs_{};
+
+        constexpr explicit Cuid2(const Limbs& LIMBS) noexcept : limbs_(LIMBS) {}
+
+    public:
+        /// Creates an empty value.
+        constexpr Cuid2() noexcept = default;
+
+        /// Parses identifier text.
+        ///
+        /// @param TEXT Identifier: a lowercase letter followed by lowercase
+        ///             base-36 digits, 4 to 32 characters in total
+        /// @return The packed identifier
+        /// @throws std::invalid_argument if TEXT is not a valid CUID2
+        [[nodiscard]] static Cuid2 parse(std::string_view TEXT);
+
+        /// Parses identifier text without throwing.
+        ///
+        /// @param TEXT Identifier text
+        /// @return The packed identifier, or empty if TEXT is not a valid CUID2
+        [[nodiscard]] static std::optional<Cuid2> try_parse(std::string_view TEXT) noexcept;
+
+        /// Reconstructs a value from words previously returned by limbs().
+        ///
+        /// @param LIMBS Packed words
+        /// @return The packed identifier
+        /// @throws std::invalid_argument if LIMBS do not encode a valid CUID2
+        [[nodiscard]] static Cuid2 from_limbs(const Limbs& LIMBS);
+
+        /// Returns the packed words, e.g. for binary serialization.
+        [[nodiscard]] constexpr const Limbs& limbs() const noexcept {
+            return limbs_;
+        }
+
+        /// Returns the identifier length in characters (0 if empty).
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        /// Returns true for a default-constructed value.
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return limbs_[0] == 0;
+        }
+
+        /// Writes the identifier text into [first, last).
+        ///
+        /// Follows std::to_chars: on success ptr points past the last
+        /// character written; if the range is too small, ec is
+        /// std::errc::value_too_large and nothing is written.
+        ///
+        /// @param first Start of the destination range
+        /// @param last End of the destination range
+        /// @return End of the written text and an error code
+        std::to_chars_result to_chars(char* first, char* last) const noexcept;
+
+        /// Returns the identifier text.
+        [[nodiscard]] std::string str() const;
+
+        friend constexpr bool operator==(const Cuid2&, const Cuid2&) noexcept = default;
+        friend constexpr std::strong_ordering operator<=>(const Cuid2&, const Cuid2&) noexcept = default;
+    };
+} // namespace visus::cuid2
+
+/// Hashes the packed words; equal identifiers hash equally.
+template <>
+struct std::hash<visus::cuid2::Cuid2> {
+    std::size_t operator()(const visus::cuid2::Cuid2& value) const noexcept {
+        // Identifier bits are already uniformly distributed, so a multiply-xor
+        // fold of the words is enough
+        uint64_t result = 0;
+
+        for (const uint64_t LIMB : value.limbs()) {
+            result = (result ^ LIMB) * 0x9E3779B97F4A7C15ULL;
+            result ^= result >> 32;
+        }
+
+        return static_cast<std::size_t>(result);
+    }
+};
+
+#endif // LIBCUID2_IDENTIFIER_HPP
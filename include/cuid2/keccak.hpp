@@ -0,0 +1,89 @@
+/// @file keccak.hpp
+/// @brief Multi-buffer SHA3-512 for batch CUID2 generation
+///
+/// Provides an internal Keccak-f[1600] implementation that hashes several
+/// independent, equal-length messages at once using SIMD lanes: four with
+/// AVX2, eight with AVX-512F and two with NEON. The widest backend supported by
+/// the running CPU is selected at runtime. The output is identical to
+/// OpenSSL's SHA3-512; the scalar backend exists for verification and for CPUs
+/// without a SIMD path.
+///
+/// Only built when the ENABLE_SIMD_KECCAK CMake option is set.
+
+#ifndef LIBCUID2_KECCAK_HPP
+#define LIBCUID2_KECCAK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "cuid2/utils.hpp"
+
+namespace visus::cuid2::keccak {
+    /// Keccak implementation used for multi-buffer hashing.
+    enum class Backend {
+        /// Portable one-state-at-a-time implementation.
+        scalar,
+
+        /// Four states per 256-bit vector (x86-64 with AVX2).
+        avx2,
+
+        /// Eight states per 512-bit vector (x86-64 with AVX-512F).
+        avx512,
+
+        /// Two states per 128-bit vector (AArch64).
+        neon,
+    };
+
+    /// Largest number of messages any backend hashes at once.
+    constexpr size_t MAX_LANES = 8;
+
+    /// Returns the widest backend supported by the compiler and running CPU.
+    ///
+    /// The CPU is queried once; later calls return the cached result.
+    ///
+    /// @return Preferred backend for this process
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    [[nodiscard]] Backend detect_backend() noexcept;
+
+    /// Reports whether a backend can run on this build and CPU.
+    ///
+    /// @param BACKEND Backend to check
+    /// @return true if sha3_512_strided() may be called with BACKEND
+    [[nodiscard]] bool is_supported(Backend BACKEND) noexcept;
+
+    /// Returns the number of messages a backend hashes per permutation call.
+    ///
+    /// @param BACKEND Backend to query
+    /// @return 1, 2, 4 or 8
+    [[nodiscard]] size_t lane_count(Backend BACKEND) noexcept;
+
+    /// Returns a short human-readable backend name ("scalar", "avx2", ...).
+    ///
+    /// @param BACKEND Backend to name
+    /// @return Name with static storage duration
+    [[nodiscard]] std::string_view backend_name(Backend BACKEND) noexcept;
+
+    /// Computes SHA3-512 of many equal-length messages laid out at a fixed stride.
+    ///
+    /// Message i occupies bytes [i * STRIDE, i * STRIDE + LENGTH) of messages
+    /// and its digest is written to digests[i]. Full groups of lane_count()
+    /// messages go through the SIMD kernel; any remainder is hashed with the
+    /// scalar kernel.
+    ///
+    /// @param messages Buffer holding digests.size() messages
+    /// @param STRIDE Distance in bytes between consecutive messages
+    /// @param LENGTH Length of every message in bytes (at most STRIDE)
+    /// @param digests Output digests, one per message
+    /// @param BACKEND Backend to use; must satisfy is_supported()
+    /// @throws std::invalid_argument if the buffer is too small or BACKEND is unsupported
+    void sha3_512_strided(
+        std::span<const uint8_t> messages,
+        size_t STRIDE,
+        size_t LENGTH,
+        std::span<utils::Digest> digests,
+        Backend BACKEND = detect_backend());
+} // namespace visus::cuid2::keccak
+
+#endif // LIBCUID2_KECCAK_HPP
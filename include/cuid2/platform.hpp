@@ -8,26 +8,163 @@
 #ifndef LIBCUID2_PLATFORM_HPP
 #define LIBCUID2_PLATFORM_HPP
 
+#include <cuid2/cuid2_export.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <map>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace visus::cuid2::platform {
+    /// Source of the random bytes consumed by identifier generation.
+    ///
+    /// Each thread owns the instance it draws from, so implementations need
+    /// not be thread-safe. A thread's instance is replaced when a different
+    /// source is selected and in every new process generation (after fork()
+    /// or reseed()), so state such as a DRBG key is never shared between a
+    /// parent and its child.
+    class CUID2_API EntropySource {
+    public:
+        virtual ~EntropySource() = default;
+
+        /// Fills a buffer with random bytes.
+        ///
+        /// @param out Buffer to fill completely
+        /// @throws std::runtime_error if the bytes cannot be produced
+        virtual void fill(std::span<uint8_t> out) = 0;
+
+        /// Returns a short human-readable name of the source.
+        ///
+        /// @return Name with static storage duration
+        [[nodiscard]] virtual std::string_view name() const noexcept = 0;
+    };
+
+    /// Built-in entropy sources.
+    enum class EntropyBackend : uint8_t {
+        /// OpenSSL RAND_bytes(); the default.
+        openssl,
+
+        /// Operating system CSPRNG: getrandom() on Linux, arc4random_buf() on
+        /// macOS and the BSDs, BCryptGenRandom() on Windows.
+        system,
+
+        /// Userspace ChaCha20 keystream, keyed from RAND_bytes().
+        chacha20,
+
+        /// Userspace AES-256-CTR keystream, keyed from RAND_bytes(); fastest
+        /// on CPUs with AES instructions.
+        aes_ctr,
+    };
+
+    /// Creates a thread's entropy source; called once per thread and again
+    /// whenever the thread's source has to be replaced.
+    using EntropyFactory = std::function<std::unique_ptr<EntropySource>()>;
+
+    /// Seed size in bytes of make_seeded_entropy_source().
+    constexpr std::size_t ENTROPY_SEED_SIZE = 32;
+
+    /// Bytes a ChaCha20 or AES-CTR source produces before drawing a new key.
+    constexpr std::size_t ENTROPY_RESEED_INTERVAL = std::size_t{1} << 20;
+
+    /// Creates a built-in entropy source.
+    ///
+    /// The ChaCha20 and AES-CTR sources are deterministic random bit
+    /// generators: each request is served from the cipher keystream, after
+    /// which the key is replaced with further keystream so earlier output
+    /// cannot be recovered from the state. Every ENTROPY_RESEED_INTERVAL bytes
+    /// a fresh key is drawn from RAND_bytes().
+    ///
+    /// @param BACKEND Source to create
+    /// @return New source
+    /// @throws std::runtime_error if the source cannot be initialized
+    [[nodiscard]] CUID2_API std::unique_ptr<EntropySource> make_entropy_source(EntropyBackend BACKEND);
+
+    /// Creates a ChaCha20 or AES-CTR source with a fixed key that is never
+    /// reseeded, so the same seed and sequence of requests always produce
+    /// the same bytes. Intended for replaying load tests; such a source is
+    /// not suitable for production identifiers.
+    ///
+    /// @param BACKEND EntropyBackend::chacha20 or EntropyBackend::aes_ctr
+    /// @param seed ENTROPY_SEED_SIZE bytes of key material
+    /// @return New deterministic source
+    /// @throws std::invalid_argument if BACKEND is not a DRBG or seed has the wrong size
+    /// @throws std::runtime_error if the source cannot be initialized
+    [[nodiscard]] CUID2_API std::unique_ptr<EntropySource> make_seeded_entropy_source(
+        EntropyBackend BACKEND, std::span<const uint8_t> seed);
+
+    /// Selects a built-in source for all threads.
+    ///
+    /// Each thread switches on its next request; bytes already buffered for
+    /// the thread from the previous source are discarded.
+    ///
+    /// @param BACKEND Source to use from now on
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    CUID2_API void set_entropy_source(EntropyBackend BACKEND);
+
+    /// Selects a custom source for all threads.
+    ///
+    /// The factory is called on each thread that needs a new source, so it
+    /// must be thread-safe; a deterministic harness can seed each thread from
+    /// its own stream here. It must not return a null pointer.
+    ///
+    /// @param factory Function creating one source, or empty for the default
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    CUID2_API void set_entropy_source(EntropyFactory factory);
+
+    /// Returns the name of the source the calling thread draws from.
+    ///
+    /// @return Name reported by the thread's EntropySource
+    /// @throws std::runtime_error if the source cannot be created
+    [[nodiscard]] CUID2_API std::string entropy_source_name();
+
     /// Fills a buffer with cryptographically secure random bytes.
     ///
-    /// Uses OpenSSL's RAND_bytes() CSPRNG for cryptographic-quality randomness.
+    /// Bytes come from the selected EntropySource, OpenSSL's RAND_bytes() by
+    /// default. Small requests are served from a per-thread buffer refilled
+    /// in bulk (size set by CUID2_RANDOM_POOL_SIZE); the buffer is wiped as it
+    /// is consumed and discarded when the process generation or the selected
+    /// source changes.
     ///
     /// @param buf Pointer to buffer to fill with random bytes
     /// @param LEN Number of random bytes to generate
+    /// @throws std::runtime_error if the entropy source fails
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    void get_random_bytes(unsigned char *buf, size_t LEN);
+
+    /// Returns the size of the per-thread random buffer in bytes.
+    ///
+    /// @return CUID2_RANDOM_POOL_SIZE, or 0 if every request goes to the source
+    [[nodiscard]] size_t random_pool_size() noexcept;
+
+    /// Returns the current process generation.
+    ///
+    /// The generation starts at 0 and is incremented in the child after every
+    /// fork() and by start_new_generation(). State derived from the process,
+    /// such as the fingerprint, counters and random buffers, records the
+    /// generation it was built under and refreshes itself on first use in a
+    /// newer one.
+    ///
+    /// @return Current generation
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    [[nodiscard]] uint64_t process_generation() noexcept;
+
+    /// Starts a new process generation in the calling process, as fork() does
+    /// in the child. Backs cuid2::reseed().
+    ///
     /// @note Thread-safe: Can be called concurrently from multiple threads
-    void get_random_bytes(unsigned char *buf, size_t LEN) noexcept;
+    void start_new_generation() noexcept;
 
     /// Generates a cryptographically secure random 64-bit integer.
     ///
     /// @return A cryptographically random int64_t value
+    /// @throws std::runtime_error if the entropy source fails
     /// @note Thread-safe: Can be called concurrently from multiple threads
-    [[nodiscard]] int64_t get_random_int64() noexcept;
+    [[nodiscard]] int64_t get_random_int64();
 
     /// Retrieves the system hostname.
     ///
@@ -50,6 +187,30 @@ namespace visus::cuid2::platform {
     /// @note Thread-safe: Process ID is constant for the lifetime of the process
     [[nodiscard]] int get_process_id() noexcept;
 
+    /// Returns the NUMA node of the CPU the calling thread is running on.
+    ///
+    /// Platform-specific implementation:
+    /// - Linux: Uses the getcpu system call, which works on glibc before 2.29
+    /// - Windows: Uses GetNumaProcessorNodeEx() on the current processor
+    /// - Others: Always 0
+    ///
+    /// The thread may migrate at any time, so the result is a placement
+    /// hint rather than a guarantee.
+    ///
+    /// @return NUMA node number, or 0 if it cannot be determined
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    [[nodiscard]] unsigned get_numa_node() noexcept;
+
+    /// Reads a single environment variable.
+    ///
+    /// Platform-specific implementation:
+    /// - Windows: Uses _wgetenv() with UTF-16 to UTF-8 conversion
+    /// - POSIX: Uses std::getenv()
+    ///
+    /// @param NAME Variable name
+    /// @return The value, or std::nullopt if the variable is not set
+    [[nodiscard]] std::optional<std::string> get_environment_variable(const char* NAME);
+
     /// Retrieves all environment variables as key-value pairs.
     ///
     /// Platform-specific implementation:
@@ -60,6 +221,18 @@ namespace visus::cuid2::platform {
     /// @note The map is sorted for deterministic fingerprint generation
     [[nodiscard]] std::map<std::string, std::string, std::less<>> get_environment_variables();
 
+    /// Appends all environment variables to a byte buffer as concatenated
+    /// "KEY=VALUE" entries, sorted by key.
+    ///
+    /// Produces exactly the bytes obtained by concatenating the entries of
+    /// get_environment_variables() in order (including keeping only the first
+    /// of any duplicated keys), but without building a map or per-entry strings
+    /// on POSIX: entries are sorted by pointer and copied straight from
+    /// `environ` into the buffer, which is grown once.
+    ///
+    /// @param out Buffer to append the serialized environment to
+    void append_environment(std::vector<uint8_t>& out);
+
 }
 
 #endif //LIBCUID2_PLATFORM_HPP
@@ -0,0 +1,182 @@
+/// @file pool.hpp
+/// @brief Pre-generated CUID2 identifiers served from a lock-free ring
+///
+/// Provides a pool that keeps identifiers ready in a bounded ring buffer,
+/// refilled in batches by a background thread, so that a request handler
+/// taking an identifier pays for a copy rather than for SHA3-512 and base-36
+/// encoding. When the ring runs dry the identifier is generated inline.
+///
+/// Example usage:
+/// @code
+///   #include <cuid2/pool.hpp>
+///
+///   visus::cuid2::Pool pool({.length = 24, .capacity = 8192});
+///
+///   std::string id = pool.acquire();
+///
+///   std::array<char, 24> buffer{};
+///   pool.acquire_into(buffer);
+///
+///   const auto STATS = pool.stats();
+///   metrics.gauge("cuid2.pool.hit_rate", STATS.hit_rate());
+/// @endcode
+
+#ifndef LIBCUID2_POOL_HPP
+#define LIBCUID2_POOL_HPP
+
+#include <cuid2/cuid2_export.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+#include "cuid2/cuid2.hpp"
+
+namespace visus::cuid2 {
+    /// Construction options for Pool.
+    struct PoolOptions {
+        /// Identifier length (min: 4, max: 32).
+        int length = DEFAULT_LENGTH;
+
+        /// Number of identifiers the ring holds; rounded up to a power of two.
+        std::size_t capacity = 4096;
+
+        /// The refill thread is woken when at most this many identifiers are
+        /// left; 0 selects a quarter of the capacity.
+        std::size_t low_watermark = 0;
+
+        /// The refill thread stops once this many identifiers are ready; 0
+        /// selects the full capacity.
+        std::size_t high_watermark = 0;
+
+        /// Identifiers generated per batch by the refill thread.
+        std::size_t refill_batch = 256;
+    };
+
+    /// Counters describing how well a Pool keeps up with demand.
+    struct PoolStats {
+        /// Identifiers served from the ring.
+        uint64_t hits = 0;
+
+        /// Identifiers generated inline because the ring was empty.
+        uint64_t misses = 0;
+
+        /// Pre-generated identifiers dropped because they were produced
+        /// before a fork() or reseed().
+        uint64_t discarded = 0;
+
+        /// Completed refills, each from a low-watermark wake-up to the high
+        /// watermark.
+        uint64_t refills = 0;
+
+        /// Identifiers currently ready.
+        std::size_t available = 0;
+
+        /// Time from the most recent wake-up request until its refill completed.
+        std::chrono::nanoseconds last_refill_lag{};
+
+        /// Longest refill lag seen.
+        std::chrono::nanoseconds max_refill_lag{};
+
+        /// Sum of all refill lags, for averaging over refills.
+        std::chrono::nanoseconds total_refill_lag{};
+
+        /// Returns the fraction of identifiers served from the ring.
+        ///
+        /// @return hits / (hits + misses), or 1 before the first acquire
+        [[nodiscard]] double hit_rate() const noexcept {
+            const uint64_t TOTAL = hits + misses;
+
+            return TOTAL == 0 ? 1.0 : static_cast<double>(hits) / static_cast<double>(TOTAL);
+        }
+    };
+
+    /// Bounded pool of pre-generated identifiers with a background refill thread.
+    ///
+    /// The ring is a multi-producer multi-consumer queue of fixed-size slots
+    /// with per-slot sequence numbers. acquire() is lock-free: in the common
+    /// case it is one compare-and-swap on the read position and a copy of at
+    /// most 32 characters, and it never waits for the refill thread. When the
+    /// number of ready identifiers drops to the low watermark, the first
+    /// caller to notice wakes the refill thread through an atomic wait, which
+    /// then generates batches until the high watermark is reached.
+    ///
+    /// Identifiers carry the timestamp of the moment they were generated, so
+    /// pooled identifiers may be up to one refill older than the request that
+    /// takes them. Identifiers generated before a fork() or reseed() are
+    /// never handed out: in a child the ring is drained and every identifier
+    /// is generated inline, since the refill thread does not survive fork().
+    ///
+    /// The constructor fills the ring to the high watermark before returning.
+    ///
+    /// @note Thread-safe: acquire() and stats() can be called concurrently
+    ///       from multiple threads
+    class CUID2_API Pool {
+        struct State;
+
+        /// Ring, counters and refill thread.
+        std::unique_ptr<State> state_;
+
+    public:
+        /// Creates a pool, fills it and starts its refill thread.
+        ///
+        /// @param options Length, capacity, watermarks and batch size
+        /// @throws std::invalid_argument if the length is outside [4, 32],
+        ///         capacity or refill_batch is 0, or the watermarks are not
+        ///         low < high <= capacity
+        /// @throws std::system_error if the refill thread cannot be started
+        explicit Pool(PoolOptions options = {});
+
+        /// Stops and joins the refill thread.
+        ~Pool();
+
+        Pool(const Pool&) = delete;
+        Pool& operator=(const Pool&) = delete;
+        Pool(Pool&&) = delete;
+        Pool& operator=(Pool&&) = delete;
+
+        /// Takes an identifier, generating one inline if the ring is empty.
+        ///
+        /// @return A CUID2 identifier of the configured length
+        [[nodiscard]] std::string acquire();
+
+        /// Takes an identifier into a caller-provided buffer without allocating
+        /// when it comes from the ring.
+        ///
+        /// @param out Destination buffer; must hold at least length() characters
+        /// @return Number of characters written (always length())
+        /// @throws std::invalid_argument if out is shorter than length()
+        std::size_t acquire_into(std::span<char> out);
+
+        /// Takes an identifier only if one is ready, never generating inline.
+        ///
+        /// For callers that must not block on hashing or the entropy source,
+        /// such as an event-loop thread; an empty ring is not counted as a miss.
+        ///
+        /// @param out Destination buffer; must hold at least length() characters
+        /// @return true if length() characters were written
+        /// @throws std::invalid_argument if out is shorter than length()
+        bool try_acquire_into(std::span<char> out);
+
+        /// Returns the configured identifier length.
+        ///
+        /// @return Length of every identifier served
+        [[nodiscard]] int length() const noexcept;
+
+        /// Returns the ring capacity after rounding.
+        ///
+        /// @return Maximum number of identifiers held
+        [[nodiscard]] std::size_t capacity() const noexcept;
+
+        /// Returns the pool counters.
+        ///
+        /// Counters are read individually without stopping other threads.
+        ///
+        /// @return Snapshot of the hit, miss and refill counters
+        [[nodiscard]] PoolStats stats() const noexcept;
+    };
+} // namespace visus::cuid2
+
+#endif // LIBCUID2_POOL_HPP
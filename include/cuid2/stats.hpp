@@ -0,0 +1,112 @@
+/// @file stats.hpp
+/// @brief Opt-in per-stage timing counters for the generation pipeline
+///
+/// When the library is built with ENABLE_INSTRUMENTATION, every identifier
+/// records how many calls and cycles it spent in each pipeline stage. Counters
+/// are kept per thread and merged on demand, so recording never touches a
+/// shared cache line. Without the option, the hooks compile to nothing and the
+/// functions below report zeros.
+///
+/// Example usage:
+/// @code
+///   #include <cuid2/stats.hpp>
+///
+///   const visus::cuid2::Stats SNAPSHOT = visus::cuid2::stats();
+///   const auto& hash = SNAPSHOT[visus::cuid2::Stage::hash];
+///   double cycles_per_hash = double(hash.cycles) / double(hash.calls);
+///
+///   // Export a snapshot every 100000 identifiers per thread
+///   visus::cuid2::set_stats_callback([](const visus::cuid2::Stats& s) { publish(s); }, 100000);
+/// @endcode
+
+#ifndef LIBCUID2_STATS_HPP
+#define LIBCUID2_STATS_HPP
+
+#include <cuid2/cuid2_export.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace visus::cuid2 {
+    /// Pipeline stage timed by the instrumentation.
+    enum class Stage {
+        /// Counter::next() / Counter::reserve(), or the generator-owned counter.
+        counter,
+
+        /// Random bytes from the CSPRNG or a custom entropy callback.
+        random,
+
+        /// SHA3-512 of the identifier's hash input.
+        hash,
+
+        /// Prefix selection and base-36 encoding of the digest.
+        encode,
+    };
+
+    /// Number of values in Stage.
+    constexpr size_t STAGE_COUNT = 4;
+
+    /// Accumulated cost of one stage.
+    struct StageStats {
+        /// Number of times the stage ran (once per batch for counter reservations).
+        uint64_t calls = 0;
+
+        /// Time spent in the stage: TSC cycles on x86-64, virtual timer ticks
+        /// on AArch64, steady_clock nanoseconds elsewhere.
+        uint64_t cycles = 0;
+    };
+
+    /// Snapshot of all stage counters, summed over every thread.
+    struct Stats {
+        /// Per-stage counters, indexed by Stage.
+        std::array<StageStats, STAGE_COUNT> stages{};
+
+        /// Number of identifiers generated.
+        uint64_t identifiers = 0;
+
+        /// Returns the counters of one stage.
+        [[nodiscard]] const StageStats& operator[](const Stage STAGE) const noexcept {
+            return stages[static_cast<size_t>(STAGE)];
+        }
+    };
+
+    /// Callback receiving a process-wide snapshot.
+    using StatsCallback = std::function<void(const Stats&)>;
+
+    /// Reports whether the library was built with ENABLE_INSTRUMENTATION.
+    ///
+    /// @return true if stage counters are being recorded
+    [[nodiscard]] CUID2_API bool instrumentation_enabled() noexcept;
+
+    /// Returns the counters accumulated since start-up or the last reset_stats().
+    ///
+    /// Includes threads that have already exited. Counters of running threads
+    /// are read without stopping them, so a snapshot taken during generation
+    /// may split a single identifier's stages.
+    ///
+    /// @return Snapshot summed over all threads; all zeros when disabled
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    [[nodiscard]] CUID2_API Stats stats();
+
+    /// Starts a new measurement window; later snapshots count from this point.
+    ///
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    CUID2_API void reset_stats();
+
+    /// Installs a callback invoked with a fresh snapshot every INTERVAL
+    /// identifiers generated by each thread.
+    ///
+    /// The callback runs on the generating thread, outside any library lock,
+    /// so it may call stats() or reset_stats() but should return quickly.
+    /// An empty callback removes the current one. Has no effect when
+    /// instrumentation is disabled.
+    ///
+    /// @param callback Function to call, or empty to remove
+    /// @param INTERVAL Identifiers per thread between calls (at least 1)
+    /// @throws std::invalid_argument if INTERVAL is 0 and callback is set
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    CUID2_API void set_stats_callback(StatsCallback callback, uint64_t INTERVAL);
+} // namespace visus::cuid2
+
+#endif // LIBCUID2_STATS_HPP
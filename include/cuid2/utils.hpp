@@ -7,10 +7,13 @@
 #ifndef LIBCUID2_UTILS_HPP
 #define LIBCUID2_UTILS_HPP
 
+#include <array>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <span>
 #include <string>
+#include <string_view>
 
 namespace visus::cuid2::utils {
     /// Concept for byte-like types (uint8_t, unsigned char, std::byte).
@@ -26,6 +29,30 @@ namespace visus::cuid2::utils {
     concept ByteRange = std::ranges::contiguous_range<T> &&
                         ByteLike<std::ranges::range_value_t<T>>;
 
+    /// Size in bytes of a NIST FIPS-202 SHA3-512 digest.
+    constexpr size_t DIGEST_SIZE = 64;
+
+    /// Fixed-size SHA3-512 digest as produced by the CUID2 hashing stage.
+    using Digest = std::array<uint8_t, DIGEST_SIZE>;
+
+    /// Base-36 digits in ascending order: '0'-'9' followed by 'a'-'z'.
+    constexpr std::string_view BASE36_ALPHABET = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+    /// Number of lowercase letters in the English alphabet (a-z).
+    constexpr uint8_t LOWERCASE_LETTER_COUNT = 26;
+
+    /// Converts a random byte to a lowercase letter (a-z).
+    ///
+    /// Maps a random byte value to one of 26 lowercase letters using modulo
+    /// arithmetic. Exposed so that callers which draw randomness in bulk (such
+    /// as batch generation) can derive prefixes without an extra CSPRNG call.
+    ///
+    /// @param random_byte A random byte value
+    /// @return A lowercase letter from 'a' to 'z'
+    [[nodiscard]] constexpr char prefix_from_byte(const uint8_t random_byte) noexcept {
+        return static_cast<char>('a' + (random_byte % LOWERCASE_LETTER_COUNT));
+    }
+
     /// Generates a random lowercase letter prefix for CUID2 identifiers.
     ///
     /// Uses cryptographically secure randomness to select a letter from a-z.
@@ -33,8 +60,9 @@ namespace visus::cuid2::utils {
     /// valid identifiers in most programming languages.
     ///
     /// @return A random lowercase letter from 'a' to 'z'
+    /// @throws std::runtime_error if the entropy source fails
     /// @note Thread-safe: Can be called concurrently from multiple threads
-    [[nodiscard]] char generate_prefix() noexcept;
+    [[nodiscard]] char generate_prefix();
 
     /// Encodes a byte array as a base-36 string.
     ///
@@ -46,15 +74,71 @@ namespace visus::cuid2::utils {
     /// @return Base-36 encoded string, or "0" if input is empty or all zeros
     [[nodiscard]] std::string encode_base36(std::span<const uint8_t> data);
 
+    /// Encodes a SHA3-512 digest as a base-36 string.
+    ///
+    /// Fast path for the fixed 64-byte input produced by the hashing stage.
+    /// The digest is held in eight 64-bit limbs and divided by 36^12 per pass,
+    /// emitting twelve digits per division without any heap-allocating
+    /// arbitrary-precision arithmetic. Produces exactly the same output as the
+    /// generic std::span overload.
+    ///
+    /// @param digest Digest to encode (interpreted as big-endian)
+    /// @return Base-36 encoded string, or "0" if the digest is all zeros
+    [[nodiscard]] std::string encode_base36(const Digest& digest);
+
+    /// Encodes only the most significant base-36 digits of a byte array.
+    ///
+    /// Equivalent to encode_base36(data).substr(0, DIGITS), but skips the
+    /// character conversion of every low-order digit that would be discarded.
+    /// CUID2 identifiers keep only the leading digits of the hash, so this
+    /// avoids formatting roughly three quarters of a 512-bit value.
+    ///
+    /// @param data Span of bytes to encode (interpreted as big-endian)
+    /// @param DIGITS Maximum number of leading digits to produce
+    /// @return The first DIGITS characters of the base-36 encoding (fewer if the
+    ///         full encoding is shorter), or "0" if input is empty or all zeros
+    [[nodiscard]] std::string encode_base36_prefix(std::span<const uint8_t> data, size_t DIGITS);
+
+    /// Writes the most significant base-36 digits of a byte array into a buffer.
+    ///
+    /// Non-allocating form of encode_base36_prefix() for inputs of up to 64
+    /// bytes, which covers every SHA3-512 digest. Writes up to out.size()
+    /// leading digits; longer inputs fall back to heap-allocated scratch space.
+    ///
+    /// @param data Span of bytes to encode (interpreted as big-endian)
+    /// @param out Destination for the leading digits (not NUL-terminated)
+    /// @return Number of digits written: min(out.size(), total digit count)
+    size_t encode_base36_prefix(std::span<const uint8_t> data, std::span<char> out);
+
     /// Returns the current time as 100-nanosecond ticks since Unix epoch.
     ///
-    /// Provides a high-resolution timestamp suitable for sortable identifier
-    /// generation. The value represents the number of 100-nanosecond intervals
-    /// since January 1, 1970 00:00:00 UTC (Unix epoch).
+    /// Provides a high-resolution timestamp for identifier generation. The value
+    /// represents the number of 100-nanosecond intervals since January 1, 1970
+    /// 00:00:00 UTC (Unix epoch).
     ///
     /// @return Current timestamp as 100-nanosecond ticks since Unix epoch
     /// @note Thread-safe: Can be called concurrently from multiple threads
     [[nodiscard]] int64_t get_timestamp_ticks() noexcept;
+
+    /// Returns the current time from the operating system's coarse real-time
+    /// clock as 100-nanosecond ticks since Unix epoch.
+    ///
+    /// Reads CLOCK_REALTIME_COARSE on Linux, CLOCK_REALTIME_FAST on FreeBSD
+    /// and GetSystemTimeAsFileTime() on Windows. These return the time of the
+    /// last scheduler tick from memory shared with the kernel, so they stay
+    /// cheap on hosts whose precise clock source needs a system call, at a
+    /// resolution of the tick period (typically 1 to 16 ms). Other platforms
+    /// fall back to get_timestamp_ticks().
+    ///
+    /// @return Current coarse timestamp as 100-nanosecond ticks since Unix epoch
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    [[nodiscard]] int64_t get_coarse_timestamp_ticks() noexcept;
+
+    /// Reports whether get_coarse_timestamp_ticks() reads a coarse clock on
+    /// this platform rather than falling back to the precise one.
+    ///
+    /// @return true if a coarse clock is available
+    [[nodiscard]] bool has_coarse_clock() noexcept;
 } // namespace visus::cuid2::utils
 
 #endif // LIBCUID2_UTILS_HPP
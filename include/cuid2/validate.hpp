@@ -0,0 +1,80 @@
+/// @file validate.hpp
+/// @brief CUID2 identifier validation
+///
+/// Checks that text has the shape of a CUID2 identifier: a lowercase letter
+/// followed by lowercase base-36 digits, 4 to 32 characters in total. The
+/// checks use SSE4.2, AVX2 or NEON range compares when the running CPU
+/// supports them and a portable eight-characters-per-word fallback otherwise.
+///
+/// Example usage:
+/// @code
+///   #include <cuid2/cuid2.hpp>
+///
+///   if (!visus::cuid2::is_cuid2(request.id, 24)) {
+///       return bad_request();
+///   }
+///
+///   // Fixed-width identifiers stored back to back, e.g. an Arrow
+///   // FixedSizeBinary(24) column; std::vector<bool> is not contiguous, so
+///   // the results need another buffer
+///   auto valid = std::make_unique<bool[]>(rows);
+///   visus::cuid2::validate_batch(column, 24, 24, std::span<bool>(valid.get(), rows));
+/// @endcode
+
+#ifndef LIBCUID2_VALIDATE_HPP
+#define LIBCUID2_VALIDATE_HPP
+
+#include <cuid2/cuid2_export.hpp>
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+namespace visus::cuid2 {
+    /// Expected length that accepts every valid CUID2 length.
+    constexpr int ANY_LENGTH = 0;
+
+    /// Checks whether text is a well-formed CUID2 identifier.
+    ///
+    /// Only the shape is checked; any text of the right form is accepted,
+    /// whether or not this library generated it.
+    ///
+    /// @param TEXT Text to check
+    /// @param EXPECTED_LENGTH Required length, or ANY_LENGTH for 4 to 32
+    /// @return true if TEXT is a lowercase letter followed by lowercase base-36
+    ///         digits and has the expected length
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    [[nodiscard]] CUID2_API bool is_cuid2(std::string_view TEXT, int EXPECTED_LENGTH = ANY_LENGTH) noexcept;
+
+    /// Checks many identifiers at once.
+    ///
+    /// Equivalent to results[i] = is_cuid2(ids[i], EXPECTED_LENGTH), with the
+    /// CPU dispatch done once for the whole batch.
+    ///
+    /// @param ids Text to check
+    /// @param results Receives one result per element of ids
+    /// @param EXPECTED_LENGTH Required length, or ANY_LENGTH for 4 to 32
+    /// @throws std::invalid_argument if results and ids differ in size
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    CUID2_API void validate_batch(std::span<const std::string_view> ids, std::span<bool> results,
+                                  int EXPECTED_LENGTH = ANY_LENGTH);
+
+    /// Checks fixed-width identifiers stored at a fixed stride.
+    ///
+    /// Record i occupies bytes [i * STRIDE, i * STRIDE + LENGTH) of column,
+    /// which matches columnar layouts such as Arrow FixedSizeBinary
+    /// (STRIDE == LENGTH) and padded CHAR(n) fields (STRIDE > LENGTH). The
+    /// bytes between records are ignored. Records with at least 32 bytes of
+    /// the column after their start are checked with a single full-width load.
+    ///
+    /// @param column Buffer holding results.size() records
+    /// @param STRIDE Distance in bytes between consecutive records
+    /// @param LENGTH Length of every identifier (min: 4, max: 32, at most STRIDE)
+    /// @param results Receives one result per record
+    /// @throws std::invalid_argument if LENGTH is outside [4, 32], STRIDE is
+    ///         below LENGTH or column is too small for results.size() records
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    CUID2_API void validate_batch(std::span<const char> column, std::size_t STRIDE, int LENGTH,
+                                  std::span<bool> results);
+} // namespace visus::cuid2
+
+#endif // LIBCUID2_VALIDATE_HPP
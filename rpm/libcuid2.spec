@@ -31,11 +31,11 @@ BuildRequires:  openssl-devel >= 3.0
 
 %description
 libcuid2 is a C++ implementation of Cuid2, providing secure, collision-resistant,
-URL-safe, and sortable unique identifiers.
+and URL-safe unique identifiers.
 
 Features:
   * Collision-resistant using cryptographic primitives (SHA3-512)
-  * Sortable by timestamp for chronological ordering
+  * Opt-in time-ordered layout; default identifiers are uniformly random
   * URL-safe base-36 encoding
   * Thread-safe concurrent generation
   * Configurable length (4-32 characters, default 24)
@@ -65,7 +65,7 @@ Requires:       openssl-devel >= 3.0
 
 %description devel
 libcuid2 is a C++ implementation of Cuid2, providing secure, collision-resistant,
-URL-safe, and sortable unique identifiers.
+and URL-safe unique identifiers.
 
 This package contains the development files including headers, CMake
 configuration files, and manual pages for library functions.
@@ -80,7 +80,7 @@ Requires:       %{name}%{?_isa} = %{version}-%{release}
 %description -n cuid2gen
 cuid2gen is a command-line utility for generating Cuid2 identifiers.
 
-Cuid2 identifiers are collision-resistant, sortable, URL-safe unique
+Cuid2 identifiers are collision-resistant, URL-safe unique
 identifiers suitable for distributed systems, databases, and web applications.
 
 This package contains the command-line executable and user manual.
@@ -0,0 +1,223 @@
+/// @file async.cpp
+/// @brief Awaitable identifier generation
+///
+/// This file implements async_generate() and the shared worker thread it uses
+/// when the caller supplies no executor. The worker is created on first use
+/// and published through an atomic pointer tagged with the owning process, so
+/// a forked child, which inherits the pointer but not the thread, creates its
+/// own without touching the parent's (possibly locked) mutex.
+
+#include "cuid2/async.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "cuid2/platform.hpp"
+#include "cuid2/pool.hpp"
+
+namespace visus::cuid2 {
+    namespace {
+        /// Single background thread running queued jobs in order.
+        ///
+        /// As in Pool, the thread sleeps on an atomic wait on the number of
+        /// jobs submitted rather than on a condition variable.
+        class Worker {
+            /// Process whose thread serves this queue.
+            const int owner_pid_ = platform::get_process_id();
+
+            std::mutex mutex_;
+            std::deque<std::function<void()>> jobs_;
+
+            /// Jobs submitted so far; the thread waits for it to change.
+            std::atomic<uint64_t> submitted_{0};
+
+            std::thread thread_;
+
+            /// Removes the oldest queued job.
+            ///
+            /// @return The job, or an empty function if the queue is empty
+            std::function<void()> pop() {
+                const std::scoped_lock LOCK(mutex_);
+
+                if (jobs_.empty()) {
+                    return {};
+                }
+
+                std::function<void()> job = std::move(jobs_.front());
+                jobs_.pop_front();
+
+                return job;
+            }
+
+            /// Runs jobs as they arrive; never returns.
+            [[noreturn]] void run() {
+                for (;;) {
+                    // Read before checking the queue, so a job submitted in
+                    // between changes the value and the wait returns at once
+                    const uint64_t SEEN = submitted_.load(std::memory_order_acquire);
+
+                    if (const std::function<void()> JOB = pop()) {
+                        JOB();
+                    } else {
+                        submitted_.wait(SEEN, std::memory_order_acquire);
+                    }
+                }
+            }
+
+        public:
+            /// Returns the process this worker belongs to.
+            [[nodiscard]] int owner_pid() const noexcept {
+                return owner_pid_;
+            }
+
+            /// Starts the thread; called once the worker has been published.
+            void start() {
+                thread_ = std::thread([this] { run(); });
+                thread_.detach();
+            }
+
+            /// Queues a job for the worker thread.
+            ///
+            /// @param job Work to run
+            void submit(std::function<void()> job) {
+                {
+                    const std::scoped_lock LOCK(mutex_);
+                    jobs_.push_back(std::move(job));
+                }
+
+                submitted_.fetch_add(1, std::memory_order_release);
+                submitted_.notify_one();
+            }
+        };
+
+        /// Worker of the current process, or of the parent after fork().
+        ///
+        /// Workers are never deleted: the thread runs until the process exits,
+        /// and a parent's worker inherited by a child has no thread to stop.
+        std::atomic<Worker*> shared_worker_ptr{nullptr};
+
+        /// Returns the current process's worker, creating it on first use.
+        ///
+        /// @return Worker whose thread runs in this process
+        /// @throws std::system_error if the thread cannot be started
+        Worker& shared_worker() {
+            const int PID = platform::get_process_id();
+            Worker* current = shared_worker_ptr.load(std::memory_order_acquire);
+
+            while (current == nullptr || current->owner_pid() != PID) [[unlikely]] {
+                auto candidate = std::make_unique<Worker>();
+
+                if (shared_worker_ptr.compare_exchange_strong(current, candidate.get(), std::memory_order_acq_rel)) {
+                    current = candidate.release();
+                    current->start();
+                }
+            }
+
+            return *current;
+        }
+    } // anonymous namespace
+
+    /// Prepares COUNT identifiers' worth of storage.
+    ///
+    /// @param COUNT Number of identifiers to produce
+    /// @param options Validated length, pool and executors
+    GenerateAwaitable::GenerateAwaitable(const std::size_t COUNT, AsyncOptions options)
+        : count_(COUNT), options_(std::move(options)), ids_(COUNT) {}
+
+    /// Takes identifiers from the pool if one was given.
+    ///
+    /// Uses Pool::try_acquire_into(), so an empty ring never causes inline
+    /// generation on the awaiting thread.
+    ///
+    /// @return true if every identifier is already available
+    bool GenerateAwaitable::await_ready() {
+        if (options_.pool != nullptr) {
+            const auto LENGTH = static_cast<std::size_t>(options_.length);
+
+            while (taken_ < count_) {
+                ids_[taken_].resize(LENGTH);
+                if (!options_.pool->try_acquire_into(ids_[taken_])) {
+                    break;
+                }
+
+                ++taken_;
+            }
+        }
+
+        return taken_ == count_;
+    }
+
+    /// Generates the identifiers not taken from the pool.
+    ///
+    /// Runs on the executor; errors are kept for await_resume().
+    void GenerateAwaitable::generate_remaining() noexcept {
+        try {
+            generate_batch(std::span(ids_).subspan(taken_), options_.length);
+        } catch (...) {
+            error_ = std::current_exception();
+        }
+    }
+
+    /// Hands the remaining work to the executor.
+    ///
+    /// The executors are copied first: once the job resumes the coroutine,
+    /// the awaitable may be destroyed while the executor call is still
+    /// returning.
+    ///
+    /// @param handle Coroutine to resume once the identifiers are ready
+    void GenerateAwaitable::await_suspend(const std::coroutine_handle<> handle) {
+        auto job = [this, handle, resume = options_.resume] {
+            generate_remaining();
+
+            if (resume) {
+                resume([handle] { handle.resume(); });
+            } else {
+                handle.resume();
+            }
+        };
+
+        if (const AsyncExecutor EXECUTOR = options_.executor) {
+            EXECUTOR(std::move(job));
+        } else {
+            shared_worker().submit(std::move(job));
+        }
+    }
+
+    /// Returns the identifiers.
+    ///
+    /// @return COUNT identifiers of the requested length
+    /// @throws the error raised while generating, if any
+    std::vector<std::string> GenerateAwaitable::await_resume() {
+        if (error_) [[unlikely]] {
+            std::rethrow_exception(error_);
+        }
+
+        return std::move(ids_);
+    }
+
+    /// Generates identifiers without blocking the awaiting thread.
+    ///
+    /// @param COUNT Number of identifiers to generate
+    /// @param options Length, pool and executors
+    /// @return Awaitable yielding a vector of COUNT identifiers
+    /// @throws std::invalid_argument if options.length is outside [4, 32] or
+    ///         differs from the pool's length
+    GenerateAwaitable async_generate(const std::size_t COUNT, AsyncOptions options) {
+        if (options.length < MIN_CUID2_LENGTH || options.length > MAX_CUID2_LENGTH) [[unlikely]] {
+            throw std::invalid_argument("length must be between 4 and 32");
+        }
+
+        if (options.pool != nullptr && options.pool->length() != options.length) [[unlikely]] {
+            throw std::invalid_argument("length must match the pool's identifier length");
+        }
+
+        return {COUNT, std::move(options)};
+    }
+} // namespace visus::cuid2
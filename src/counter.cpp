@@ -3,13 +3,18 @@
 ///
 /// This file implements a singleton counter that provides monotonically increasing
 /// values for CUID2 identifier generation. The counter is initialized with a
-/// cryptographically random seed to ensure uniqueness across process restarts.
+/// cryptographically random seed to ensure uniqueness across process restarts,
+/// and advanced by a new random offset in every new process generation.
+/// In NUMA mode each node draws from its own partition of the value range.
 
 #include "cuid2/counter.hpp"
 
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <ranges>
+#include <stdexcept>
 
 #include "cuid2/platform.hpp"
 
@@ -22,6 +27,78 @@ namespace visus::cuid2 {
     /// Number of bits in a byte, used for bit-shifting operations.
     constexpr size_t BITS_PER_BYTE = 8;
 
+    namespace {
+        /// Counter values reserved by the calling thread in block mode.
+        ///
+        /// Unsigned arithmetic keeps the increment well-defined when a block
+        /// spans the int64_t wrap-around point, matching the shared counter's
+        /// modular fetch_add.
+        struct ThreadBlock {
+            uint64_t next = 0;
+            int64_t remaining = 0;
+
+            /// Process generation the block was reserved in; a block from an
+            /// older generation is also held by the parent and is discarded.
+            uint64_t generation = 0;
+        };
+
+        thread_local ThreadBlock thread_block;
+
+        /// Number of values a node partition owns; one shared increment per
+        /// 2^40 values keeps refills rare even at billions of IDs per second.
+        constexpr uint64_t PARTITION_SPAN = uint64_t{1} << 40;
+
+        /// Partition lookups served before the node is queried again, so
+        /// migrated threads move to their new node's partition.
+        constexpr uint32_t NUMA_NODE_REFRESH = 256;
+
+        /// NUMA node of the calling thread, as last queried.
+        struct ThreadNode {
+            unsigned node = 0;
+            uint32_t remaining = 0;
+        };
+
+        thread_local ThreadNode thread_node;
+
+        /// Returns the calling thread's node, querying it every
+        /// NUMA_NODE_REFRESH calls.
+        ///
+        /// @return NUMA node, possibly stale by a few calls after a migration
+        unsigned current_node() noexcept {
+            if (thread_node.remaining == 0) [[unlikely]] {
+                thread_node.node = platform::get_numa_node();
+                thread_node.remaining = NUMA_NODE_REFRESH;
+            }
+
+            --thread_node.remaining;
+            return thread_node.node;
+        }
+    } // anonymous namespace
+
+    /// Range [base, base + PARTITION_SPAN) of counter values owned by one node.
+    ///
+    /// Each partition sits on its own cache line and is allocated by the first
+    /// thread to use it on that node. Partitions are never freed, since a
+    /// thread may still be drawing from one after it is replaced; each keeps
+    /// the one it replaced reachable. Only a few are created per generation.
+    struct alignas(64) Counter::Partition {
+        /// First value of the range, taken from the shared value.
+        const uint64_t base;
+
+        /// Process generation the range was taken in.
+        const uint64_t generation;
+
+        /// Partition this one replaced, or nullptr for the first.
+        const Partition* const previous;
+
+        /// Values handed out so far; may run past PARTITION_SPAN while the
+        /// partition is being replaced.
+        std::atomic<uint64_t> used{0};
+
+        Partition(const uint64_t BASE, const uint64_t GENERATION, const Partition* const PREVIOUS) noexcept
+            : base(BASE), generation(GENERATION), previous(PREVIOUS) {}
+    };
+
     /// Generates the initial counter value using cryptographic randomness.
     ///
     /// Creates a random 64-bit seed using the platform's CSPRNG and multiplies
@@ -51,9 +128,161 @@ namespace visus::cuid2 {
     /// increments its value, returning the pre-increment value. The operation is
     /// lock-free on most platforms and safe for concurrent access.
     ///
+    /// When a block size greater than one is configured, the value is taken from
+    /// the calling thread's reserved block instead, and a new block is reserved
+    /// with a single fetch_add once the current one is exhausted.
+    ///
     /// @return The next sequential counter value (monotonically increasing)
     /// @note Thread-safe: Can be called concurrently from multiple threads
     int64_t Counter::next() {
-        return instance.value_.fetch_add(1);
+        const uint64_t GENERATION = current_generation();
+
+        if (thread_block.remaining > 0 && thread_block.generation == GENERATION) {
+            --thread_block.remaining;
+            return static_cast<int64_t>(thread_block.next++);
+        }
+
+        const int64_t BLOCK_SIZE = instance.block_size_.load(std::memory_order_relaxed);
+        if (BLOCK_SIZE <= 1) [[likely]] {
+            return draw(1, GENERATION);
+        }
+
+        const int64_t FIRST = draw(BLOCK_SIZE, GENERATION);
+        thread_block.next = static_cast<uint64_t>(FIRST) + 1;
+        thread_block.remaining = BLOCK_SIZE - 1;
+        thread_block.generation = GENERATION;
+
+        return FIRST;
+    }
+
+    /// Reserves a contiguous range of counter values in a thread-safe manner.
+    ///
+    /// Atomically advances the singleton counter by COUNT with a single
+    /// fetch_add, so batch callers pay for one atomic read-modify-write
+    /// regardless of how many values they consume.
+    ///
+    /// @param COUNT Number of consecutive counter values to reserve
+    /// @return The first counter value of the reserved range
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    int64_t Counter::reserve(const int64_t COUNT) {
+        return draw(COUNT, current_generation());
+    }
+
+    /// Returns the current process generation.
+    ///
+    /// @return Value of platform::process_generation()
+    uint64_t Counter::current_generation() noexcept {
+        return platform::process_generation();
+    }
+
+    /// Advances the shared value by COUNT, first re-seeding it if it was
+    /// seeded for an older generation.
+    ///
+    /// Re-seeding adds a random offset rather than storing a new value, so
+    /// threads racing through it never draw the same value twice, and every
+    /// thread that sees the old generation applies its own offset before
+    /// drawing. A thread that sees the new generation is ordered after at
+    /// least one offset by the release store.
+    ///
+    /// @param COUNT Number of values to take
+    /// @param GENERATION Current process generation
+    /// @return The first value taken
+    int64_t Counter::take(const int64_t COUNT, const uint64_t GENERATION) {
+        if (instance.generation_.load(std::memory_order_acquire) != GENERATION) [[unlikely]] {
+            instance.value_.fetch_add(generate_initial_counter_value());
+            instance.generation_.store(GENERATION, std::memory_order_release);
+        }
+
+        return instance.value_.fetch_add(COUNT);
+    }
+
+    /// Takes COUNT values from the calling thread's node partition.
+    ///
+    /// A partition that is used up or was created in an older generation is
+    /// replaced by one holding the next PARTITION_SPAN values of the shared
+    /// counter, which re-seeds it first if needed. When two threads replace
+    /// the same partition, the loser's range is dropped unused, so every
+    /// value still comes from exactly one range. Requests larger than a
+    /// partition go to the shared value directly.
+    ///
+    /// @param COUNT Number of values to take
+    /// @param GENERATION Current process generation
+    /// @return The first value taken
+    int64_t Counter::take_local(const int64_t COUNT, const uint64_t GENERATION) {
+        const auto SIZE = static_cast<uint64_t>(COUNT);
+        if (SIZE > PARTITION_SPAN) [[unlikely]] {
+            return take(COUNT, GENERATION);
+        }
+
+        auto& slot = instance.partitions_[current_node() % MAX_NUMA_NODES];
+        Partition* partition = slot.load(std::memory_order_acquire);
+
+        for (;;) {
+            if (partition != nullptr && partition->generation == GENERATION) [[likely]] {
+                const uint64_t USED = partition->used.fetch_add(SIZE, std::memory_order_relaxed);
+                if (USED <= PARTITION_SPAN - SIZE) [[likely]] {
+                    return static_cast<int64_t>(partition->base + USED);
+                }
+            }
+
+            const auto BASE = static_cast<uint64_t>(take(static_cast<int64_t>(PARTITION_SPAN), GENERATION));
+            auto candidate = std::make_unique<Partition>(BASE, GENERATION, partition);
+
+            if (slot.compare_exchange_strong(partition, candidate.get(), std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+                partition = candidate.release();
+            }
+        }
+    }
+
+    /// Takes COUNT values in the configured mode.
+    ///
+    /// @param COUNT Number of values to take
+    /// @param GENERATION Current process generation
+    /// @return The first value taken
+    int64_t Counter::draw(const int64_t COUNT, const uint64_t GENERATION) {
+        if (instance.numa_partitioned_.load(std::memory_order_relaxed)) {
+            return take_local(COUNT, GENERATION);
+        }
+
+        return take(COUNT, GENERATION);
+    }
+
+    /// Sets how many values next() reserves per thread at once.
+    ///
+    /// @param SIZE Number of values per thread block (must be at least 1)
+    /// @throws std::invalid_argument if SIZE is less than 1
+    /// @note Thread-safe: Can be called concurrently with next()
+    void Counter::set_thread_block_size(const int64_t SIZE) {
+        if (SIZE < 1) [[unlikely]] {
+            throw std::invalid_argument("SIZE must be at least 1");
+        }
+
+        instance.block_size_.store(SIZE, std::memory_order_relaxed);
+    }
+
+    /// Returns the current per-thread block size.
+    ///
+    /// @return Number of values reserved per thread block (1 = no blocks)
+    int64_t Counter::thread_block_size() noexcept {
+        return instance.block_size_.load(std::memory_order_relaxed);
+    }
+
+    /// Enables or disables per-NUMA-node counter partitions.
+    ///
+    /// Partitions are carved out of the shared value, so values drawn in
+    /// either mode never overlap.
+    ///
+    /// @param ENABLED true to partition by node, false for one shared value
+    /// @note Thread-safe: Can be called concurrently with next()
+    void Counter::set_numa_partitioned(const bool ENABLED) noexcept {
+        instance.numa_partitioned_.store(ENABLED, std::memory_order_relaxed);
+    }
+
+    /// Returns whether per-NUMA-node counter partitions are enabled.
+    ///
+    /// @return true if values are drawn from per-node partitions
+    bool Counter::numa_partitioned() noexcept {
+        return instance.numa_partitioned_.load(std::memory_order_relaxed);
     }
 } // namespace visus::cuid2
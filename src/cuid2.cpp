@@ -1,60 +1,43 @@
 /// @file cuid2.cpp
 /// @brief Main CUID2 identifier generation implementation
 ///
-/// This file implements the core CUID2 generation algorithm which combines:
-/// - Timestamp (for sortability)
+/// This file implements the free CUID2 generation functions. Each thread owns a
+/// default Generator that draws from the process-wide Counter and system
+/// Fingerprint, so these functions produce the same identifiers they always
+/// have while the pipeline itself lives in generator.cpp. The identifiers
+/// combine:
+/// - Timestamp (for uniqueness over time; hashed, so default IDs do not sort
+///   by time)
 /// - Atomic counter (for uniqueness within same timestamp)
 /// - System fingerprint (for uniqueness across processes/machines)
 /// - Cryptographic random bytes (for collision resistance)
 /// - NIST FIPS-202 SHA3-512 hashing (for output uniformity)
 /// - Base-36 encoding (for compact, URL-safe representation)
 ///
-/// The resulting identifiers are collision-resistant, sortable by creation time,
-/// and safe for use in URLs and as database identifiers.
+/// The resulting identifiers are collision-resistant, uniformly random and safe
+/// for use in URLs and as database identifiers; only generators created with
+/// GeneratorOptions::sortable order them by creation time.
 
 #include "cuid2/cuid2.hpp"
 
-#include <array>
-#include <bit>
-#include <cstring>
-#include <memory>
+#include <span>
 #include <stdexcept>
 #include <string_view>
 
-#include <boost/endian/conversion.hpp>
-#include <openssl/evp.h>
+#include <fmt/core.h>
+#include <openssl/crypto.h>
 
-#include "cuid2/counter.hpp"
 #include "cuid2/fingerprint.hpp"
+#include "cuid2/generator.hpp"
 #include "cuid2/platform.hpp"
-#include "cuid2/utils.hpp"
+#include "validate_kernels.hpp"
 
-#include <fmt/core.h>
+#ifdef CUID2_ENABLE_SIMD_KECCAK
+    #include "cuid2/keccak.hpp"
+#endif
 
 namespace visus::cuid2 {
     namespace {
-        /// Combined size of timestamp and counter in bytes (8 bytes each).
-        constexpr size_t TIMESTAMP_COUNTER_SIZE = sizeof(int64_t) * 2;
-
-        /// Length of the random letter prefix (always 1 character).
-        constexpr size_t PREFIX_LENGTH = 1;
-
-        /// Serializes a 64-bit integer to little-endian bytes and appends to buffer.
-        ///
-        /// Converts the input value to unsigned, then to little-endian byte order
-        /// using boost::endian for cross-platform compatibility. The 8 bytes are
-        /// appended to the buffer in little-endian order.
-        ///
-        /// @param buffer Vector to append the serialized bytes to
-        /// @param VALUE The 64-bit integer to serialize
-        void serialize_int64_le(std::vector<uint8_t>& buffer, const int64_t VALUE) {
-            const auto UNSIGNED_VALUE = static_cast<uint64_t>(VALUE);
-            const auto LITTLE_ENDIAN_VALUE = boost::endian::native_to_little(UNSIGNED_VALUE);
-            const auto BYTES = std::bit_cast<std::array<uint8_t, sizeof(uint64_t)>>(LITTLE_ENDIAN_VALUE);
-
-            buffer.insert(buffer.end(), BYTES.begin(), BYTES.end());
-        }
-
         /// Validates the requested CUID2 length is within allowed bounds.
         ///
         /// Checks that the requested length is between MIN_CUID2_LENGTH (4) and
@@ -63,108 +46,59 @@ namespace visus::cuid2 {
         ///
         /// @param MAX_LENGTH The requested CUID2 identifier length
         /// @throws std::invalid_argument if length is outside valid range
-        void validate_length(const int MAX_LENGTH) {
+        void validate_max_length(const int MAX_LENGTH) {
             if (MAX_LENGTH < MIN_CUID2_LENGTH || MAX_LENGTH > MAX_CUID2_LENGTH) [[unlikely]] {
                 throw std::invalid_argument("MAX_LENGTH must be between 4 and 32");
             }
         }
 
-        /// Builds the input buffer for SHA3-512 hashing.
-        ///
-        /// Concatenates all CUID2 components in a specific order:
-        /// 1. Timestamp (8 bytes, little-endian)
-        /// 2. Counter (8 bytes, little-endian)
-        /// 3. Fingerprint (variable length)
-        /// 4. Random bytes (variable length)
+        /// Checks that a memory resource was supplied.
         ///
-        /// This deterministic ordering ensures consistent hash outputs for testing
-        /// and cross-implementation compatibility.
-        ///
-        /// @param TIMESTAMP Current timestamp in 100-nanosecond ticks
-        /// @param COUNTER Current counter value
-        /// @param fingerprint System fingerprint bytes
-        /// @param random_bytes Cryptographically secure random bytes
-        /// @return Concatenated byte vector ready for hashing
-        [[nodiscard]] std::vector<uint8_t> build_hash_input(
-            const int64_t TIMESTAMP,
-            const int64_t COUNTER,
-            const std::vector<uint8_t>& fingerprint,
-            const std::vector<uint8_t>& random_bytes
-        ) {
-            std::vector<uint8_t> hash_input;
-            hash_input.reserve(TIMESTAMP_COUNTER_SIZE + fingerprint.size() + random_bytes.size());
-
-            serialize_int64_le(hash_input, TIMESTAMP);
-            serialize_int64_le(hash_input, COUNTER);
-            hash_input.insert(hash_input.end(), fingerprint.begin(), fingerprint.end());
-            hash_input.insert(hash_input.end(), random_bytes.begin(), random_bytes.end());
-
-            return hash_input;
+        /// @param resource Resource to check
+        /// @throws std::invalid_argument if resource is null
+        void validate_resource(const std::pmr::memory_resource* resource) {
+            if (resource == nullptr) [[unlikely]] {
+                throw std::invalid_argument("resource must not be null");
+            }
         }
 
-        /// Computes NIST FIPS-202 SHA3-512 hash of the input bytes.
+        /// Returns the calling thread's default generator.
         ///
-        /// Uses OpenSSL's EVP interface to compute SHA3-512 (the standardized
-        /// NIST FIPS-202 variant, not the original Keccak). This provides a
-        /// 64-byte (512-bit) cryptographic hash with strong collision resistance.
+        /// The generator shares the process-wide Counter and system fingerprint,
+        /// and owns a digest context that is reused for every identifier.
         ///
-        /// @param input Byte vector to hash
-        /// @return 64-byte SHA3-512 hash output
-        [[nodiscard]] std::vector<uint8_t> compute_hash(const std::vector<uint8_t>& input) {
-            /// RAII deleter for OpenSSL EVP_MD_CTX context.
-            /// Ensures EVP_MD_CTX_free() is called when the unique_ptr goes out of scope.
-            struct EVPContextDeleter {
-                void operator()(EVP_MD_CTX* ctx) const noexcept {
-                    EVP_MD_CTX_free(ctx);
-                }
-            };
+        /// @return Reference to the thread-local default generator
+        Generator& default_generator() {
+            thread_local Generator generator(GeneratorOptions{.shared_counter = true});
 
-            const std::unique_ptr<EVP_MD_CTX, EVPContextDeleter> CTX(EVP_MD_CTX_new());
-
-            EVP_DigestInit_ex(CTX.get(), EVP_sha3_512(), nullptr);
-            EVP_DigestUpdate(CTX.get(), input.data(), input.size());
-
-            std::vector<uint8_t> hash_output(EVP_MD_size(EVP_sha3_512()));
-
-            unsigned int hash_len = 0;
-
-            EVP_DigestFinal_ex(CTX.get(), hash_output.data(), &hash_len);
-
-            return hash_output;
+            return generator;
         }
+    } // anonymous namespace
 
-        /// Formats the final CUID2 identifier by combining prefix and encoded hash.
-        ///
-        /// Constructs the final identifier as: [prefix][encoded_hash_substring]
-        /// The result is truncated to MAX_LENGTH characters total. The prefix is
-        /// always 1 character (a-z), so the encoded hash contributes (MAX_LENGTH - 1)
-        /// characters.
-        ///
-        /// @param PREFIX Random lowercase letter prefix (a-z)
-        /// @param ENCODED Base-36 encoded hash string
-        /// @param MAX_LENGTH Total desired identifier length (including prefix)
-        /// @return Formatted CUID2 identifier of exact length MAX_LENGTH
-        [[nodiscard]] std::string format_result(const char PREFIX, const std::string_view ENCODED, const int MAX_LENGTH) {
-            std::string result;
-            result.reserve(MAX_LENGTH);
-            result += PREFIX;
-
-            if (const size_t NEEDED_LENGTH = MAX_LENGTH - PREFIX_LENGTH; ENCODED.length() >= NEEDED_LENGTH) [[likely]] {
-                result += ENCODED.substr(0, NEEDED_LENGTH);
-            } else {
-                // GCOVR_EXCL_START - SHA3-512 base-36 encoding always exceeds MAX_LENGTH
-                result += ENCODED;
-                // GCOVR_EXCL_STOP
+    namespace detail {
+        /// Grants generate<N>() access to Generator::write_fixed().
+        struct FixedAccess {
+            static void write(Generator& generator, char* out, const int LENGTH) {
+                generator.write_fixed(out, LENGTH);
             }
+        };
 
-            return result;
+        /// Writes exactly LENGTH characters using the calling thread's default
+        /// generator.
+        ///
+        /// @param out Destination for LENGTH characters
+        /// @param LENGTH Identifier length, already known to be in [4, 32]
+        void generate_fixed(char* out, const int LENGTH) {
+            FixedAccess::write(default_generator(), out, LENGTH);
         }
-    } // anonymous namespace
+    } // namespace detail
 
     /// Generates a CUID2 identifier of the specified length.
     ///
-    /// Creates a collision-resistant, sortable unique identifier by combining:
-    /// 1. Current timestamp (for sortability and uniqueness over time)
+    /// Creates a collision-resistant, uniformly random unique identifier by
+    /// combining:
+    /// 1. Current timestamp (for uniqueness over time; hashed, so default IDs
+    ///    do not sort by time)
     /// 2. Atomic counter (for uniqueness within same timestamp)
     /// 3. System fingerprint (for uniqueness across processes/machines)
     /// 4. Cryptographic random bytes (for collision resistance)
@@ -178,21 +112,184 @@ namespace visus::cuid2 {
     /// @throws std::invalid_argument if MAX_LENGTH is outside valid range [4, 32]
     /// @note Thread-safe: Can be called concurrently from multiple threads
     std::string generate(const int MAX_LENGTH) {
-        validate_length(MAX_LENGTH);
+        validate_max_length(MAX_LENGTH);
+
+        std::string result(static_cast<size_t>(MAX_LENGTH), '\0');
+        result.resize(default_generator().next_into(result));
+
+        return result;
+    }
+
+    /// Generates a CUID2 identifier whose storage comes from a memory resource.
+    ///
+    /// @param resource Resource for the string's storage
+    /// @param MAX_LENGTH Desired identifier length (default: 24, min: 4, max: 32)
+    /// @return A CUID2 identifier string of exact length MAX_LENGTH
+    /// @throws std::invalid_argument if resource is null or MAX_LENGTH is
+    ///         outside valid range [4, 32]
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    std::pmr::string generate(std::pmr::memory_resource* resource, const int MAX_LENGTH) {
+        validate_resource(resource);
+        validate_max_length(MAX_LENGTH);
+
+        std::pmr::string result(static_cast<size_t>(MAX_LENGTH), '\0', resource);
+        result.resize(default_generator().next_into(result));
+
+        return result;
+    }
+
+    /// Writes a CUID2 identifier of the specified length into caller memory.
+    ///
+    /// Uses only fixed-size stack buffers for the random bytes, hash header,
+    /// digest and base-36 conversion, so no heap allocation is performed by the
+    /// identifier pipeline itself.
+    ///
+    /// @param out Destination for LENGTH characters (not NUL-terminated)
+    /// @param LENGTH Identifier length to write (min: 4, max: 32)
+    /// @return Number of characters written (always LENGTH in practice)
+    /// @throws std::invalid_argument if LENGTH is outside valid range [4, 32]
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    std::size_t generate_into(char* out, const std::size_t LENGTH) {
+        return default_generator().next_into(std::span(out, LENGTH));
+    }
+
+    /// Writes a CUID2 identifier filling the whole of a caller-provided buffer.
+    ///
+    /// @param out Destination buffer; its size is the identifier length (min: 4, max: 32)
+    /// @return Number of characters written (always out.size() in practice)
+    /// @throws std::invalid_argument if out.size() is outside valid range [4, 32]
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    std::size_t generate_into(const std::span<char> out) {
+        return generate_into(out.data(), out.size());
+    }
+
+    /// Generates a CUID2 identifier into every element of a caller-provided range.
+    ///
+    /// Delegates to the calling thread's default generator, which reads the
+    /// timestamp once, reserves out.size() consecutive counter values with a
+    /// single atomic increment, and draws random bytes in bulk.
+    ///
+    /// @param out Range of strings to overwrite with newly generated identifiers
+    /// @param MAX_LENGTH Desired identifier length (default: 24, min: 4, max: 32)
+    /// @throws std::invalid_argument if MAX_LENGTH is outside valid range [4, 32]
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    void generate_batch(const std::span<std::string> out, const int MAX_LENGTH) {
+        default_generator().next_batch(out, MAX_LENGTH);
+    }
+
+    /// Generates COUNT CUID2 identifiers of the specified length.
+    ///
+    /// @param COUNT Number of identifiers to generate
+    /// @param MAX_LENGTH Desired identifier length (default: 24, min: 4, max: 32)
+    /// @return A vector of COUNT CUID2 identifiers of exact length MAX_LENGTH
+    /// @throws std::invalid_argument if MAX_LENGTH is outside valid range [4, 32]
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    std::vector<std::string> generate_batch(const std::size_t COUNT, const int MAX_LENGTH) {
+        validate_max_length(MAX_LENGTH);
+
+        std::vector<std::string> result(COUNT);
+        generate_batch(std::span<std::string>(result), MAX_LENGTH);
 
-        const int64_t TIMESTAMP = utils::get_timestamp_ticks();
-        const int64_t COUNTER = Counter::next();
-        const auto& fingerprint = Fingerprint::get();
+        return result;
+    }
+
+    /// Generates a CUID2 identifier into every element of a range of strings
+    /// allocating from their own memory resources.
+    ///
+    /// @param out Range of strings to overwrite with newly generated identifiers
+    /// @param MAX_LENGTH Desired identifier length (default: 24, min: 4, max: 32)
+    /// @throws std::invalid_argument if MAX_LENGTH is outside valid range [4, 32]
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    void generate_batch(const std::span<std::pmr::string> out, const int MAX_LENGTH) {
+        default_generator().next_batch(out, MAX_LENGTH);
+    }
+
+    /// Generates COUNT CUID2 identifiers with all storage from a memory resource.
+    ///
+    /// Identifiers fit the strings' small-buffer storage up to 15 characters,
+    /// so shorter batches allocate only the vector itself.
+    ///
+    /// @param COUNT Number of identifiers to generate
+    /// @param resource Resource for the vector's and the strings' storage
+    /// @param MAX_LENGTH Desired identifier length (default: 24, min: 4, max: 32)
+    /// @return A vector of COUNT CUID2 identifiers of exact length MAX_LENGTH
+    /// @throws std::invalid_argument if resource is null or MAX_LENGTH is
+    ///         outside valid range [4, 32]
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    std::pmr::vector<std::pmr::string> generate_batch(const std::size_t COUNT, std::pmr::memory_resource* resource,
+                                                      const int MAX_LENGTH) {
+        validate_resource(resource);
+        validate_max_length(MAX_LENGTH);
+
+        std::pmr::vector<std::pmr::string> result(COUNT, resource);
+        generate_batch(std::span<std::pmr::string>(result), MAX_LENGTH);
+
+        return result;
+    }
+
+    /// Writes COUNT CUID2 identifiers as fixed-width records at a fixed stride.
+    ///
+    /// Delegates to the calling thread's default generator, which amortizes
+    /// the timestamp read, counter reservation and entropy requests over the
+    /// batch exactly as generate_batch() does.
+    ///
+    /// @param column Buffer receiving COUNT records
+    /// @param STRIDE Distance in bytes between consecutive records
+    /// @param COUNT Number of identifiers to write
+    /// @param MAX_LENGTH Desired identifier length (min: 4, max: 32, at most STRIDE)
+    /// @throws std::invalid_argument if MAX_LENGTH, STRIDE or the column size is invalid
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    void generate_batch_into(const std::span<char> column, const std::size_t STRIDE, const std::size_t COUNT,
+                             const int MAX_LENGTH) {
+        default_generator().next_batch_into(column, STRIDE, COUNT, MAX_LENGTH);
+    }
+
+    /// Refreshes all process-derived state after the process was duplicated.
+    ///
+    /// Starts a new process generation; the fingerprint, counters and random
+    /// buffers each notice it on their next use.
+    ///
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    void reseed() noexcept {
+        platform::start_new_generation();
+    }
+
+    /// Uses an explicit node identifier in place of the hostname and
+    /// environment in the process fingerprint.
+    ///
+    /// @param NODE_ID Node identifier, or empty to restore the default
+    ///        fingerprint (CUID2_NODE_ID if set, else hostname and environment)
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    void set_node_id(const std::string_view NODE_ID) {
+        Fingerprint::set_node_id(NODE_ID);
+    }
+
+    /// Reports the backends in use by this build on this CPU.
+    ///
+    /// @return Description of the active hash and random backends
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    BackendInfo backend_info() {
+        BackendInfo info;
+        info.crypto_library = OpenSSL_version(OPENSSL_VERSION);
+        info.hash_backend = "OpenSSL EVP SHA3-512";
 
-        std::vector<uint8_t> random_bytes(MAX_LENGTH);
-        platform::get_random_bytes(random_bytes.data(), MAX_LENGTH);
+#ifdef CUID2_ENABLE_SIMD_KECCAK
+        const keccak::Backend BACKEND = keccak::detect_backend();
+        info.batch_hash_backend = keccak::lane_count(BACKEND) > 1
+            ? fmt::format("Keccak {} x{}", keccak::backend_name(BACKEND), keccak::lane_count(BACKEND))
+            : info.hash_backend;
+#else
+        info.batch_hash_backend = info.hash_backend;
+#endif
 
-        const char PREFIX = utils::generate_prefix();
+        const size_t POOL_SIZE = platform::random_pool_size();
+        info.random_backend = POOL_SIZE > 0
+            ? fmt::format("{} ({} byte per-thread buffer)", platform::entropy_source_name(), POOL_SIZE)
+            : platform::entropy_source_name();
 
-        const auto HASH_INPUT = build_hash_input(TIMESTAMP, COUNTER, fingerprint, random_bytes);
-        const auto HASH_OUTPUT = compute_hash(HASH_INPUT);
-        const auto ENCODED = utils::encode_base36(HASH_OUTPUT);
+        info.validation_backend = validation::backend_name(validation::detect_backend());
+        info.fingerprint_size = Fingerprint::get().size();
 
-        return format_result(PREFIX, ENCODED, MAX_LENGTH);
+        return info;
     }
 } // namespace visus::cuid2
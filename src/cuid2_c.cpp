@@ -0,0 +1,136 @@
+/// @file cuid2_c.cpp
+/// @brief C interface implementation
+///
+/// Thin wrappers that forward to the C++ API and translate its exceptions
+/// into cuid2_status codes, so that no exception ever crosses the C boundary.
+/// The wrappers add no copies: identifiers are written straight into the
+/// caller's buffer by the per-thread default generator.
+
+#include "cuid2/cuid2.h"
+
+#include <cstdint>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+#include "cuid2/cuid2.hpp"
+
+namespace {
+    /// Runs a call and maps any exception it throws to a status code.
+    ///
+    /// @param call Callable to run
+    /// @return CUID2_OK if call returned normally, otherwise the status
+    ///         matching the exception type
+    template <typename Call>
+    int guarded(Call&& call) noexcept {
+        try {
+            call();
+            return CUID2_OK;
+        } catch (const std::invalid_argument&) {
+            return CUID2_ERROR_INVALID_ARGUMENT;
+        } catch (const std::bad_alloc&) {
+            return CUID2_ERROR_OUT_OF_MEMORY; // GCOVR_EXCL_LINE
+        } catch (const std::runtime_error&) {
+            return CUID2_ERROR_RUNTIME;
+        } catch (...) {
+            return CUID2_ERROR_UNKNOWN;
+        }
+    }
+} // anonymous namespace
+
+extern "C" {
+    /// Returns the version of the C interface implemented by this build.
+    ///
+    /// @return CUID2_C_API_VERSION
+    int cuid2_abi_version(void) {
+        return CUID2_C_API_VERSION;
+    }
+
+    /// Writes one identifier of the given length into caller memory.
+    ///
+    /// @param out Destination for length characters
+    /// @param length Identifier length (min: 4, max: 32)
+    /// @return CUID2_OK or a negative cuid2_status
+    int cuid2_generate_into(char* out, const size_t length) {
+        if (out == nullptr) [[unlikely]] {
+            return CUID2_ERROR_INVALID_ARGUMENT;
+        }
+
+        return guarded([&] { visus::cuid2::generate_into(out, length); });
+    }
+
+    /// Writes count identifiers as fixed-width records at a fixed stride.
+    ///
+    /// The buffer size implied by stride, count and length is computed here,
+    /// rejecting combinations whose extent does not fit in size_t, and the
+    /// remaining checks are left to generate_batch_into().
+    ///
+    /// @param buf Destination for count records; may be NULL if count is 0
+    /// @param stride Distance in bytes between consecutive records
+    /// @param count Number of identifiers to write
+    /// @param length Identifier length (min: 4, max: 32)
+    /// @return CUID2_OK or a negative cuid2_status
+    int cuid2_generate_batch(char* buf, const size_t stride, const size_t count, const int length) {
+        if (length < CUID2_MIN_LENGTH || length > CUID2_MAX_LENGTH) [[unlikely]] {
+            return CUID2_ERROR_INVALID_ARGUMENT;
+        }
+
+        const auto RECORD_LENGTH = static_cast<size_t>(length);
+        if (stride < RECORD_LENGTH) [[unlikely]] {
+            return CUID2_ERROR_INVALID_ARGUMENT;
+        }
+
+        if (count == 0) {
+            return CUID2_OK;
+        }
+
+        if (buf == nullptr || (SIZE_MAX - RECORD_LENGTH) / stride < count - 1) [[unlikely]] {
+            return CUID2_ERROR_INVALID_ARGUMENT;
+        }
+
+        const std::span<char> COLUMN(buf, (count - 1) * stride + RECORD_LENGTH);
+
+        return guarded([&] { visus::cuid2::generate_batch_into(COLUMN, stride, count, length); });
+    }
+
+    /// Checks whether size bytes of text form a well-formed identifier.
+    ///
+    /// @param text Text to check; may be NULL if size is 0
+    /// @param size Number of bytes of text
+    /// @param expected_length Required length, or CUID2_ANY_LENGTH
+    /// @return 1 if valid, 0 otherwise
+    int cuid2_is_cuid2(const char* text, const size_t size, const int expected_length) {
+        if (text == nullptr) {
+            return 0;
+        }
+
+        return visus::cuid2::is_cuid2(std::string_view(text, size), expected_length) ? 1 : 0;
+    }
+
+    /// Refreshes all process-derived state, as after fork().
+    void cuid2_reseed(void) {
+        visus::cuid2::reseed();
+    }
+
+    /// Describes a status code.
+    ///
+    /// @param status Value returned by another function of this interface
+    /// @return Static description; never NULL
+    const char* cuid2_strerror(const int status) {
+        switch (status) {
+            case CUID2_OK:
+                return "success";
+            case CUID2_ERROR_INVALID_ARGUMENT:
+                return "invalid argument";
+            case CUID2_ERROR_RUNTIME:
+                return "random source or digest failure";
+            case CUID2_ERROR_OUT_OF_MEMORY:
+                return "out of memory";
+            case CUID2_ERROR_UNKNOWN:
+                return "unknown error";
+            default:
+                return "unrecognized status code";
+        }
+    }
+} // extern "C"
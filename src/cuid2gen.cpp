@@ -1,24 +1,120 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
 #include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
 #include <string_view>
 #include <system_error>
+#include <thread>
+#include <vector>
 
 #include "cuid2/cuid2.hpp"
+#include "cuid2/generator.hpp"
 
 #include <fmt/core.h>
 
 namespace {
+    /// Output is handed to stdout in chunks of at least this many bytes.
+    constexpr size_t CHUNK_BYTES = size_t{1} << 20;
+
+    /// Identifiers generated per batch call and claimed per work item.
+    constexpr uint64_t BATCH_SIZE = 4096;
+
+    /// Upper bound for --threads.
+    constexpr unsigned MAX_THREADS = 1024;
+
+    /// Default and maximum duration of each --benchmark run in seconds.
+    constexpr unsigned DEFAULT_BENCHMARK_SECONDS = 2;
+    constexpr unsigned MAX_BENCHMARK_SECONDS = 3600;
+
+    /// Record layout written for each identifier.
+    enum class Format {
+        lines,
+        nul,
+        json,
+        csv,
+    };
+
+    /// Parsed command-line options.
+    struct Options {
+        int length = visus::cuid2::DEFAULT_LENGTH;
+        uint64_t count = 1;
+        unsigned threads = 1;
+        Format format = Format::lines;
+        unsigned benchmark_seconds = 0;
+        bool sortable = false;
+
+        /// Whether -n or -f was given; neither applies to --benchmark.
+        bool output_options = false;
+    };
+
+    /// Throughput and per-call latency of one benchmark run.
+    struct BenchmarkResult {
+        unsigned threads = 0;
+        uint64_t calls = 0;
+        double seconds = 0.0;
+        uint64_t p50 = 0;
+        uint64_t p99 = 0;
+        uint64_t p999 = 0;
+    };
+
+    /// State shared by the workers of one streaming run.
+    struct StreamState {
+        explicit StreamState(const Options& OPTIONS) noexcept : options(OPTIONS) {}
+
+        const Options& options;
+
+        /// Index of the next identifier to claim.
+        std::atomic<uint64_t> next{0};
+
+        /// Set when any worker fails; the others stop at their next batch.
+        std::atomic<bool> failed{false};
+
+        /// Serializes writes to stdout and the fields below.
+        std::mutex output_mutex;
+
+        /// Whether no record has been written yet (JSON omits the first separator).
+        bool first_record = true;
+
+        /// errno of the first failed write, or 0.
+        int write_error = 0;
+
+        /// First exception thrown by a worker.
+        std::exception_ptr error;
+    };
+
     void print_help(std::string_view program_name) noexcept {
         fmt::print(
             "Usage: {} [OPTIONS]\n\n"
-            "Generate a collision-resistant CUID2 identifier.\n\n"
+            "Generate collision-resistant CUID2 identifiers.\n\n"
             "Options:\n"
             "  -l, --length <num>   Length of the generated ID (default: 24, min: 4, max: 32)\n"
+            "  -n, --count <num>    Number of IDs to generate (default: 1)\n"
+            "  -t, --threads <num>  Worker threads used to generate IDs (default: 1, max: {})\n"
+            "  -f, --format <fmt>   Output format: lines, nul, json or csv (default: lines)\n"
+            "  -s, --sortable       Lead each ID with its creation time (min length: {})\n"
+            "  --benchmark [secs]   Measure generate() throughput and latency instead (default: {} s per run)\n"
             "  -h, --help           Display this help message and exit\n\n"
             "Examples:\n"
             "  {}                 # Generate default length (24) CUID2\n"
             "  {} -l 16           # Generate 16-character CUID2\n"
-            "  {} --length 32     # Generate maximum length (32) CUID2\n",
-            program_name, program_name, program_name, program_name);
+            "  {} --length 32     # Generate maximum length (32) CUID2\n"
+            "  {} -n 1000000 -t 4 # Stream one million IDs using four threads\n"
+            "  {} -n 10 -f json   # Print ten IDs as a JSON array\n"
+            "  {} -n 1000 -s      # Print time-ordered IDs for B-tree keys\n"
+            "  {} --benchmark 5   # Report IDs/sec and latency percentiles\n",
+            program_name, MAX_THREADS, visus::cuid2::MIN_SORTABLE_LENGTH, DEFAULT_BENCHMARK_SECONDS, program_name,
+            program_name, program_name, program_name, program_name, program_name, program_name);
     }
 
     [[nodiscard]] constexpr bool is_help_flag(std::string_view arg) noexcept {
@@ -28,12 +124,401 @@ namespace {
     [[nodiscard]] constexpr bool is_length_flag(std::string_view arg) noexcept {
         return arg == "-l" || arg == "--length";
     }
+
+    [[nodiscard]] constexpr bool is_count_flag(std::string_view arg) noexcept {
+        return arg == "-n" || arg == "--count";
+    }
+
+    [[nodiscard]] constexpr bool is_threads_flag(std::string_view arg) noexcept {
+        return arg == "-t" || arg == "--threads";
+    }
+
+    [[nodiscard]] constexpr bool is_format_flag(std::string_view arg) noexcept {
+        return arg == "-f" || arg == "--format";
+    }
+
+    [[nodiscard]] constexpr bool is_sortable_flag(std::string_view arg) noexcept {
+        return arg == "-s" || arg == "--sortable";
+    }
+
+    [[nodiscard]] constexpr bool is_benchmark_flag(std::string_view arg) noexcept {
+        return arg == "--benchmark";
+    }
+
+    /// Parses the whole of VALUE as a decimal integer.
+    ///
+    /// @return true if VALUE is a valid number representable by T
+    template <typename T>
+    [[nodiscard]] bool parse_number(std::string_view VALUE, T& out) noexcept {
+        const auto [ptr, ec] = std::from_chars(VALUE.data(), VALUE.data() + VALUE.size(), out);
+
+        return ec == std::errc{} && ptr == VALUE.data() + VALUE.size();
+    }
+
+    [[nodiscard]] bool parse_format(std::string_view VALUE, Format& out) noexcept {
+        if (VALUE == "lines") {
+            out = Format::lines;
+        } else if (VALUE == "nul") {
+            out = Format::nul;
+        } else if (VALUE == "json") {
+            out = Format::json;
+        } else if (VALUE == "csv") {
+            out = Format::csv;
+        } else {
+            return false;
+        }
+
+        return true;
+    }
+
+    /// Appends one identifier in the requested format.
+    ///
+    /// JSON records carry their leading separator; write_chunk() drops it from
+    /// the first record of the document.
+    void append_record(std::string& buffer, std::string_view id, const Format FORMAT) {
+        switch (FORMAT) {
+            case Format::lines:
+            case Format::csv:
+                buffer.append(id);
+                buffer.push_back('\n');
+                break;
+            case Format::nul:
+                buffer.append(id);
+                buffer.push_back('\0');
+                break;
+            case Format::json:
+                buffer.append(",\n\"");
+                buffer.append(id);
+                buffer.push_back('"');
+                break;
+        }
+    }
+
+    /// Writes raw bytes to stdout, recording errno on a short write.
+    ///
+    /// @return true if every byte was written
+    bool write_stdout(StreamState& state, std::string_view data) noexcept {
+        if (std::fwrite(data.data(), 1, data.size(), stdout) != data.size()) [[unlikely]] {
+            // GCOVR_EXCL_START
+            state.write_error = errno != 0 ? errno : EIO;
+            state.failed.store(true, std::memory_order_relaxed);
+            return false;
+            // GCOVR_EXCL_STOP
+        }
+
+        return true;
+    }
+
+    /// Hands a filled buffer to stdout in a single write and clears it.
+    void write_chunk(StreamState& state, std::string& buffer) {
+        std::string_view data{buffer};
+
+        {
+            const std::scoped_lock LOCK(state.output_mutex);
+
+            if (state.first_record && state.options.format == Format::json) {
+                data.remove_prefix(1);
+            }
+            state.first_record = false;
+
+            write_stdout(state, data);
+        }
+
+        buffer.clear();
+    }
+
+    /// Claims batches of identifiers until the requested count is reached.
+    ///
+    /// Each worker owns a Generator, so the hot loop shares nothing but the
+    /// claim counter and the output lock taken once per chunk.
+    void run_worker(StreamState& state) {
+        const Options& OPTIONS = state.options;
+
+        try {
+            visus::cuid2::Generator generator(
+                visus::cuid2::GeneratorOptions{.length = OPTIONS.length, .sortable = OPTIONS.sortable});
+
+            std::vector<std::string> ids(static_cast<size_t>(std::min(BATCH_SIZE, OPTIONS.count)));
+            std::string buffer;
+            buffer.reserve(CHUNK_BYTES + BATCH_SIZE * (visus::cuid2::MAX_CUID2_LENGTH + 4));
+
+            while (!state.failed.load(std::memory_order_relaxed)) {
+                const uint64_t START = state.next.fetch_add(BATCH_SIZE, std::memory_order_relaxed);
+                if (START >= OPTIONS.count) {
+                    break;
+                }
+
+                const auto BATCH = static_cast<size_t>(std::min(BATCH_SIZE, OPTIONS.count - START));
+                const auto IDS = std::span(ids).first(BATCH);
+
+                generator.next_batch(IDS);
+
+                for (const auto& id : IDS) {
+                    append_record(buffer, id, OPTIONS.format);
+                }
+
+                if (buffer.size() >= CHUNK_BYTES) {
+                    write_chunk(state, buffer);
+                }
+            }
+
+            if (!buffer.empty() && !state.failed.load(std::memory_order_relaxed)) {
+                write_chunk(state, buffer);
+            }
+        } catch (...) {
+            // GCOVR_EXCL_START
+            const std::scoped_lock LOCK(state.output_mutex);
+            if (!state.error) {
+                state.error = std::current_exception();
+            }
+            state.failed.store(true, std::memory_order_relaxed);
+            // GCOVR_EXCL_STOP
+        }
+    }
+
+    /// Generates OPTIONS.count identifiers and streams them to stdout.
+    ///
+    /// @return Process exit status
+    int stream_identifiers(const Options& OPTIONS) {
+        StreamState state(OPTIONS);
+
+        if (OPTIONS.format == Format::json) {
+            write_stdout(state, "[");
+        } else if (OPTIONS.format == Format::csv) {
+            write_stdout(state, "id\n");
+        }
+
+        // No point starting more workers than there are batches
+        const uint64_t BATCHES = (OPTIONS.count + BATCH_SIZE - 1) / BATCH_SIZE;
+        const auto THREADS = static_cast<unsigned>(std::min<uint64_t>(OPTIONS.threads, BATCHES));
+
+        if (THREADS <= 1) {
+            run_worker(state);
+        } else {
+            std::vector<std::thread> workers;
+            workers.reserve(THREADS);
+
+            for (unsigned idx = 0; idx < THREADS; ++idx) {
+                workers.emplace_back(run_worker, std::ref(state));
+            }
+
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        if (!state.failed.load(std::memory_order_relaxed) && OPTIONS.format == Format::json) {
+            write_stdout(state, "\n]\n");
+        }
+
+        if (std::fflush(stdout) != 0 && state.write_error == 0) [[unlikely]] {
+            // GCOVR_EXCL_START
+            state.write_error = errno != 0 ? errno : EIO;
+            // GCOVR_EXCL_STOP
+        }
+
+        if (state.error) {
+            std::rethrow_exception(state.error);
+        }
+
+        if (state.write_error != 0) [[unlikely]] {
+            // GCOVR_EXCL_START
+            fmt::print(stderr, "Error: Failed to write output: {}\n", std::strerror(state.write_error));
+            return 1;
+            // GCOVR_EXCL_STOP
+        }
+
+        return 0;
+    }
+
+    /// Log-bucketed latency histogram with a fixed footprint.
+    ///
+    /// Values below SUB_BUCKETS nanoseconds get a bucket each; above that, each
+    /// power of two is split into SUB_BUCKETS / 2 linear buckets, so a recorded
+    /// value is off by less than 1/64 of itself (in the style of HdrHistogram).
+    /// Memory stays constant whatever the run duration, and per-thread
+    /// histograms merge by adding counts.
+    class LatencyHistogram {
+    public:
+        /// Records one latency in nanoseconds.
+        void record(const uint32_t NANOSECONDS) noexcept {
+            ++counts_[bucket_index(NANOSECONDS)];
+            ++total_;
+        }
+
+        /// Adds every sample recorded by OTHER.
+        void merge(const LatencyHistogram& OTHER) noexcept {
+            for (size_t i = 0; i < BUCKETS; ++i) {
+                counts_[i] += OTHER.counts_[i];
+            }
+            total_ += OTHER.total_;
+        }
+
+        /// Number of recorded samples.
+        [[nodiscard]] uint64_t count() const noexcept {
+            return total_;
+        }
+
+        /// Returns the sample at quantile Q (nearest rank), reported as the
+        /// highest value of its bucket.
+        [[nodiscard]] uint64_t percentile(const double Q) const noexcept {
+            const auto RANK = std::min(static_cast<uint64_t>(Q * static_cast<double>(total_)), total_ - 1);
+
+            uint64_t seen = 0;
+            for (size_t i = 0; i < BUCKETS; ++i) {
+                seen += counts_[i];
+
+                if (seen > RANK) {
+                    return bucket_highest(i);
+                }
+            }
+
+            return bucket_highest(BUCKETS - 1); // GCOVR_EXCL_LINE
+        }
+
+    private:
+        /// Linear buckets below the first power-of-two range.
+        static constexpr size_t SUB_BUCKETS = 128;
+        static constexpr size_t HALF_BUCKETS = SUB_BUCKETS / 2;
+        static constexpr int SUB_BUCKET_BITS = 7;
+
+        /// Enough buckets for every uint32_t value.
+        static constexpr size_t BUCKETS = SUB_BUCKETS + ((32 - SUB_BUCKET_BITS) * HALF_BUCKETS);
+
+        [[nodiscard]] static size_t bucket_index(const uint32_t VALUE) noexcept {
+            if (VALUE < SUB_BUCKETS) {
+                return VALUE;
+            }
+
+            const int SHIFT = std::bit_width(VALUE) - SUB_BUCKET_BITS;
+            return SUB_BUCKETS + (static_cast<size_t>(SHIFT - 1) * HALF_BUCKETS) + ((VALUE >> SHIFT) - HALF_BUCKETS);
+        }
+
+        [[nodiscard]] static uint64_t bucket_highest(const size_t INDEX) noexcept {
+            if (INDEX < SUB_BUCKETS) {
+                return INDEX;
+            }
+
+            const size_t SHIFT = ((INDEX - SUB_BUCKETS) / HALF_BUCKETS) + 1;
+            const uint64_t MANTISSA = ((INDEX - SUB_BUCKETS) % HALF_BUCKETS) + HALF_BUCKETS;
+            return ((MANTISSA + 1) << SHIFT) - 1;
+        }
+
+        std::array<uint64_t, BUCKETS> counts_{};
+        uint64_t total_ = 0;
+    };
+
+    /// Calls generate() on THREADS threads for SECONDS and times every call.
+    ///
+    /// With SORTABLE, each thread calls next() on its own sortable Generator
+    /// drawing from the process-wide counter instead, as generate() does.
+    /// Latencies go into a fixed-size histogram per thread, merged afterwards,
+    /// so the only shared state while measuring is the library itself and
+    /// memory does not grow with the duration.
+    BenchmarkResult run_benchmark(const unsigned THREADS, const unsigned SECONDS, const int LENGTH,
+                                  const bool SORTABLE) {
+        using clock = std::chrono::steady_clock;
+
+        std::vector<LatencyHistogram> latencies(THREADS);
+        const auto START = clock::now();
+        const auto DEADLINE = START + std::chrono::seconds(SECONDS);
+
+        const auto MEASURE = [&](LatencyHistogram& histogram) {
+            std::optional<visus::cuid2::Generator> generator;
+            if (SORTABLE) {
+                generator.emplace(visus::cuid2::GeneratorOptions{
+                    .length = LENGTH, .shared_counter = true, .sortable = true});
+            }
+
+            for (auto now = clock::now(); now < DEADLINE;) {
+                const auto BEFORE = now;
+                const std::string ID = generator ? generator->next() : visus::cuid2::generate(LENGTH);
+                now = clock::now();
+
+                const auto ELAPSED = std::chrono::duration_cast<std::chrono::nanoseconds>(now - BEFORE).count();
+                histogram.record(static_cast<uint32_t>(std::min<int64_t>(ELAPSED, UINT32_MAX)));
+            }
+        };
+
+        if (THREADS == 1) {
+            MEASURE(latencies.front());
+        } else {
+            std::vector<std::thread> workers;
+            workers.reserve(THREADS);
+
+            for (auto& histogram : latencies) {
+                workers.emplace_back(MEASURE, std::ref(histogram));
+            }
+
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        const std::chrono::duration<double> ELAPSED = clock::now() - START;
+
+        LatencyHistogram merged;
+        for (const auto& histogram : latencies) {
+            merged.merge(histogram);
+        }
+
+        BenchmarkResult result;
+        result.threads = THREADS;
+        result.calls = merged.count();
+        result.seconds = ELAPSED.count();
+
+        if (merged.count() > 0) {
+            result.p50 = merged.percentile(0.50);
+            result.p99 = merged.percentile(0.99);
+            result.p999 = merged.percentile(0.999);
+        }
+
+        return result;
+    }
+
+    /// Runs the self-test benchmark and prints a report to stdout.
+    ///
+    /// One single-threaded run is followed by a run on --threads threads, or on
+    /// every hardware thread (at least two) when --threads is not above 1.
+    ///
+    /// @return Process exit status
+    int benchmark_identifiers(const Options& OPTIONS) {
+        const visus::cuid2::BackendInfo INFO = visus::cuid2::backend_info();
+        const unsigned HARDWARE_THREADS = std::thread::hardware_concurrency();
+        const unsigned MULTI_THREADS = OPTIONS.threads > 1 ? OPTIONS.threads : std::max(2U, HARDWARE_THREADS);
+
+        fmt::print(
+            "cuid2gen benchmark: {}({}), {} s per run\n\n"
+            "  Layout:            {}\n"
+            "  Crypto library:    {}\n"
+            "  Hash backend:      {}\n"
+            "  Batch hash:        {}\n"
+            "  Random source:     {}\n"
+            "  Validation:        {}\n"
+            "  Fingerprint size:  {} bytes\n"
+            "  Hardware threads:  {}\n\n",
+            OPTIONS.sortable ? "Generator::next" : "generate", OPTIONS.length, OPTIONS.benchmark_seconds,
+            OPTIONS.sortable ? "sortable" : "default", INFO.crypto_library, INFO.hash_backend,
+            INFO.batch_hash_backend, INFO.random_backend, INFO.validation_backend, INFO.fingerprint_size,
+            HARDWARE_THREADS);
+
+        fmt::print("  {:>7}  {:>12}  {:>10}  {:>10}  {:>10}\n", "threads", "IDs/sec", "p50 ns", "p99 ns", "p999 ns");
+
+        for (const unsigned THREADS : {1U, MULTI_THREADS}) {
+            const BenchmarkResult RESULT = run_benchmark(THREADS, OPTIONS.benchmark_seconds, OPTIONS.length, OPTIONS.sortable);
+            const double RATE = RESULT.seconds > 0.0 ? static_cast<double>(RESULT.calls) / RESULT.seconds : 0.0;
+
+            fmt::print("  {:>7}  {:>12.0f}  {:>10}  {:>10}  {:>10}\n",
+                RESULT.threads, RATE, RESULT.p50, RESULT.p99, RESULT.p999);
+            std::fflush(stdout);
+        }
+
+        return 0;
+    }
 } // anonymous namespace
 
 int main(const int argc, char* argv[]) {
-    using namespace visus::cuid2;
-
-    int length = DEFAULT_LENGTH;
+    Options options;
 
     int i = 1;
     while (i < argc) {
@@ -44,38 +529,97 @@ int main(const int argc, char* argv[]) {
             return 0;
         }
 
-        if (is_length_flag(ARG)) {
-            if (i + 1 >= argc) {
-                fmt::print(stderr, "Error: {} requires an argument\n\n", ARG);
-                print_help(argv[0]);
-                return 1;
-            }
+        if (is_sortable_flag(ARG)) {
+            options.sortable = true;
+            ++i;
+            continue;
+        }
 
+        if (is_benchmark_flag(ARG)) {
+            options.benchmark_seconds = DEFAULT_BENCHMARK_SECONDS;
             ++i;
-            const std::string_view LENGTH_ARG{argv[i]};
-            const auto [ptr, ec] = std::from_chars(
-                LENGTH_ARG.data(),
-                LENGTH_ARG.data() + LENGTH_ARG.size(),
-                length);
-
-            if (ec != std::errc{} || ptr != LENGTH_ARG.data() + LENGTH_ARG.size()) {
-                fmt::print(stderr, "Error: Invalid length value '{}'\n\n", LENGTH_ARG);
-                print_help(argv[0]);
-                return 1;
+
+            // The duration is optional, so only a following non-option is consumed
+            if (i < argc && argv[i][0] != '-') {
+                const std::string_view VALUE{argv[i]};
+
+                if (!parse_number(VALUE, options.benchmark_seconds) || options.benchmark_seconds == 0 ||
+                    options.benchmark_seconds > MAX_BENCHMARK_SECONDS) {
+                    fmt::print(stderr, "Error: Invalid benchmark duration '{}'\n\n", VALUE);
+                    print_help(argv[0]);
+                    return 1;
+                }
+
+                ++i;
             }
 
-            ++i;
             continue;
         }
 
-        fmt::print(stderr, "Error: Unknown option '{}'\n\n", ARG);
+        if (!is_length_flag(ARG) && !is_count_flag(ARG) && !is_threads_flag(ARG) && !is_format_flag(ARG)) {
+            fmt::print(stderr, "Error: Unknown option '{}'\n\n", ARG);
+            print_help(argv[0]);
+            return 1;
+        }
+
+        if (i + 1 >= argc) {
+            fmt::print(stderr, "Error: {} requires an argument\n\n", ARG);
+            print_help(argv[0]);
+            return 1;
+        }
+
+        ++i;
+        const std::string_view VALUE{argv[i]};
+
+        if (is_length_flag(ARG) &&
+            (!parse_number(VALUE, options.length) || options.length < visus::cuid2::MIN_CUID2_LENGTH ||
+             options.length > visus::cuid2::MAX_CUID2_LENGTH)) {
+            fmt::print(stderr, "Error: Invalid length value '{}'\n\n", VALUE);
+            print_help(argv[0]);
+            return 1;
+        }
+
+        if (is_count_flag(ARG) && (!parse_number(VALUE, options.count) || options.count == 0)) {
+            fmt::print(stderr, "Error: Invalid count value '{}'\n\n", VALUE);
+            print_help(argv[0]);
+            return 1;
+        }
+
+        if (is_threads_flag(ARG) &&
+            (!parse_number(VALUE, options.threads) || options.threads == 0 || options.threads > MAX_THREADS)) {
+            fmt::print(stderr, "Error: Invalid threads value '{}'\n\n", VALUE);
+            print_help(argv[0]);
+            return 1;
+        }
+
+        if (is_format_flag(ARG) && !parse_format(VALUE, options.format)) {
+            fmt::print(stderr, "Error: Invalid format '{}'\n\n", VALUE);
+            print_help(argv[0]);
+            return 1;
+        }
+
+        options.output_options = options.output_options || is_count_flag(ARG) || is_format_flag(ARG);
+        ++i;
+    }
+
+    if (options.benchmark_seconds > 0 && options.output_options) {
+        fmt::print(stderr, "Error: --benchmark cannot be combined with -n/--count or -f/--format\n\n");
+        print_help(argv[0]);
+        return 1;
+    }
+
+    if (options.sortable && options.length < visus::cuid2::MIN_SORTABLE_LENGTH) {
+        fmt::print(stderr, "Error: --sortable needs a length of at least {}\n\n", visus::cuid2::MIN_SORTABLE_LENGTH);
         print_help(argv[0]);
         return 1;
     }
 
     try {
-        fmt::print("{}\n", generate(length));
-        return 0;
+        if (options.benchmark_seconds > 0) {
+            return benchmark_identifiers(options);
+        }
+
+        return stream_identifiers(options);
     } catch (const std::exception& e) {
         fmt::print(stderr, "Error: {}\n", e.what());
         return 1;
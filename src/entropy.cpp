@@ -0,0 +1,351 @@
+/// @file entropy.cpp
+/// @brief Built-in entropy sources
+///
+/// This file implements the EntropySource backends selectable through
+/// platform::set_entropy_source():
+/// - OpenSSL RAND_bytes(), the default
+/// - The operating system CSPRNG (getrandom(), arc4random_buf() or
+///   BCryptGenRandom())
+/// - ChaCha20 and AES-256-CTR keystream generators with fast key erasure,
+///   keyed from RAND_bytes() or, for replay, from a caller-provided seed
+///
+/// The cipher algorithms are fetched explicitly once per process, as the
+/// SHA3-512 digest is in hash.cpp.
+
+#include "cuid2/platform.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+#ifdef _WIN32
+    #include <windows.h> // NOSONAR(S3806) - Microsoft uses lowercase windows.h
+    #include <bcrypt.h>
+#elif defined(__linux__)
+    #include <sys/random.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+    #include <stdlib.h> // NOLINT(modernize-deprecated-headers) - arc4random_buf() is not in <cstdlib>
+#endif
+
+namespace visus::cuid2::platform {
+    namespace {
+        /// Largest request passed to a single OpenSSL call, which takes an int.
+        constexpr size_t MAX_OPENSSL_CHUNK = INT_MAX / 2;
+
+        /// Key size in bytes of both stream ciphers.
+        constexpr size_t KEY_SIZE = 32;
+
+        /// IV size in bytes of both stream ciphers; for ChaCha20 the block
+        /// counter followed by the nonce.
+        constexpr size_t IV_SIZE = 16;
+
+        /// Key and IV, drawn together.
+        using CipherState = std::array<uint8_t, KEY_SIZE + IV_SIZE>;
+
+        static_assert(ENTROPY_SEED_SIZE == KEY_SIZE, "a seed is exactly one cipher key");
+
+        /// Fills a buffer from RAND_bytes().
+        ///
+        /// @param out Buffer to fill
+        /// @throws std::runtime_error if the OpenSSL DRBG fails
+        void openssl_fill(const std::span<uint8_t> out) {
+            for (size_t offset = 0; offset < out.size(); offset += MAX_OPENSSL_CHUNK) {
+                const size_t CHUNK = std::min(MAX_OPENSSL_CHUNK, out.size() - offset);
+
+                if (RAND_bytes(out.data() + offset, static_cast<int>(CHUNK)) != 1) [[unlikely]] {
+                    // GCOVR_EXCL_START - CSPRNG failure
+                    throw std::runtime_error("RAND_bytes failed");
+                    // GCOVR_EXCL_STOP
+                }
+            }
+        }
+
+        /// OpenSSL RAND_bytes().
+        class OpenSslSource final : public EntropySource {
+        public:
+            void fill(const std::span<uint8_t> out) override {
+                openssl_fill(out);
+            }
+
+            [[nodiscard]] std::string_view name() const noexcept override {
+                return "OpenSSL RAND_bytes";
+            }
+        };
+
+        /// Operating system CSPRNG, bypassing OpenSSL.
+        class SystemSource final : public EntropySource {
+        public:
+            void fill(const std::span<uint8_t> out) override {
+#ifdef _WIN32
+                constexpr size_t MAX_CHUNK = ULONG_MAX;
+
+                for (size_t offset = 0; offset < out.size(); offset += MAX_CHUNK) {
+                    const size_t CHUNK = std::min(MAX_CHUNK, out.size() - offset);
+                    const NTSTATUS STATUS = BCryptGenRandom(nullptr, out.data() + offset, static_cast<ULONG>(CHUNK),
+                                                            BCRYPT_USE_SYSTEM_PREFERRED_RNG);
+
+                    if (!BCRYPT_SUCCESS(STATUS)) [[unlikely]] {
+                        throw std::runtime_error("BCryptGenRandom failed");
+                    }
+                }
+#elif defined(__linux__)
+                size_t offset = 0;
+
+                while (offset < out.size()) {
+                    const ssize_t RESULT = getrandom(out.data() + offset, out.size() - offset, 0);
+
+                    if (RESULT < 0) [[unlikely]] {
+                        // GCOVR_EXCL_START - interrupted or unavailable syscall
+                        if (errno == EINTR) {
+                            continue;
+                        }
+
+                        throw std::runtime_error(std::string("getrandom failed: ") + std::strerror(errno));
+                        // GCOVR_EXCL_STOP
+                    }
+
+                    offset += static_cast<size_t>(RESULT);
+                }
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+                arc4random_buf(out.data(), out.size());
+#else
+                openssl_fill(out);
+#endif
+            }
+
+            [[nodiscard]] std::string_view name() const noexcept override {
+#ifdef _WIN32
+                return "BCryptGenRandom";
+#elif defined(__linux__)
+                return "getrandom";
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+                return "arc4random_buf";
+#else
+                return "OpenSSL RAND_bytes";
+#endif
+            }
+        };
+
+        /// RAII deleter for an explicitly fetched OpenSSL cipher algorithm.
+        struct EVPCipherDeleter {
+            void operator()(EVP_CIPHER* cipher) const noexcept {
+#if OPENSSL_VERSION_MAJOR >= 3
+                EVP_CIPHER_free(cipher);
+#else
+                static_cast<void>(cipher);
+#endif
+            }
+        };
+
+        /// RAII deleter for an OpenSSL cipher context; freeing it also wipes
+        /// the key schedule.
+        struct EVPCipherContextDeleter {
+            void operator()(EVP_CIPHER_CTX* ctx) const noexcept {
+                EVP_CIPHER_CTX_free(ctx);
+            }
+        };
+
+        /// Fetches a stream cipher from the default provider.
+        ///
+        /// @param BACKEND EntropyBackend::chacha20 or EntropyBackend::aes_ctr
+        /// @return Owning handle for the algorithm (may be null on failure)
+        std::unique_ptr<EVP_CIPHER, EVPCipherDeleter> fetch_cipher(const EntropyBackend BACKEND) noexcept {
+            const bool CHACHA = BACKEND == EntropyBackend::chacha20;
+
+#if OPENSSL_VERSION_MAJOR >= 3
+            return std::unique_ptr<EVP_CIPHER, EVPCipherDeleter>(
+                EVP_CIPHER_fetch(nullptr, CHACHA ? "ChaCha20" : "AES-256-CTR", nullptr));
+#else
+            return std::unique_ptr<EVP_CIPHER, EVPCipherDeleter>(
+                const_cast<EVP_CIPHER*>(CHACHA ? EVP_chacha20() : EVP_aes_256_ctr()));
+#endif
+        }
+
+        /// Returns the process-wide algorithm object of a stream cipher.
+        ///
+        /// @param BACKEND EntropyBackend::chacha20 or EntropyBackend::aes_ctr
+        /// @return Fetched cipher algorithm
+        /// @throws std::runtime_error if no provider offers the cipher
+        const EVP_CIPHER* stream_cipher(const EntropyBackend BACKEND) {
+            static const auto CHACHA20 = fetch_cipher(EntropyBackend::chacha20);
+            static const auto AES_CTR = fetch_cipher(EntropyBackend::aes_ctr);
+
+            const EVP_CIPHER* cipher = BACKEND == EntropyBackend::chacha20 ? CHACHA20.get() : AES_CTR.get();
+            if (cipher == nullptr) [[unlikely]] {
+                // GCOVR_EXCL_START - default provider always offers both ciphers
+                throw std::runtime_error("stream cipher is not available from the OpenSSL provider");
+                // GCOVR_EXCL_STOP
+            }
+
+            return cipher;
+        }
+
+        /// Keystream generator with fast key erasure.
+        ///
+        /// Every request is answered with fresh keystream, after which the
+        /// next key and IV are taken from the keystream too. The state held
+        /// between requests therefore never allows earlier output to be
+        /// reconstructed, and a request costs one cipher update plus one
+        /// re-key, which is why the per-thread buffer in front of the source
+        /// matters.
+        class CipherDrbg final : public EntropySource {
+            std::unique_ptr<EVP_CIPHER_CTX, EVPCipherContextDeleter> ctx_{EVP_CIPHER_CTX_new()};
+            const EVP_CIPHER* cipher_;
+            std::string_view name_;
+
+            /// Whether the key is replaced from RAND_bytes() periodically.
+            bool reseeding_;
+
+            /// Bytes left before the next reseed.
+            size_t until_reseed_ = 0;
+
+        public:
+            /// Creates a generator keyed from RAND_bytes().
+            ///
+            /// @param BACKEND EntropyBackend::chacha20 or EntropyBackend::aes_ctr
+            explicit CipherDrbg(const EntropyBackend BACKEND)
+                : cipher_(stream_cipher(BACKEND)), name_(drbg_name(BACKEND)), reseeding_(true) {
+                check_context();
+                reseed();
+            }
+
+            /// Creates a deterministic generator keyed from seed.
+            ///
+            /// @param BACKEND EntropyBackend::chacha20 or EntropyBackend::aes_ctr
+            /// @param SEED ENTROPY_SEED_SIZE bytes used as the key; the IV is zero
+            CipherDrbg(const EntropyBackend BACKEND, const std::span<const uint8_t> SEED)
+                : cipher_(stream_cipher(BACKEND)), name_(drbg_name(BACKEND)), reseeding_(false) {
+                check_context();
+
+                CipherState state{};
+                std::ranges::copy(SEED, state.begin());
+                rekey(state);
+            }
+
+            void fill(const std::span<uint8_t> out) override {
+                if (reseeding_) {
+                    if (until_reseed_ < out.size()) [[unlikely]] {
+                        reseed();
+                    }
+
+                    until_reseed_ -= std::min(until_reseed_, out.size());
+                }
+
+                keystream(out);
+
+                CipherState next{};
+                keystream(next);
+                rekey(next);
+            }
+
+            [[nodiscard]] std::string_view name() const noexcept override {
+                return name_;
+            }
+
+        private:
+            /// Returns the reported name of a keystream backend.
+            static std::string_view drbg_name(const EntropyBackend BACKEND) noexcept {
+                return BACKEND == EntropyBackend::chacha20 ? "ChaCha20 DRBG" : "AES-256-CTR DRBG";
+            }
+
+            void check_context() const {
+                if (ctx_ == nullptr) [[unlikely]] {
+                    // GCOVR_EXCL_START - allocation failure
+                    throw std::runtime_error("Failed to allocate cipher context");
+                    // GCOVR_EXCL_STOP
+                }
+            }
+
+            /// Draws a new key and IV from RAND_bytes().
+            void reseed() {
+                CipherState state{};
+                openssl_fill(state);
+                rekey(state);
+
+                until_reseed_ = ENTROPY_RESEED_INTERVAL;
+            }
+
+            /// Starts a new keystream and wipes the key material.
+            ///
+            /// @param state Key followed by IV; cleared on return
+            void rekey(CipherState& state) {
+                const int RESULT = EVP_EncryptInit_ex(ctx_.get(), cipher_, nullptr, state.data(),
+                                                      state.data() + KEY_SIZE);
+                OPENSSL_cleanse(state.data(), state.size());
+
+                if (RESULT != 1) [[unlikely]] {
+                    // GCOVR_EXCL_START - only fails on allocation failure
+                    throw std::runtime_error(std::string(name_) + " initialization failed");
+                    // GCOVR_EXCL_STOP
+                }
+            }
+
+            /// Overwrites a buffer with the next keystream bytes.
+            void keystream(const std::span<uint8_t> out) {
+                std::ranges::fill(out, uint8_t{0});
+
+                for (size_t offset = 0; offset < out.size(); offset += MAX_OPENSSL_CHUNK) {
+                    const int CHUNK = static_cast<int>(std::min(MAX_OPENSSL_CHUNK, out.size() - offset));
+                    int written = 0;
+
+                    if (EVP_EncryptUpdate(ctx_.get(), out.data() + offset, &written, out.data() + offset, CHUNK) != 1 ||
+                        written != CHUNK) [[unlikely]] {
+                        // GCOVR_EXCL_START - stream ciphers cannot fail after initialization
+                        throw std::runtime_error(std::string(name_) + " keystream generation failed");
+                        // GCOVR_EXCL_STOP
+                    }
+                }
+            }
+        };
+    } // anonymous namespace
+
+    /// Creates a built-in entropy source.
+    ///
+    /// @param BACKEND Source to create
+    /// @return New source
+    /// @throws std::runtime_error if the source cannot be initialized
+    std::unique_ptr<EntropySource> make_entropy_source(const EntropyBackend BACKEND) {
+        switch (BACKEND) {
+            case EntropyBackend::system:
+                return std::make_unique<SystemSource>();
+            case EntropyBackend::chacha20:
+            case EntropyBackend::aes_ctr:
+                return std::make_unique<CipherDrbg>(BACKEND);
+            default:
+                return std::make_unique<OpenSslSource>();
+        }
+    }
+
+    /// Creates a deterministic ChaCha20 or AES-CTR source.
+    ///
+    /// @param BACKEND EntropyBackend::chacha20 or EntropyBackend::aes_ctr
+    /// @param seed ENTROPY_SEED_SIZE bytes of key material
+    /// @return New deterministic source
+    /// @throws std::invalid_argument if BACKEND is not a DRBG or seed has the wrong size
+    /// @throws std::runtime_error if the source cannot be initialized
+    std::unique_ptr<EntropySource> make_seeded_entropy_source(const EntropyBackend BACKEND,
+                                                              const std::span<const uint8_t> seed) {
+        if (BACKEND != EntropyBackend::chacha20 && BACKEND != EntropyBackend::aes_ctr) [[unlikely]] {
+            throw std::invalid_argument("only the chacha20 and aes_ctr sources can be seeded");
+        }
+
+        if (seed.size() != ENTROPY_SEED_SIZE) [[unlikely]] {
+            throw std::invalid_argument("seed must be exactly 32 bytes");
+        }
+
+        return std::make_unique<CipherDrbg>(BACKEND, seed);
+    }
+} // namespace visus::cuid2::platform
@@ -3,8 +3,12 @@
 ///
 /// This file implements a singleton fingerprint that uniquely identifies the
 /// current system and process. The fingerprint combines hostname, process ID,
-/// and environment variables into a deterministic byte sequence that remains
-/// constant for the lifetime of the process.
+/// and environment variables into a deterministic byte sequence that is built
+/// on first use. In containers, where replicas share a hostname and most of
+/// their environment, an explicit node identifier can replace both. A child
+/// process created by fork() inherits the bytes, so the process ID is patched
+/// and the digest recomputed on the first access in each new process
+/// generation.
 
 #include "cuid2/fingerprint.hpp"
 
@@ -13,72 +17,234 @@
 #include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <memory>
 #include <ranges>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "cuid2/cuid2.hpp"
+#include "cuid2/hash.hpp"
 #include "cuid2/platform.hpp"
 #include <boost/endian/conversion.hpp>
 
 namespace visus::cuid2 {
+    namespace {
+        /// Appends the process ID as four little-endian bytes.
+        ///
+        /// @param out Fingerprint bytes to extend
+        void append_process_id(std::vector<uint8_t>& out) {
+            const auto PID = boost::endian::native_to_little(static_cast<uint32_t>(platform::get_process_id()));
+            const auto PID_BYTES = std::bit_cast<std::array<uint8_t, sizeof(uint32_t)>>(PID);
+
+            std::ranges::copy(PID_BYTES, std::back_inserter(out));
+        }
+    } // anonymous namespace
+
     /// Generates the system fingerprint byte sequence.
     ///
-    /// Creates a unique fingerprint by concatenating:
+    /// If CUID2_NODE_ID is set to a non-empty value, the fingerprint is that
+    /// value and the process ID, and neither the hostname nor the environment
+    /// is read. Otherwise it is the concatenation of:
     /// 1. Hostname (string bytes)
     /// 2. Process ID (4 bytes, little-endian uint32)
     /// 3. Environment variables (sorted key=value pairs)
     ///
     /// The process ID is serialized in little-endian format using
     /// boost::endian::native_to_little() for cross-platform compatibility.
-    /// Environment variables are pre-sorted by the platform layer to ensure
-    /// deterministic output.
+    /// Environment variables are sorted by the platform layer to ensure
+    /// deterministic output and are streamed straight into the result buffer
+    /// without an intermediate map or string.
     ///
+    /// @param pid_offset Receives the offset of the process ID bytes
     /// @return A byte vector containing the concatenated fingerprint data
-    std::vector<uint8_t> Fingerprint::generate() {
-        std::string hostname = platform::get_hostname();
-        const int PROCESS_ID = platform::get_process_id();
-        const auto ENV_VARS = platform::get_environment_variables();
-
-        size_t env_size = 0;
-        for (const auto& [key, value] : ENV_VARS) {
-            env_size += key.size() + 1 + value.size();
+    std::vector<uint8_t> Fingerprint::generate(std::size_t& pid_offset) {
+        if (const auto NODE_ID = platform::get_environment_variable(NODE_ID_VARIABLE); NODE_ID && !NODE_ID->empty()) {
+            return generate(*NODE_ID, pid_offset);
         }
 
-        std::string env_string;
-        env_string.reserve(env_size);
+        const std::string HOSTNAME = platform::get_hostname();
 
-        for (const auto& [key, value] : ENV_VARS) {
-            env_string += key;
-            env_string += '=';
-            env_string += value;
-        }
+        std::vector<uint8_t> result;
+        result.reserve(HOSTNAME.size() + sizeof(uint32_t));
 
-        const size_t TOTAL_SIZE = hostname.size() + sizeof(uint32_t) + env_string.size();
+        std::ranges::copy(HOSTNAME, std::back_inserter(result));
+        pid_offset = result.size();
 
-        std::vector<uint8_t> result;
-        result.reserve(TOTAL_SIZE);
+        append_process_id(result);
+        platform::append_environment(result);
+
+        return result;
+    }
 
-        std::ranges::copy(hostname, std::back_inserter(result));
+    /// Builds the fingerprint for an explicit node identifier.
+    ///
+    /// The process ID is kept so that processes sharing a node identifier,
+    /// such as the workers of one pod, still differ.
+    ///
+    /// @param NODE_ID Node identifier bytes
+    /// @param pid_offset Receives the offset of the process ID bytes
+    /// @return NODE_ID followed by the process ID (4 bytes, little-endian)
+    std::vector<uint8_t> Fingerprint::generate(const std::string_view NODE_ID, std::size_t& pid_offset) {
+        std::vector<uint8_t> result;
+        result.reserve(NODE_ID.size() + sizeof(uint32_t));
 
-        const auto PID = boost::endian::native_to_little(static_cast<uint32_t>(PROCESS_ID));
-        const auto PID_BYTES = std::bit_cast<std::array<uint8_t, sizeof(uint32_t)>>(PID);
+        std::ranges::copy(NODE_ID, std::back_inserter(result));
+        pid_offset = result.size();
 
-        std::ranges::copy(PID_BYTES, std::back_inserter(result));
-        std::ranges::copy(env_string, std::back_inserter(result));
+        append_process_id(result);
 
         return result;
     }
 
+    /// Builds a version for GENERATION from fresh fingerprint bytes.
+    ///
+    /// @param bytes Fingerprint data
+    /// @param PID_OFFSET Offset of the process ID bytes within bytes
+    /// @param GENERATION Process generation the bytes were built for
+    /// @return Unpublished version with its digest computed
+    std::unique_ptr<Fingerprint::Version> Fingerprint::make_version(std::vector<uint8_t> bytes,
+                                                                    const std::size_t PID_OFFSET,
+                                                                    const uint64_t GENERATION) {
+        auto version = std::make_unique<Version>();
+        version->bytes = std::move(bytes);
+        version->pid_offset = PID_OFFSET;
+        version->generation = GENERATION;
+        version->digest = HashContext().hash(version->bytes);
+
+        return version;
+    }
+
+    /// Releases every published version.
+    Fingerprint::~Fingerprint() {
+        const Version* version = current_.load(std::memory_order_acquire);
+
+        while (version != nullptr) {
+            const Version* previous = version->previous;
+            delete version;
+            version = previous;
+        }
+    }
+
+    /// Returns the singleton instance, constructing it on first use.
+    ///
+    /// @return Reference to the process-wide fingerprint
+    Fingerprint& Fingerprint::instance() {
+        static Fingerprint INSTANCE;
+
+        return INSTANCE;
+    }
+
+    /// Returns the version for the current process generation.
+    ///
+    /// The common case is two atomic loads; the first version is built on
+    /// first use and a stale version is refreshed once per generation.
+    ///
+    /// @return Version built for the current (or a newer) generation
+    const Fingerprint::Version& Fingerprint::current() {
+        const uint64_t GENERATION = platform::process_generation();
+        const Version* version = current_.load(std::memory_order_acquire);
+
+        if (version == nullptr || version->generation < GENERATION) [[unlikely]] {
+            return refresh(version, GENERATION);
+        }
+
+        return *version;
+    }
+
+    /// Publishes a version for GENERATION derived from LATEST.
+    ///
+    /// The new version copies the latest bytes and overwrites only the process
+    /// ID, so the environment is not scanned again; only the first version is
+    /// generated from scratch. Publication is a compare-and-swap rather than a
+    /// lock, which cannot be left held in a child forked mid-refresh; if
+    /// another thread publishes first, its version is used and this one is
+    /// discarded.
+    ///
+    /// @param latest Most recent version seen by the caller, or nullptr
+    /// @param GENERATION Process generation to build for
+    /// @return The published version for GENERATION or a newer one
+    const Fingerprint::Version& Fingerprint::refresh(const Version* latest, const uint64_t GENERATION) {
+        std::unique_ptr<Version> next;
+
+        if (latest == nullptr) {
+            std::size_t pid_offset = 0;
+            std::vector<uint8_t> bytes = generate(pid_offset);
+            next = make_version(std::move(bytes), pid_offset, GENERATION);
+        } else {
+            std::vector<uint8_t> bytes = latest->bytes;
+
+            const auto PID = boost::endian::native_to_little(static_cast<uint32_t>(platform::get_process_id()));
+            std::memcpy(bytes.data() + latest->pid_offset, &PID, sizeof(PID));
+            next = make_version(std::move(bytes), latest->pid_offset, GENERATION);
+        }
+
+        while (latest == nullptr || latest->generation < GENERATION) {
+            next->previous = latest;
+
+            if (current_.compare_exchange_weak(latest, next.get(), std::memory_order_acq_rel,
+                                               std::memory_order_acquire)) {
+                return *next.release();
+            }
+        }
+
+        return *latest;
+    }
+
     /// Returns the cached system fingerprint.
     ///
-    /// This static method accesses the inline static singleton instance and returns
-    /// a reference to the pre-computed fingerprint byte sequence. The fingerprint
-    /// remains constant for the lifetime of the process.
+    /// The fingerprint is computed on the first call rather than during static
+    /// initialization, so processes that load the library but never generate an
+    /// identifier do not pay for the environment scan. The returned bytes stay valid for
+    /// the lifetime of the process, although a later process generation
+    /// returns a different vector.
     ///
     /// @return A const reference to the fingerprint byte vector
     /// @note Thread-safe: Can be called concurrently from multiple threads
     const std::vector<uint8_t>& Fingerprint::get() {
-        return instance.cached_value_;
+        return instance().current().bytes;
+    }
+
+    /// Returns the SHA3-512 digest of the system fingerprint.
+    ///
+    /// The digest is computed alongside the fingerprint, so every identifier
+    /// absorbs 64 fingerprint bytes regardless of environment size.
+    ///
+    /// @return Const reference to the 64-byte fingerprint digest
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    const utils::Digest& Fingerprint::digest() {
+        return instance().current().digest;
+    }
+
+    /// Replaces the hostname and environment with a node identifier.
+    ///
+    /// Publishes a version built from NODE_ID and the current process ID, so
+    /// identifiers generated afterwards use it; references to earlier versions
+    /// stay valid. Called before the first identifier, the environment is
+    /// never scanned. An empty NODE_ID rebuilds the default fingerprint,
+    /// including any CUID2_NODE_ID setting.
+    ///
+    /// @param NODE_ID Node identifier, or empty to restore the default
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    void Fingerprint::set_node_id(const std::string_view NODE_ID) {
+        Fingerprint& fingerprint = instance();
+
+        // Read before the process ID, so a fork() in between leaves the
+        // version stale and the child refreshes it
+        const uint64_t GENERATION = platform::process_generation();
+
+        std::size_t pid_offset = 0;
+        std::vector<uint8_t> bytes = NODE_ID.empty() ? generate(pid_offset) : generate(NODE_ID, pid_offset);
+        auto next = make_version(std::move(bytes), pid_offset, GENERATION);
+
+        const Version* latest = fingerprint.current_.load(std::memory_order_acquire);
+        do {
+            next->previous = latest;
+        } while (!fingerprint.current_.compare_exchange_weak(latest, next.get(), std::memory_order_acq_rel,
+                                                             std::memory_order_acquire));
+
+        next.release();
     }
 } // namespace visus::cuid2
@@ -0,0 +1,836 @@
+/// @file generator.cpp
+/// @brief Reusable CUID2 generator implementation
+///
+/// This file implements the core CUID2 generation pipeline which combines:
+/// - Timestamp (for uniqueness over time; hashed, so default IDs do not sort
+///   by time, and only the sortable layout leads with it in clear)
+/// - Counter (for uniqueness within same timestamp)
+/// - System fingerprint (for uniqueness across processes/machines)
+/// - Cryptographic random bytes (for collision resistance)
+/// - NIST FIPS-202 SHA3-512 hashing (for output uniformity)
+/// - Base-36 encoding (for compact, URL-safe representation)
+///
+/// All state used by the pipeline (counter, fingerprint, digest context and
+/// entropy source) is owned by a Generator instance; the free functions in
+/// cuid2.cpp delegate to a per-thread default instance.
+
+#include "cuid2/generator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/endian/conversion.hpp>
+
+#include "cuid2/counter.hpp"
+#include "cuid2/fingerprint.hpp"
+#include "cuid2/platform.hpp"
+#include "cuid2/utils.hpp"
+#include "instrumentation.hpp"
+
+#ifdef CUID2_ENABLE_SIMD_KECCAK
+    #include "cuid2/keccak.hpp"
+#endif
+
+namespace visus::cuid2 {
+    namespace {
+        /// Combined size of timestamp and counter in bytes (8 bytes each).
+        constexpr size_t TIMESTAMP_COUNTER_SIZE = sizeof(int64_t) * 2;
+
+        /// Length of the random letter prefix (always 1 character).
+        constexpr size_t PREFIX_LENGTH = 1;
+
+        /// Maximum number of identifiers whose random bytes are drawn per CSPRNG
+        /// call in Generator batches. Bounds the scratch buffer to a few KiB while
+        /// still amortizing the per-call CSPRNG overhead.
+        constexpr size_t BATCH_CHUNK_SIZE = 128;
+
+        /// Number of random bytes consumed per identifier: one for the prefix
+        /// letter plus one per identifier character.
+        constexpr size_t MAX_ENTROPY_PER_ID = PREFIX_LENGTH + MAX_CUID2_LENGTH;
+
+#ifdef CUID2_ENABLE_SIMD_KECCAK
+        /// Largest per-identifier hash input: header, fingerprint digest and
+        /// one random byte per character.
+        constexpr size_t MAX_HASH_INPUT_SIZE = TIMESTAMP_COUNTER_SIZE + utils::DIGEST_SIZE + MAX_CUID2_LENGTH;
+#endif
+
+        /// Base-36 digits following the leading letter of a sortable time prefix.
+        constexpr size_t SORTABLE_TIME_DIGITS = SORTABLE_TIME_LENGTH - 1;
+
+        /// Milliseconds counted by the SORTABLE_TIME_DIGITS digits (36^8,
+        /// about 89 years); the leading letter counts multiples of it.
+        constexpr uint64_t SORTABLE_TIME_SPAN = 2'821'109'907'456ULL;
+
+        /// Timestamp ticks (100 ns) per millisecond.
+        constexpr int64_t TICKS_PER_MILLISECOND = 10'000;
+
+        /// Leading characters of a sortable identifier.
+        using TimePrefix = std::array<char, SORTABLE_TIME_LENGTH>;
+
+        /// Encodes a timestamp as the fixed-width time prefix of a sortable
+        /// identifier.
+        ///
+        /// Base-36 digits sort in ASCII order and have a fixed width, so the
+        /// prefixes of later milliseconds compare greater. The leading letter
+        /// advances every SORTABLE_TIME_SPAN milliseconds: 'a' until 2059, 'b'
+        /// until 2148, saturating at "zzzzzzzzz".
+        ///
+        /// @param TIMESTAMP Timestamp in 100-nanosecond ticks since the epoch
+        /// @return Letter followed by SORTABLE_TIME_DIGITS base-36 digits
+        TimePrefix encode_time_prefix(const int64_t TIMESTAMP) noexcept {
+            constexpr uint64_t LETTERS = 26;
+            constexpr uint64_t RADIX = utils::BASE36_ALPHABET.size();
+
+            auto millis = static_cast<uint64_t>(std::max<int64_t>(TIMESTAMP, 0) / TICKS_PER_MILLISECOND);
+            millis = std::min(millis, LETTERS * SORTABLE_TIME_SPAN - 1);
+
+            TimePrefix prefix{};
+            prefix[0] = static_cast<char>('a' + millis / SORTABLE_TIME_SPAN);
+
+            millis %= SORTABLE_TIME_SPAN;
+            for (size_t idx = SORTABLE_TIME_DIGITS; idx > 0; --idx) {
+                prefix[idx] = utils::BASE36_ALPHABET[millis % RADIX];
+                millis /= RADIX;
+            }
+
+            return prefix;
+        }
+
+        /// Serializes a 64-bit integer to little-endian bytes.
+        ///
+        /// Converts the input value to unsigned, then to little-endian byte order
+        /// using boost::endian for cross-platform compatibility. The 8 bytes are
+        /// written to the destination in little-endian order.
+        ///
+        /// @param out Destination for the eight serialized bytes
+        /// @param VALUE The 64-bit integer to serialize
+        void serialize_int64_le(const std::span<uint8_t, sizeof(uint64_t)> out, const int64_t VALUE) noexcept {
+            const auto UNSIGNED_VALUE = static_cast<uint64_t>(VALUE);
+            const auto LITTLE_ENDIAN_VALUE = boost::endian::native_to_little(UNSIGNED_VALUE);
+            const auto BYTES = std::bit_cast<std::array<uint8_t, sizeof(uint64_t)>>(LITTLE_ENDIAN_VALUE);
+
+            std::ranges::copy(BYTES, out.begin());
+        }
+
+        /// Validates the requested CUID2 length is within allowed bounds.
+        ///
+        /// Checks that the requested length is between MIN_CUID2_LENGTH (4) and
+        /// MAX_CUID2_LENGTH (32) inclusive. Shorter identifiers have higher
+        /// collision probability; longer ones provide more entropy.
+        ///
+        /// @param MAX_LENGTH The requested CUID2 identifier length
+        /// @throws std::invalid_argument if length is outside valid range
+        void validate_length(const int MAX_LENGTH) {
+            if (MAX_LENGTH < MIN_CUID2_LENGTH || MAX_LENGTH > MAX_CUID2_LENGTH) [[unlikely]] {
+                throw std::invalid_argument("MAX_LENGTH must be between 4 and 32");
+            }
+        }
+
+        /// Validates a caller-provided buffer length is within allowed bounds.
+        ///
+        /// @param LENGTH The requested CUID2 identifier length
+        /// @throws std::invalid_argument if length is outside valid range
+        void validate_length(const size_t LENGTH) {
+            if (LENGTH < static_cast<size_t>(MIN_CUID2_LENGTH) || LENGTH > static_cast<size_t>(MAX_CUID2_LENGTH)) [[unlikely]] {
+                throw std::invalid_argument("LENGTH must be between 4 and 32");
+            }
+        }
+
+        /// Batch output as a range of strings, each resized to its identifier.
+        ///
+        /// @tparam String std::string or std::pmr::string
+        template <typename String>
+        struct StringSlots {
+            /// Strings to overwrite.
+            std::span<String> out;
+
+            [[nodiscard]] size_t size() const noexcept {
+                return out.size();
+            }
+
+            [[nodiscard]] StringSlots subspan(const size_t OFFSET, const size_t COUNT) const noexcept {
+                return {out.subspan(OFFSET, COUNT)};
+            }
+
+            /// Returns room for LENGTH characters of record IDX.
+            char* prepare(const size_t IDX, const size_t LENGTH) const {
+                out[IDX].resize(LENGTH);
+
+                return out[IDX].data();
+            }
+
+            /// Returns the characters of record IDX.
+            [[nodiscard]] char* record(const size_t IDX) const noexcept {
+                return out[IDX].data();
+            }
+
+            /// Trims record IDX to the characters written.
+            ///
+            /// @return Always true; a shorter identifier is kept as written
+            bool commit(const size_t IDX, const size_t WRITTEN) const {
+                out[IDX].resize(WRITTEN);
+
+                return true;
+            }
+        };
+
+        /// Batch output as fixed-width records at a fixed stride in one buffer.
+        struct StridedSlots {
+            /// First byte of record 0.
+            char* base;
+
+            /// Distance in bytes between consecutive records.
+            size_t stride;
+
+            /// Number of records.
+            size_t count;
+
+            /// Characters in every record.
+            size_t length;
+
+            [[nodiscard]] size_t size() const noexcept {
+                return count;
+            }
+
+            [[nodiscard]] StridedSlots subspan(const size_t OFFSET, const size_t COUNT) const noexcept {
+                return {base + OFFSET * stride, stride, COUNT, length};
+            }
+
+            /// Returns record IDX; every record has room for LENGTH characters.
+            [[nodiscard]] char* prepare(const size_t IDX, const size_t /*LENGTH*/) const noexcept {
+                return base + IDX * stride;
+            }
+
+            /// Returns the characters of record IDX.
+            [[nodiscard]] char* record(const size_t IDX) const noexcept {
+                return base + IDX * stride;
+            }
+
+            /// Records cannot shrink, so a short identifier must be rewritten.
+            ///
+            /// @return true if the record is complete
+            [[nodiscard]] bool commit(const size_t /*IDX*/, const size_t WRITTEN) const noexcept {
+                return WRITTEN == length;
+            }
+        };
+
+        /// Computes the NIST FIPS-202 SHA3-512 hash of the CUID2 components.
+        ///
+        /// Feeds the components to the digest context in a specific order:
+        /// 1. Timestamp (8 bytes, little-endian)
+        /// 2. Counter (8 bytes, little-endian)
+        /// 3. Fingerprint digest (64 bytes, SHA3-512 of the fingerprint)
+        /// 4. Random bytes (variable length)
+        ///
+        /// Each component is absorbed directly instead of being concatenated
+        /// first, which yields the same digest as hashing the concatenation
+        /// without materializing it. This deterministic ordering ensures
+        /// consistent hash outputs for testing and cross-implementation
+        /// compatibility. The digest context is re-initialized on every call, so
+        /// a single context may be reused for any number of hashes.
+        ///
+        /// @param context Digest context to (re)initialize and hash with
+        /// @param TIMESTAMP Current timestamp in 100-nanosecond ticks
+        /// @param COUNTER Current counter value
+        /// @param fingerprint Digest of the fingerprint bytes
+        /// @param random_bytes Cryptographically secure random bytes
+        /// @return 64-byte SHA3-512 hash output
+        [[nodiscard]] utils::Digest compute_hash(
+            HashContext& context,
+            const int64_t TIMESTAMP,
+            const int64_t COUNTER,
+            const utils::Digest& fingerprint,
+            const std::span<const uint8_t> random_bytes
+        ) {
+            const instrumentation::StageTimer TIMER(Stage::hash);
+
+            std::array<uint8_t, TIMESTAMP_COUNTER_SIZE> header{};
+            serialize_int64_le(std::span(header).first<sizeof(uint64_t)>(), TIMESTAMP);
+            serialize_int64_le(std::span(header).last<sizeof(uint64_t)>(), COUNTER);
+
+            context.init();
+            context.update(header);
+            context.update(fingerprint);
+            context.update(random_bytes);
+
+            return context.finalize();
+        }
+
+        /// Formats an identifier from its prefix byte and digest.
+        ///
+        /// @param out Destination for LENGTH characters (not NUL-terminated)
+        /// @param LENGTH Total identifier length (including prefix), already validated
+        /// @param PREFIX_BYTE Random byte selecting the leading letter
+        /// @param digest SHA3-512 digest of the identifier's hash input
+        /// @return Number of characters written (LENGTH unless the digest encodes shorter)
+        size_t encode_identifier(char* out, const size_t LENGTH, const uint8_t PREFIX_BYTE, const utils::Digest& digest) {
+            const instrumentation::StageTimer TIMER(Stage::encode);
+
+            out[0] = utils::prefix_from_byte(PREFIX_BYTE);
+
+            return PREFIX_LENGTH + utils::encode_base36_prefix(digest, std::span(out + PREFIX_LENGTH, LENGTH - PREFIX_LENGTH));
+        }
+
+        /// Writes one CUID2 identifier into caller-provided memory.
+        ///
+        /// Constructs the identifier as: [prefix][encoded_hash_prefix]
+        /// The prefix is always 1 character (a-z) derived from the first entropy
+        /// byte; the remaining entropy bytes are hashed with the other components
+        /// and the leading (LENGTH - 1) base-36 digits of the digest follow.
+        ///
+        /// @param context Digest context to hash with
+        /// @param out Destination for LENGTH characters (not NUL-terminated)
+        /// @param LENGTH Total identifier length (including prefix), already validated
+        /// @param TIMESTAMP Current timestamp in 100-nanosecond ticks
+        /// @param COUNTER Counter value for this identifier
+        /// @param fingerprint Digest of the fingerprint bytes
+        /// @param entropy Prefix byte followed by LENGTH random bytes
+        /// @return Number of characters written (LENGTH unless the digest encodes shorter)
+        size_t write_identifier(
+            HashContext& context,
+            char* out,
+            const size_t LENGTH,
+            const int64_t TIMESTAMP,
+            const int64_t COUNTER,
+            const utils::Digest& fingerprint,
+            const std::span<const uint8_t> entropy
+        ) {
+            const auto HASH_OUTPUT = compute_hash(context, TIMESTAMP, COUNTER, fingerprint, entropy.subspan(PREFIX_LENGTH));
+
+            return encode_identifier(out, LENGTH, entropy.front(), HASH_OUTPUT);
+        }
+
+#ifdef CUID2_ENABLE_SIMD_KECCAK
+        /// Lays out the hash input for one identifier contiguously.
+        ///
+        /// The bytes are exactly those absorbed by compute_hash(), so hashing
+        /// them with any backend yields the same digest.
+        ///
+        /// @param out Destination with room for MAX_HASH_INPUT_SIZE bytes
+        /// @param TIMESTAMP Current timestamp in 100-nanosecond ticks
+        /// @param COUNTER Counter value for this identifier
+        /// @param fingerprint Digest of the fingerprint bytes
+        /// @param random_bytes Cryptographically secure random bytes
+        /// @return Number of bytes written
+        size_t build_hash_input(
+            const std::span<uint8_t> out,
+            const int64_t TIMESTAMP,
+            const int64_t COUNTER,
+            const utils::Digest& fingerprint,
+            const std::span<const uint8_t> random_bytes
+        ) noexcept {
+            serialize_int64_le(out.first<sizeof(uint64_t)>(), TIMESTAMP);
+            serialize_int64_le(out.subspan<sizeof(uint64_t), sizeof(uint64_t)>(), COUNTER);
+
+            auto cursor = std::ranges::copy(fingerprint, out.begin() + TIMESTAMP_COUNTER_SIZE).out;
+            cursor = std::ranges::copy(random_bytes, cursor).out;
+
+            return static_cast<size_t>(cursor - out.begin());
+        }
+
+        /// Writes a chunk of identifiers using the multi-buffer Keccak backend.
+        ///
+        /// Identifiers are hashed in groups of keccak::MAX_LANES. A trailing
+        /// group narrower than the backend's lane count is hashed through the
+        /// digest context instead, which is faster than the scalar kernel.
+        ///
+        /// @tparam Slots StringSlots or StridedSlots
+        /// @tparam Finish Called with each record index and its written length
+        /// @param context Digest context for the trailing group
+        /// @param out Records to overwrite, one per identifier in the chunk
+        /// @param LENGTH Total identifier length (including prefix), already validated
+        /// @param TIMESTAMP Timestamp shared by the batch
+        /// @param FIRST_COUNTER Counter value of the first identifier in the chunk
+        /// @param fingerprint Digest of the fingerprint bytes
+        /// @param entropy Prefix byte and LENGTH random bytes per identifier
+        /// @param finish Completes a record after it was written
+        template <typename Slots, typename Finish>
+        void write_identifiers_multibuffer(
+            HashContext& context,
+            const Slots out,
+            const size_t LENGTH,
+            const int64_t TIMESTAMP,
+            const uint64_t FIRST_COUNTER,
+            const utils::Digest& fingerprint,
+            const std::span<const uint8_t> entropy,
+            Finish&& finish
+        ) {
+            const keccak::Backend BACKEND = keccak::detect_backend();
+            const size_t LANES = keccak::lane_count(BACKEND);
+            const size_t ENTROPY_PER_ID = PREFIX_LENGTH + LENGTH;
+
+            std::array<uint8_t, keccak::MAX_LANES * MAX_HASH_INPUT_SIZE> messages{};
+            std::array<utils::Digest, keccak::MAX_LANES> digests{};
+
+            for (size_t group = 0; group < out.size(); group += keccak::MAX_LANES) {
+                const size_t GROUP_SIZE = std::min(keccak::MAX_LANES, out.size() - group);
+
+                if (GROUP_SIZE < LANES) [[unlikely]] {
+                    for (size_t idx = group; idx < out.size(); ++idx) {
+                        const auto ID_ENTROPY = entropy.subspan(idx * ENTROPY_PER_ID, ENTROPY_PER_ID);
+                        const auto COUNTER = static_cast<int64_t>(FIRST_COUNTER + idx);
+
+                        finish(idx, write_identifier(context, out.prepare(idx, LENGTH), LENGTH, TIMESTAMP, COUNTER, fingerprint, ID_ENTROPY));
+                    }
+
+                    return;
+                }
+
+                size_t input_length = 0;
+                for (size_t lane = 0; lane < GROUP_SIZE; ++lane) {
+                    const size_t IDX = group + lane;
+                    const auto RANDOM_BYTES = entropy.subspan(IDX * ENTROPY_PER_ID + PREFIX_LENGTH, LENGTH);
+                    const auto COUNTER = static_cast<int64_t>(FIRST_COUNTER + IDX);
+
+                    input_length = build_hash_input(
+                        std::span(messages).subspan(lane * MAX_HASH_INPUT_SIZE, MAX_HASH_INPUT_SIZE),
+                        TIMESTAMP, COUNTER, fingerprint, RANDOM_BYTES);
+                }
+
+                {
+                    const instrumentation::StageTimer TIMER(Stage::hash);
+                    keccak::sha3_512_strided(messages, MAX_HASH_INPUT_SIZE, input_length, std::span(digests).first(GROUP_SIZE), BACKEND);
+                }
+
+                for (size_t lane = 0; lane < GROUP_SIZE; ++lane) {
+                    const size_t IDX = group + lane;
+
+                    finish(IDX, encode_identifier(out.prepare(IDX, LENGTH), LENGTH, entropy[IDX * ENTROPY_PER_ID], digests[lane]));
+                }
+            }
+        }
+#endif
+
+    } // anonymous namespace
+
+    /// Creates a generator with default options.
+    ///
+    /// @throws std::runtime_error if the digest context cannot be created
+    Generator::Generator() : Generator(GeneratorOptions{}) {}
+
+    /// Creates a generator with the given options.
+    ///
+    /// Validates the length, hashes a custom fingerprint down to its digest once,
+    /// and seeds the instance-owned counter from the configured entropy source,
+    /// so generators seeded deterministically produce reproducible counter
+    /// sequences.
+    ///
+    /// @param options Length, fingerprint, entropy and counter configuration
+    /// @throws std::invalid_argument if options.length is outside valid range [4, 32]
+    /// @throws std::runtime_error if the digest context cannot be created
+    Generator::Generator(GeneratorOptions options)
+        : length_(static_cast<size_t>(options.length)),
+          entropy_(std::move(options.entropy)),
+          shared_counter_(options.shared_counter),
+          timestamp_(options.timestamp),
+          timestamp_refresh_(options.timestamp_refresh),
+          sortable_(options.sortable) {
+        if (options.length < MIN_CUID2_LENGTH || options.length > MAX_CUID2_LENGTH) [[unlikely]] {
+            throw std::invalid_argument("length must be between 4 and 32");
+        }
+
+        validate_layout(length_);
+
+        if (timestamp_refresh_ == 0) [[unlikely]] {
+            throw std::invalid_argument("timestamp_refresh must be at least 1");
+        }
+
+        if (options.fingerprint) {
+            fingerprint_ = hash_.hash(*options.fingerprint);
+        }
+
+        if (!shared_counter_) {
+            seed_counter();
+        }
+    }
+
+    Generator::~Generator() = default;
+
+    Generator::Generator(Generator&& other) noexcept = default;
+
+    Generator& Generator::operator=(Generator&& other) noexcept = default;
+
+    /// Generates an identifier of the configured length.
+    ///
+    /// @return A CUID2 identifier string of the configured length
+    std::string Generator::next() {
+        std::string result(length_, '\0');
+        result.resize(write_unchecked(result.data(), result.size()));
+
+        return result;
+    }
+
+    /// Generates an identifier of the configured length whose storage comes
+    /// from a memory resource.
+    ///
+    /// The identifier is written straight into the string's buffer; the
+    /// pipeline itself uses only stack buffers.
+    ///
+    /// @param resource Resource for the string's storage
+    /// @return A CUID2 identifier string of the configured length
+    /// @throws std::invalid_argument if resource is null
+    std::pmr::string Generator::next(std::pmr::memory_resource* resource) {
+        if (resource == nullptr) [[unlikely]] {
+            throw std::invalid_argument("resource must not be null");
+        }
+
+        std::pmr::string result(length_, '\0', resource);
+        result.resize(write_unchecked(result.data(), result.size()));
+
+        return result;
+    }
+
+    /// Writes an identifier filling the whole of a caller-provided buffer.
+    ///
+    /// @param out Destination buffer; its size is the identifier length (min: 4, max: 32)
+    /// @return Number of characters written (always out.size() in practice)
+    /// @throws std::invalid_argument if out.size() is outside valid range [4, 32]
+    std::size_t Generator::next_into(const std::span<char> out) {
+        validate_length(out.size());
+        validate_layout(out.size());
+
+        return write_unchecked(out.data(), out.size());
+    }
+
+    /// Generates an identifier of the configured length into every element
+    /// of a caller-provided range.
+    ///
+    /// @param out Range of strings to overwrite with newly generated identifiers
+    void Generator::next_batch(const std::span<std::string> out) {
+        write_batch_unchecked(StringSlots<std::string>{out}, length_);
+    }
+
+    /// Generates identifiers of the given length into every element of a
+    /// caller-provided range.
+    ///
+    /// @param out Range of strings to overwrite with newly generated identifiers
+    /// @param MAX_LENGTH Identifier length for this batch (min: 4, max: 32)
+    /// @throws std::invalid_argument if MAX_LENGTH is outside valid range [4, 32]
+    void Generator::next_batch(const std::span<std::string> out, const int MAX_LENGTH) {
+        validate_length(MAX_LENGTH);
+        validate_layout(static_cast<size_t>(MAX_LENGTH));
+
+        write_batch_unchecked(StringSlots<std::string>{out}, static_cast<size_t>(MAX_LENGTH));
+    }
+
+    /// Generates identifiers of the given length into every element of a
+    /// range of strings allocating from their own memory resources.
+    ///
+    /// @param out Range of strings to overwrite with newly generated identifiers
+    /// @param MAX_LENGTH Identifier length for this batch (min: 4, max: 32)
+    /// @throws std::invalid_argument if MAX_LENGTH is outside valid range [4, 32]
+    void Generator::next_batch(const std::span<std::pmr::string> out, const int MAX_LENGTH) {
+        validate_length(MAX_LENGTH);
+        validate_layout(static_cast<size_t>(MAX_LENGTH));
+
+        write_batch_unchecked(StringSlots<std::pmr::string>{out}, static_cast<size_t>(MAX_LENGTH));
+    }
+
+    /// Writes identifiers of the given length as fixed-width records at a
+    /// fixed stride.
+    ///
+    /// @param column Buffer receiving COUNT records
+    /// @param STRIDE Distance in bytes between consecutive records
+    /// @param COUNT Number of identifiers to write
+    /// @param MAX_LENGTH Identifier length for this batch (min: 4, max: 32, at most STRIDE)
+    /// @throws std::invalid_argument if MAX_LENGTH is outside [4, 32], STRIDE
+    ///         is below MAX_LENGTH or column is too small for COUNT records
+    void Generator::next_batch_into(const std::span<char> column, const std::size_t STRIDE, const std::size_t COUNT,
+                                    const int MAX_LENGTH) {
+        validate_length(MAX_LENGTH);
+
+        const auto LENGTH = static_cast<size_t>(MAX_LENGTH);
+        validate_layout(LENGTH);
+
+        if (STRIDE < LENGTH) [[unlikely]] {
+            throw std::invalid_argument("STRIDE must be at least MAX_LENGTH");
+        }
+
+        if (COUNT == 0) {
+            return;
+        }
+
+        // Written as a division so a huge COUNT cannot overflow the product
+        if (column.size() < LENGTH || (column.size() - LENGTH) / STRIDE < COUNT - 1) [[unlikely]] {
+            throw std::invalid_argument("column is too small for the requested records");
+        }
+
+        write_batch_unchecked(StridedSlots{column.data(), STRIDE, COUNT, LENGTH}, LENGTH);
+    }
+
+    /// Returns the configured identifier length.
+    ///
+    /// @return Length used by next() and next_batch()
+    int Generator::length() const noexcept {
+        return static_cast<int>(length_);
+    }
+
+    /// Seeds the instance-owned counter from the entropy source.
+    ///
+    /// The generation is read first, so a fork() during seeding leaves the
+    /// counter stale in the child and it is seeded again there.
+    void Generator::seed_counter() {
+        generation_ = platform::process_generation();
+
+        std::array<uint8_t, sizeof(uint64_t)> seed{};
+        fill_entropy(seed);
+        counter_ = std::bit_cast<uint64_t>(seed);
+    }
+
+    /// Returns the counter value for the next identifier.
+    ///
+    /// Unsigned arithmetic keeps the instance counter's wrap-around well-defined,
+    /// matching the modular behaviour of the shared atomic counter.
+    ///
+    /// @return Counter value to hash into the identifier
+    int64_t Generator::next_counter() {
+        const instrumentation::StageTimer TIMER(Stage::counter);
+
+        if (shared_counter_) {
+            return Counter::next();
+        }
+
+        if (generation_ != platform::process_generation()) [[unlikely]] {
+            seed_counter();
+        }
+
+        return static_cast<int64_t>(counter_++);
+    }
+
+    /// Reserves COUNT consecutive counter values and returns the first.
+    ///
+    /// @param COUNT Number of values to reserve
+    /// @return First reserved counter value
+    int64_t Generator::reserve_counter(const std::size_t COUNT) {
+        const instrumentation::StageTimer TIMER(Stage::counter);
+
+        if (shared_counter_) {
+            return Counter::reserve(static_cast<int64_t>(COUNT));
+        }
+
+        if (generation_ != platform::process_generation()) [[unlikely]] {
+            seed_counter();
+        }
+
+        const uint64_t FIRST = counter_;
+        counter_ += COUNT;
+
+        return static_cast<int64_t>(FIRST);
+    }
+
+    /// Returns the timestamp for the next identifier or batch.
+    ///
+    /// @return Current time in 100-nanosecond ticks as read by the configured
+    ///         TimestampSource
+    int64_t Generator::next_timestamp() noexcept {
+        switch (timestamp_) {
+            case TimestampSource::coarse:
+                return utils::get_coarse_timestamp_ticks();
+            case TimestampSource::cached:
+                if (timestamp_remaining_ == 0) {
+                    cached_timestamp_ = utils::get_timestamp_ticks();
+                    timestamp_remaining_ = timestamp_refresh_;
+                }
+
+                --timestamp_remaining_;
+                return cached_timestamp_;
+            case TimestampSource::precise:
+            default:
+                return utils::get_timestamp_ticks();
+        }
+    }
+
+    /// Fills a buffer from the configured entropy source.
+    ///
+    /// Without a custom source the bytes come from platform::get_random_bytes(),
+    /// whose per-thread buffer already amortizes CSPRNG calls and is discarded
+    /// after fork(), so the generator keeps no random bytes of its own.
+    ///
+    /// @param out Buffer to fill
+    void Generator::fill_entropy(const std::span<uint8_t> out) {
+        const instrumentation::StageTimer TIMER(Stage::random);
+
+        if (entropy_) {
+            entropy_(out);
+            return;
+        }
+
+        platform::get_random_bytes(out.data(), out.size());
+    }
+
+    /// Returns the fingerprint digest hashed into every identifier.
+    ///
+    /// @return Digest of the custom fingerprint if configured, otherwise the
+    ///         system fingerprint digest
+    const utils::Digest& Generator::fingerprint() const {
+        return fingerprint_ ? *fingerprint_ : Fingerprint::digest();
+    }
+
+    /// Rejects lengths too short for the sortable layout, if enabled.
+    ///
+    /// @param LENGTH Identifier length, already known to be in [4, 32]
+    /// @throws std::invalid_argument if sortable and LENGTH is below
+    ///         MIN_SORTABLE_LENGTH
+    void Generator::validate_layout(const std::size_t LENGTH) const {
+        if (sortable_ && LENGTH < static_cast<size_t>(MIN_SORTABLE_LENGTH)) [[unlikely]] {
+            throw std::invalid_argument("sortable identifiers must be at least 16 characters long");
+        }
+    }
+
+    /// Writes one identifier of a pre-validated length.
+    ///
+    /// All intermediate data lives in fixed-size stack buffers bounded by
+    /// TIMESTAMP_COUNTER_SIZE, MAX_CUID2_LENGTH and the digest size. The prefix
+    /// byte and random bytes are drawn with a single entropy request. In
+    /// sortable mode the time prefix then replaces the leading characters,
+    /// keeping the hashed digits that follow them.
+    ///
+    /// @param out Destination for LENGTH characters (not NUL-terminated)
+    /// @param LENGTH Total identifier length (including prefix), already validated
+    /// @return Number of characters written
+    std::size_t Generator::write_unchecked(char* out, const std::size_t LENGTH) {
+        const int64_t TIMESTAMP = next_timestamp();
+        const int64_t COUNTER = next_counter();
+
+        std::array<uint8_t, MAX_ENTROPY_PER_ID> entropy{};
+        const auto ID_ENTROPY = std::span(entropy).first(PREFIX_LENGTH + LENGTH);
+        fill_entropy(ID_ENTROPY);
+
+        const size_t WRITTEN = write_identifier(hash_, out, LENGTH, TIMESTAMP, COUNTER, fingerprint(), ID_ENTROPY);
+        if (sortable_) {
+            std::ranges::copy(encode_time_prefix(TIMESTAMP), out);
+        }
+
+        instrumentation::record_identifiers(1);
+
+        return WRITTEN;
+    }
+
+    /// Writes exactly LENGTH characters through the pipeline specialized for
+    /// LENGTH.
+    ///
+    /// Dispatches through a table built at compile time, so the only run-time
+    /// work is one indexed call; LENGTH must already be in [4, 32].
+    ///
+    /// @param out Destination for LENGTH characters (not NUL-terminated)
+    /// @param LENGTH Identifier length
+    void Generator::write_fixed(char* out, const int LENGTH) {
+        using Writer = void (Generator::*)(char*);
+
+        static constexpr auto WRITERS = []<std::size_t... I>(std::index_sequence<I...>) {
+            return std::array<Writer, sizeof...(I)>{&Generator::write_fixed<MIN_CUID2_LENGTH + I>...};
+        }(std::make_index_sequence<MAX_CUID2_LENGTH - MIN_CUID2_LENGTH + 1>{});
+
+        (this->*WRITERS[static_cast<std::size_t>(LENGTH - MIN_CUID2_LENGTH)])(out);
+    }
+
+    /// Pipeline for one compile-time length.
+    ///
+    /// The entropy buffer is sized exactly and the digit count is a constant,
+    /// so every length-dependent bound folds away. A digest whose base-36 form
+    /// is shorter than LENGTH - 1 digits is practically impossible for
+    /// SHA3-512, but would still be replaced so the result always fills LENGTH
+    /// characters.
+    ///
+    /// @tparam LENGTH Identifier length in [4, 32]
+    /// @param out Destination for LENGTH characters (not NUL-terminated)
+    template <std::size_t LENGTH>
+    void Generator::write_fixed(char* out) {
+        std::array<uint8_t, PREFIX_LENGTH + LENGTH> entropy{};
+        int64_t timestamp = 0;
+
+        if constexpr (LENGTH < static_cast<size_t>(MIN_SORTABLE_LENGTH)) {
+            validate_layout(LENGTH);
+        }
+
+        for (;;) {
+            timestamp = next_timestamp();
+            const int64_t COUNTER = next_counter();
+            fill_entropy(entropy);
+
+            if (write_identifier(hash_, out, LENGTH, timestamp, COUNTER, fingerprint(), entropy) == LENGTH) [[likely]] {
+                break;
+            }
+        }
+
+        if constexpr (LENGTH >= static_cast<size_t>(MIN_SORTABLE_LENGTH)) {
+            if (sortable_) {
+                std::ranges::copy(encode_time_prefix(timestamp), out);
+            }
+        }
+
+        instrumentation::record_identifiers(1);
+    }
+
+    /// Fills a batch with identifiers of a pre-validated length.
+    ///
+    /// Reads the timestamp once, reserves slots.size() consecutive counter
+    /// values at once, and draws the random bytes and prefix byte for up to
+    /// BATCH_CHUNK_SIZE identifiers per entropy request into a stack buffer.
+    /// When built with ENABLE_SIMD_KECCAK on a CPU with a multi-lane backend,
+    /// several identifiers are hashed per Keccak permutation. A fixed-width
+    /// record whose digest encodes shorter than LENGTH is rewritten through
+    /// write_fixed(), so every record is filled. In sortable mode the time
+    /// prefix is encoded once and copied over each record's leading characters.
+    ///
+    /// @tparam Slots StringSlots or StridedSlots
+    /// @param slots Records to overwrite with newly generated identifiers
+    /// @param LENGTH Total identifier length (including prefix), already validated
+    template <typename Slots>
+    void Generator::write_batch_unchecked(const Slots slots, const std::size_t LENGTH) {
+        if (slots.size() == 0) [[unlikely]] {
+            return;
+        }
+
+        const int64_t TIMESTAMP = next_timestamp();
+        const auto FIRST_COUNTER = static_cast<uint64_t>(reserve_counter(slots.size()));
+        const auto& fingerprint_bytes = fingerprint();
+        const TimePrefix TIME_PREFIX = sortable_ ? encode_time_prefix(TIMESTAMP) : TimePrefix{};
+
+        const size_t ENTROPY_PER_ID = PREFIX_LENGTH + LENGTH;
+        std::array<uint8_t, BATCH_CHUNK_SIZE * MAX_ENTROPY_PER_ID> entropy{};
+
+#ifdef CUID2_ENABLE_SIMD_KECCAK
+        const bool MULTIBUFFER = keccak::lane_count(keccak::detect_backend()) > 1;
+#endif
+
+        for (size_t offset = 0; offset < slots.size(); offset += BATCH_CHUNK_SIZE) {
+            const size_t CHUNK_SIZE = std::min(BATCH_CHUNK_SIZE, slots.size() - offset);
+            const auto CHUNK = slots.subspan(offset, CHUNK_SIZE);
+            fill_entropy(std::span(entropy).first(CHUNK_SIZE * ENTROPY_PER_ID));
+
+            const auto FINISH = [&](const size_t IDX, const size_t WRITTEN) {
+                if (!CHUNK.commit(IDX, WRITTEN)) [[unlikely]] {
+                    // GCOVR_EXCL_START
+                    write_fixed(CHUNK.prepare(IDX, LENGTH), static_cast<int>(LENGTH));
+                    // GCOVR_EXCL_STOP
+                } else if (sortable_) {
+                    std::ranges::copy(TIME_PREFIX, CHUNK.record(IDX));
+                }
+            };
+
+#ifdef CUID2_ENABLE_SIMD_KECCAK
+            if (MULTIBUFFER) {
+                write_identifiers_multibuffer(
+                    hash_, CHUNK, LENGTH, TIMESTAMP, FIRST_COUNTER + offset, fingerprint_bytes,
+                    std::span(entropy).first(CHUNK_SIZE * ENTROPY_PER_ID), FINISH);
+                continue;
+            }
+#endif
+
+            for (size_t idx = 0; idx < CHUNK_SIZE; ++idx) {
+                const auto ID_ENTROPY = std::span(entropy).subspan(idx * ENTROPY_PER_ID, ENTROPY_PER_ID);
+                const auto COUNTER = static_cast<int64_t>(FIRST_COUNTER + offset + idx);
+
+                FINISH(idx, write_identifier(hash_, CHUNK.prepare(idx, LENGTH), LENGTH, TIMESTAMP, COUNTER,
+                                             fingerprint_bytes, ID_ENTROPY));
+            }
+        }
+
+        instrumentation::record_identifiers(slots.size());
+    }
+} // namespace visus::cuid2
@@ -0,0 +1,155 @@
+/// @file hash.cpp
+/// @brief Reusable SHA3-512 hashing context implementation
+///
+/// This file implements the HashContext wrapper around OpenSSL's EVP digest
+/// interface. The SHA3-512 algorithm object is fetched explicitly once per
+/// process, and every context re-initializes its EVP_MD_CTX in place rather
+/// than allocating a fresh one per hash.
+
+#include "cuid2/hash.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <openssl/evp.h>
+
+namespace visus::cuid2 {
+    namespace {
+        /// RAII deleter for an explicitly fetched OpenSSL digest algorithm.
+        struct EVPDigestDeleter {
+            void operator()(EVP_MD* digest) const noexcept {
+#if OPENSSL_VERSION_MAJOR >= 3
+                EVP_MD_free(digest);
+#else
+                static_cast<void>(digest);
+#endif
+            }
+        };
+
+        /// Fetches the SHA3-512 implementation from the default provider.
+        ///
+        /// On OpenSSL 3 this performs a single explicit EVP_MD_fetch() whose
+        /// result is cached for the life of the process. Older releases return
+        /// the static built-in implementation.
+        ///
+        /// @return Owning handle for the SHA3-512 algorithm (may be null on failure)
+        std::unique_ptr<EVP_MD, EVPDigestDeleter> fetch_sha3_512() noexcept {
+#if OPENSSL_VERSION_MAJOR >= 3
+            return std::unique_ptr<EVP_MD, EVPDigestDeleter>(EVP_MD_fetch(nullptr, "SHA3-512", nullptr));
+#else
+            return std::unique_ptr<EVP_MD, EVPDigestDeleter>(const_cast<EVP_MD*>(EVP_sha3_512()));
+#endif
+        }
+
+        /// Returns the process-wide SHA3-512 algorithm object.
+        ///
+        /// @return Fetched digest algorithm
+        /// @throws std::runtime_error if no provider offers SHA3-512
+        const EVP_MD* sha3_512() {
+            static const auto DIGEST = fetch_sha3_512();
+
+            if (DIGEST == nullptr) [[unlikely]] {
+                // GCOVR_EXCL_START - default provider always offers SHA3-512
+                throw std::runtime_error("SHA3-512 is not available from the OpenSSL provider");
+                // GCOVR_EXCL_STOP
+            }
+
+            return DIGEST.get();
+        }
+
+        /// Throws std::runtime_error when an OpenSSL call reports failure.
+        ///
+        /// @param RESULT Return value of the OpenSSL call (1 on success)
+        /// @param OPERATION Name of the failed operation for the error message
+        void check(const int RESULT, const char* OPERATION) {
+            if (RESULT != 1) [[unlikely]] {
+                // GCOVR_EXCL_START - EVP digest calls only fail on allocation failure
+                throw std::runtime_error(std::string("SHA3-512 ") + OPERATION + " failed");
+                // GCOVR_EXCL_STOP
+            }
+        }
+    } // anonymous namespace
+
+    /// Allocates a new digest context.
+    ///
+    /// @throws std::runtime_error if OpenSSL cannot allocate the context or
+    ///         provide a SHA3-512 implementation
+    HashContext::HashContext() : ctx_(EVP_MD_CTX_new()) {
+        if (ctx_ == nullptr) [[unlikely]] {
+            // GCOVR_EXCL_START - allocation failure
+            throw std::runtime_error("Failed to allocate SHA3-512 digest context");
+            // GCOVR_EXCL_STOP
+        }
+
+        static_cast<void>(sha3_512());
+    }
+
+    /// Releases the digest context.
+    HashContext::~HashContext() {
+        EVP_MD_CTX_free(ctx_);
+    }
+
+    /// Transfers ownership of the digest context.
+    ///
+    /// @param other Context to move from; left without a digest context
+    HashContext::HashContext(HashContext&& other) noexcept : ctx_(std::exchange(other.ctx_, nullptr)) {
+    }
+
+    /// Transfers ownership of the digest context, releasing the current one.
+    ///
+    /// @param other Context to move from; left without a digest context
+    /// @return Reference to this context
+    HashContext& HashContext::operator=(HashContext&& other) noexcept {
+        if (this != &other) {
+            EVP_MD_CTX_free(ctx_);
+            ctx_ = std::exchange(other.ctx_, nullptr);
+        }
+
+        return *this;
+    }
+
+    /// Starts a new SHA3-512 computation, discarding any previous state.
+    ///
+    /// EVP_DigestInit_ex() resets the existing context in place, so no memory
+    /// is allocated after the first computation on a context.
+    ///
+    /// @throws std::runtime_error if the digest cannot be initialized
+    void HashContext::init() {
+        check(EVP_DigestInit_ex(ctx_, sha3_512(), nullptr), "initialization");
+    }
+
+    /// Absorbs bytes into the current computation.
+    ///
+    /// @param data Bytes to hash
+    /// @throws std::runtime_error if the update fails
+    void HashContext::update(const std::span<const uint8_t> data) {
+        check(EVP_DigestUpdate(ctx_, data.data(), data.size()), "update");
+    }
+
+    /// Completes the current computation and returns the digest.
+    ///
+    /// @return 64-byte SHA3-512 digest
+    /// @throws std::runtime_error if finalization fails
+    utils::Digest HashContext::finalize() {
+        utils::Digest digest{};
+        unsigned int digest_len = 0;
+
+        check(EVP_DigestFinal_ex(ctx_, digest.data(), &digest_len), "finalization");
+
+        return digest;
+    }
+
+    /// Hashes a single contiguous buffer.
+    ///
+    /// @param data Bytes to hash
+    /// @return 64-byte SHA3-512 digest
+    /// @throws std::runtime_error if OpenSSL reports a failure
+    utils::Digest HashContext::hash(const std::span<const uint8_t> data) {
+        init();
+        update(data);
+
+        return finalize();
+    }
+} // namespace visus::cuid2
@@ -0,0 +1,196 @@
+/// @file identifier.cpp
+/// @brief Compact binary CUID2 value type implementation
+///
+/// Characters map to 6-bit codes: 0 for an unused position, 1-10 for '0'-'9'
+/// and 11-36 for 'a'-'z'. Code order matches ASCII order and 0 sorts first, so
+/// the packed 192-bit number compares like the text. Text is checked with
+/// is_cuid2() before any packing.
+
+#include "cuid2/identifier.hpp"
+
+#include <bit>
+#include <stdexcept>
+
+#include "cuid2/validate.hpp"
+
+namespace visus::cuid2 {
+    namespace {
+        /// Bits per packed character.
+        constexpr size_t CODE_BITS = 6;
+
+        /// Total bits in the packed form.
+        constexpr size_t TOTAL_BITS = Cuid2::LIMB_COUNT * 64;
+
+        /// Code of '0'; digits occupy DIGIT_CODE .. DIGIT_CODE + 9.
+        constexpr uint64_t DIGIT_CODE = 1;
+
+        /// Code of 'a'; letters occupy LETTER_CODE .. LETTER_CODE + 25.
+        constexpr uint64_t LETTER_CODE = 11;
+
+        /// Largest valid code ('z').
+        constexpr uint64_t MAX_CODE = LETTER_CODE + 25;
+
+        /// Returns the code of a character already known to be valid.
+        constexpr uint64_t char_to_code(const char CHR) noexcept {
+            return CHR <= '9'
+                ? DIGIT_CODE + static_cast<uint64_t>(CHR - '0')
+                : LETTER_CODE + static_cast<uint64_t>(CHR - 'a');
+        }
+
+        /// Returns the character of a code in [1, MAX_CODE].
+        constexpr char code_to_char(const uint64_t CODE) noexcept {
+            return CODE < LETTER_CODE
+                ? static_cast<char>('0' + (CODE - DIGIT_CODE))
+                : static_cast<char>('a' + (CODE - LETTER_CODE));
+        }
+
+        /// Stores the code of character INDEX, counted from the most
+        /// significant end; codes may straddle two words.
+        constexpr void put_code(Cuid2::Limbs& limbs, const size_t INDEX, const uint64_t CODE) noexcept {
+            const size_t BIT = CODE_BITS * INDEX;
+            const size_t LIMB = BIT / 64;
+            const size_t OFFSET = BIT % 64;
+
+            if (OFFSET <= 64 - CODE_BITS) {
+                limbs[LIMB] |= CODE << (64 - CODE_BITS - OFFSET);
+            } else {
+                const size_t SPILL = OFFSET - (64 - CODE_BITS);
+                limbs[LIMB] |= CODE >> SPILL;
+                limbs[LIMB + 1] |= CODE << (64 - SPILL);
+            }
+        }
+
+        /// Reads the code of character INDEX.
+        constexpr uint64_t get_code(const Cuid2::Limbs& limbs, const size_t INDEX) noexcept {
+            constexpr uint64_t MASK = (uint64_t{1} << CODE_BITS) - 1;
+
+            const size_t BIT = CODE_BITS * INDEX;
+            const size_t LIMB = BIT / 64;
+            const size_t OFFSET = BIT % 64;
+
+            if (OFFSET <= 64 - CODE_BITS) {
+                return (limbs[LIMB] >> (64 - CODE_BITS - OFFSET)) & MASK;
+            }
+
+            const size_t SPILL = OFFSET - (64 - CODE_BITS);
+
+            return ((limbs[LIMB] << SPILL) | (limbs[LIMB + 1] >> (64 - SPILL))) & MASK;
+        }
+
+        /// Returns the number of characters encoded in LIMBS.
+        ///
+        /// Every stored code is non-zero, so the length follows from the
+        /// number of trailing zero bits.
+        size_t packed_length(const Cuid2::Limbs& limbs) noexcept {
+            size_t trailing_zeros = 0;
+
+            for (size_t idx = Cuid2::LIMB_COUNT; idx-- > 0;) {
+                if (limbs[idx] != 0) {
+                    trailing_zeros += static_cast<size_t>(std::countr_zero(limbs[idx]));
+                    return (TOTAL_BITS - trailing_zeros + CODE_BITS - 1) / CODE_BITS;
+                }
+
+                trailing_zeros += 64;
+            }
+
+            return 0;
+        }
+
+        /// Packs text already checked by is_cuid2().
+        Cuid2::Limbs pack(const std::string_view TEXT) noexcept {
+            Cuid2::Limbs limbs{};
+
+            for (size_t idx = 0; idx < TEXT.size(); ++idx) {
+                put_code(limbs, idx, char_to_code(TEXT[idx]));
+            }
+
+            return limbs;
+        }
+    } // anonymous namespace
+
+    /// Parses identifier text.
+    ///
+    /// @param TEXT Identifier text
+    /// @return The packed identifier
+    /// @throws std::invalid_argument if TEXT is not a valid CUID2
+    Cuid2 Cuid2::parse(const std::string_view TEXT) {
+        if (!is_cuid2(TEXT)) [[unlikely]] {
+            throw std::invalid_argument("TEXT is not a valid CUID2");
+        }
+
+        return Cuid2(pack(TEXT));
+    }
+
+    /// Parses identifier text without throwing.
+    ///
+    /// @param TEXT Identifier text
+    /// @return The packed identifier, or empty if TEXT is not a valid CUID2
+    std::optional<Cuid2> Cuid2::try_parse(const std::string_view TEXT) noexcept {
+        if (!is_cuid2(TEXT)) [[unlikely]] {
+            return std::nullopt;
+        }
+
+        return Cuid2(pack(TEXT));
+    }
+
+    /// Reconstructs a value from packed words.
+    ///
+    /// The length is implied by the lowest set bit, so bits after it are zero
+    /// by construction; every code up to it must be a valid character, the
+    /// first a letter, and the length 4-32.
+    ///
+    /// @param LIMBS Packed words
+    /// @return The packed identifier
+    /// @throws std::invalid_argument if LIMBS do not encode a valid CUID2
+    Cuid2 Cuid2::from_limbs(const Limbs& LIMBS) {
+        const size_t LENGTH = packed_length(LIMBS);
+        bool valid = LENGTH >= static_cast<size_t>(MIN_CUID2_LENGTH) && get_code(LIMBS, 0) >= LETTER_CODE;
+
+        for (size_t idx = 0; valid && idx < LENGTH; ++idx) {
+            const uint64_t CODE = get_code(LIMBS, idx);
+            valid = CODE != 0 && CODE <= MAX_CODE;
+        }
+
+        if (!valid) [[unlikely]] {
+            throw std::invalid_argument("LIMBS do not encode a valid CUID2");
+        }
+
+        return Cuid2(LIMBS);
+    }
+
+    /// Returns the identifier length in characters.
+    ///
+    /// @return Number of characters, or 0 for an empty value
+    std::size_t Cuid2::size() const noexcept {
+        return packed_length(limbs_);
+    }
+
+    /// Writes the identifier text into [first, last).
+    ///
+    /// @param first Start of the destination range
+    /// @param last End of the destination range
+    /// @return End of the written text and an error code
+    std::to_chars_result Cuid2::to_chars(char* first, char* last) const noexcept {
+        const size_t LENGTH = size();
+
+        if (static_cast<size_t>(last - first) < LENGTH) [[unlikely]] {
+            return {last, std::errc::value_too_large};
+        }
+
+        for (size_t idx = 0; idx < LENGTH; ++idx) {
+            first[idx] = code_to_char(get_code(limbs_, idx));
+        }
+
+        return {first + LENGTH, std::errc{}};
+    }
+
+    /// Returns the identifier text.
+    ///
+    /// @return Identifier string, empty for an empty value
+    std::string Cuid2::str() const {
+        std::array<char, MAX_CUID2_LENGTH> buffer{};
+        const auto RESULT = to_chars(buffer.data(), buffer.data() + buffer.size());
+
+        return {buffer.data(), RESULT.ptr};
+    }
+} // namespace visus::cuid2
@@ -0,0 +1,62 @@
+/// @file instrumentation.hpp
+/// @brief Internal recording hooks behind the stats.hpp counters
+///
+/// Internal header for the translation units of the generation pipeline. The
+/// hooks depend on CUID2_ENABLE_INSTRUMENTATION as seen by the library build,
+/// so this header is not installed. When the option is off, StageTimer is an
+/// empty object and record_identifiers() an empty inline function, so the
+/// optimizer removes every hook.
+
+#ifndef LIBCUID2_INSTRUMENTATION_HPP
+#define LIBCUID2_INSTRUMENTATION_HPP
+
+#include <cstdint>
+
+#include "cuid2/stats.hpp"
+
+namespace visus::cuid2::instrumentation {
+#ifdef CUID2_ENABLE_INSTRUMENTATION
+    /// Whether the hooks record anything in this build.
+    constexpr bool ENABLED = true;
+
+    /// Reads the cheapest monotonic cycle source on this platform.
+    [[nodiscard]] uint64_t read_cycles() noexcept;
+
+    /// Adds one call of STAGE lasting CYCLES to the calling thread's counters.
+    void record_stage(Stage STAGE, uint64_t CYCLES) noexcept;
+
+    /// Adds COUNT identifiers to the calling thread's counters and runs the
+    /// stats callback when its interval has elapsed.
+    void record_identifiers(uint64_t COUNT);
+
+    /// Times the enclosing scope as one call of a stage.
+    class StageTimer {
+        Stage stage_;
+        uint64_t start_;
+
+    public:
+        explicit StageTimer(const Stage STAGE) noexcept : stage_(STAGE), start_(read_cycles()) {}
+
+        ~StageTimer() {
+            record_stage(stage_, read_cycles() - start_);
+        }
+
+        StageTimer(const StageTimer&) = delete;
+        StageTimer& operator=(const StageTimer&) = delete;
+    };
+#else
+    constexpr bool ENABLED = false;
+
+    inline void record_identifiers(uint64_t) noexcept {}
+
+    class StageTimer {
+    public:
+        explicit StageTimer(Stage) noexcept {}
+
+        StageTimer(const StageTimer&) = delete;
+        StageTimer& operator=(const StageTimer&) = delete;
+    };
+#endif
+} // namespace visus::cuid2::instrumentation
+
+#endif // LIBCUID2_INSTRUMENTATION_HPP
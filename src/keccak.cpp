@@ -0,0 +1,217 @@
+/// @file keccak.cpp
+/// @brief Multi-buffer SHA3-512 dispatch and scalar backend
+///
+/// This file selects the widest Keccak backend supported by the running CPU and
+/// splits strided message batches into groups of that backend's lane count.
+/// The SIMD kernels live in keccak_avx2.cpp, keccak_avx512.cpp and
+/// keccak_neon.cpp, each compiled with its own instruction-set flags.
+
+#include "cuid2/keccak.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+#include "keccak_permutation.hpp"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+    #include <immintrin.h>
+    #include <intrin.h>
+#endif
+
+namespace visus::cuid2::keccak {
+    namespace {
+        /// Signature shared by all multi-lane kernels.
+        using Kernel = void (*)(const uint8_t* const*, size_t, utils::Digest*) noexcept;
+
+        /// Hashes a single message with the portable implementation.
+        void sha3_512_scalar(const uint8_t* const* messages, const size_t LENGTH, utils::Digest* digests) noexcept {
+            sha3_512_lanes<ScalarOps>(messages, LENGTH, digests);
+        }
+
+        /// Returns the multi-lane kernel for a supported backend.
+        Kernel kernel_for(const Backend BACKEND) noexcept {
+            switch (BACKEND) {
+#if defined(__x86_64__) || defined(_M_X64)
+                case Backend::avx2:
+                    return sha3_512_x4_avx2;
+                case Backend::avx512:
+                    return sha3_512_x8_avx512;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+                case Backend::neon:
+                    return sha3_512_x2_neon;
+#endif
+                default:
+                    return sha3_512_scalar;
+            }
+        }
+
+        /// Queries the CPU for the widest usable backend.
+        ///
+        /// On x86-64 both the instruction set and operating system support for
+        /// the wider register state are required. AArch64 always has NEON.
+        ///
+        /// @return Widest backend the running CPU supports
+        Backend query_cpu() noexcept {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx512f")) {
+                return Backend::avx512;
+            }
+
+            if (__builtin_cpu_supports("avx2")) {
+                return Backend::avx2;
+            }
+
+            return Backend::scalar;
+#elif defined(_MSC_VER) && defined(_M_X64)
+            constexpr int OSXSAVE_BIT = 1 << 27;
+            constexpr int AVX2_BIT = 1 << 5;
+            constexpr int AVX512F_BIT = 1 << 16;
+            constexpr unsigned long long YMM_STATE = 0x6;
+            constexpr unsigned long long ZMM_STATE = 0xE6;
+
+            std::array<int, 4> registers{};
+            __cpuid(registers.data(), 1);
+            if ((registers[2] & OSXSAVE_BIT) == 0) {
+                return Backend::scalar;
+            }
+
+            const unsigned long long XCR0 = _xgetbv(0);
+            __cpuidex(registers.data(), 7, 0);
+
+            if ((registers[1] & AVX512F_BIT) != 0 && (XCR0 & ZMM_STATE) == ZMM_STATE) {
+                return Backend::avx512;
+            }
+
+            if ((registers[1] & AVX2_BIT) != 0 && (XCR0 & YMM_STATE) == YMM_STATE) {
+                return Backend::avx2;
+            }
+
+            return Backend::scalar;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+            return Backend::neon;
+#else
+            return Backend::scalar;
+#endif
+        }
+    } // anonymous namespace
+
+    /// Returns the widest backend supported by the compiler and running CPU.
+    ///
+    /// @return Preferred backend for this process
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    Backend detect_backend() noexcept {
+        static const Backend DETECTED = query_cpu();
+
+        return DETECTED;
+    }
+
+    /// Reports whether a backend can run on this build and CPU.
+    ///
+    /// Backends are ordered by width within each architecture, so a backend is
+    /// usable when it is not wider than the detected one.
+    ///
+    /// @param BACKEND Backend to check
+    /// @return true if sha3_512_strided() may be called with BACKEND
+    bool is_supported(const Backend BACKEND) noexcept {
+        const Backend DETECTED = detect_backend();
+
+        switch (BACKEND) {
+            case Backend::scalar:
+                return true;
+            case Backend::avx2:
+                return DETECTED == Backend::avx2 || DETECTED == Backend::avx512;
+            case Backend::avx512:
+                return DETECTED == Backend::avx512;
+            case Backend::neon:
+                return DETECTED == Backend::neon;
+        }
+
+        // GCOVR_EXCL_START - every enumerator is handled above
+        return false;
+        // GCOVR_EXCL_STOP
+    }
+
+    /// Returns the number of messages a backend hashes per permutation call.
+    ///
+    /// @param BACKEND Backend to query
+    /// @return 1, 2, 4 or 8
+    size_t lane_count(const Backend BACKEND) noexcept {
+        switch (BACKEND) {
+            case Backend::avx2:
+                return 4;
+            case Backend::avx512:
+                return 8;
+            case Backend::neon:
+                return 2;
+            default:
+                return 1;
+        }
+    }
+
+    /// Returns a short human-readable backend name.
+    ///
+    /// @param BACKEND Backend to name
+    /// @return Name with static storage duration
+    std::string_view backend_name(const Backend BACKEND) noexcept {
+        switch (BACKEND) {
+            case Backend::avx2:
+                return "avx2";
+            case Backend::avx512:
+                return "avx512";
+            case Backend::neon:
+                return "neon";
+            default:
+                return "scalar";
+        }
+    }
+
+    /// Computes SHA3-512 of many equal-length messages laid out at a fixed stride.
+    ///
+    /// @param messages Buffer holding digests.size() messages
+    /// @param STRIDE Distance in bytes between consecutive messages
+    /// @param LENGTH Length of every message in bytes (at most STRIDE)
+    /// @param digests Output digests, one per message
+    /// @param BACKEND Backend to use; must satisfy is_supported()
+    /// @throws std::invalid_argument if the buffer is too small or BACKEND is unsupported
+    void sha3_512_strided(
+        const std::span<const uint8_t> messages,
+        const size_t STRIDE,
+        const size_t LENGTH,
+        const std::span<utils::Digest> digests,
+        const Backend BACKEND
+    ) {
+        if (!is_supported(BACKEND)) [[unlikely]] {
+            throw std::invalid_argument("Keccak backend is not supported on this CPU");
+        }
+
+        if (digests.empty()) [[unlikely]] {
+            return;
+        }
+
+        if (LENGTH > STRIDE || messages.size() < (digests.size() - 1) * STRIDE + LENGTH) [[unlikely]] {
+            throw std::invalid_argument("messages buffer is too small for the requested layout");
+        }
+
+        const size_t LANES = lane_count(BACKEND);
+        const Kernel KERNEL = kernel_for(BACKEND);
+
+        std::array<const uint8_t*, MAX_LANES> pointers{};
+
+        size_t first = 0;
+        for (; first + LANES <= digests.size(); first += LANES) {
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                pointers[lane] = messages.data() + (first + lane) * STRIDE;
+            }
+
+            KERNEL(pointers.data(), LENGTH, digests.data() + first);
+        }
+
+        for (; first < digests.size(); ++first) {
+            pointers[0] = messages.data() + first * STRIDE;
+            sha3_512_scalar(pointers.data(), LENGTH, digests.data() + first);
+        }
+    }
+} // namespace visus::cuid2::keccak
@@ -0,0 +1,67 @@
+/// @file keccak_avx2.cpp
+/// @brief Four-lane AVX2 Keccak backend
+///
+/// Compiled with AVX2 enabled; only called after detect_backend() has
+/// confirmed CPU and operating system support.
+
+#include <immintrin.h>
+
+#include "keccak_permutation.hpp"
+
+namespace visus::cuid2::keccak {
+    namespace {
+        /// Four Keccak states per 256-bit vector.
+        struct Avx2Ops {
+            using Vec = __m256i;
+
+            static constexpr size_t LANES = 4;
+
+            static Vec broadcast(const uint64_t VALUE) noexcept {
+                return _mm256_set1_epi64x(static_cast<long long>(VALUE));
+            }
+
+            static Vec xor_(const Vec LHS, const Vec RHS) noexcept {
+                return _mm256_xor_si256(LHS, RHS);
+            }
+
+            static Vec andnot(const Vec LHS, const Vec RHS) noexcept {
+                return _mm256_andnot_si256(LHS, RHS);
+            }
+
+            template <int N>
+            static Vec rotl(const Vec VALUE) noexcept {
+                if constexpr (N == 0) {
+                    return VALUE;
+                } else {
+                    return _mm256_or_si256(_mm256_slli_epi64(VALUE, N), _mm256_srli_epi64(VALUE, 64 - N));
+                }
+            }
+
+            static Vec load(const uint8_t* const* blocks, const size_t OFFSET) noexcept {
+                return _mm256_set_epi64x(
+                    static_cast<long long>(load_lane(blocks[3] + OFFSET)),
+                    static_cast<long long>(load_lane(blocks[2] + OFFSET)),
+                    static_cast<long long>(load_lane(blocks[1] + OFFSET)),
+                    static_cast<long long>(load_lane(blocks[0] + OFFSET)));
+            }
+
+            static void store(const Vec VALUE, utils::Digest* digests, const size_t OFFSET) noexcept {
+                alignas(32) std::array<uint64_t, LANES> lanes{};
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lanes.data()), VALUE);
+
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    store_lane(digests[lane].data() + OFFSET, lanes[lane]);
+                }
+            }
+        };
+    } // anonymous namespace
+
+    /// Hashes four equal-length messages with AVX2.
+    ///
+    /// @param messages Four pointers to LENGTH bytes each
+    /// @param LENGTH Length of every message in bytes
+    /// @param digests Four digests to write
+    void sha3_512_x4_avx2(const uint8_t* const* messages, const size_t LENGTH, utils::Digest* digests) noexcept {
+        sha3_512_lanes<Avx2Ops>(messages, LENGTH, digests);
+    }
+} // namespace visus::cuid2::keccak
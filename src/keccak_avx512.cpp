@@ -0,0 +1,72 @@
+/// @file keccak_avx512.cpp
+/// @brief Eight-lane AVX-512F Keccak backend
+///
+/// Compiled with AVX-512F enabled; only called after detect_backend() has
+/// confirmed CPU and operating system support. Uses the native 64-bit rotate
+/// instead of a shift pair.
+
+#include <immintrin.h>
+
+#include "keccak_permutation.hpp"
+
+namespace visus::cuid2::keccak {
+    namespace {
+        /// Eight Keccak states per 512-bit vector.
+        struct Avx512Ops {
+            using Vec = __m512i;
+
+            static constexpr size_t LANES = 8;
+
+            static Vec broadcast(const uint64_t VALUE) noexcept {
+                return _mm512_set1_epi64(static_cast<long long>(VALUE));
+            }
+
+            static Vec xor_(const Vec LHS, const Vec RHS) noexcept {
+                return _mm512_xor_si512(LHS, RHS);
+            }
+
+            static Vec andnot(const Vec LHS, const Vec RHS) noexcept {
+                return _mm512_andnot_si512(LHS, RHS);
+            }
+
+            template <int N>
+            static Vec rotl(const Vec VALUE) noexcept {
+                if constexpr (N == 0) {
+                    return VALUE;
+                } else {
+                    return _mm512_rol_epi64(VALUE, N);
+                }
+            }
+
+            static Vec load(const uint8_t* const* blocks, const size_t OFFSET) noexcept {
+                return _mm512_set_epi64(
+                    static_cast<long long>(load_lane(blocks[7] + OFFSET)),
+                    static_cast<long long>(load_lane(blocks[6] + OFFSET)),
+                    static_cast<long long>(load_lane(blocks[5] + OFFSET)),
+                    static_cast<long long>(load_lane(blocks[4] + OFFSET)),
+                    static_cast<long long>(load_lane(blocks[3] + OFFSET)),
+                    static_cast<long long>(load_lane(blocks[2] + OFFSET)),
+                    static_cast<long long>(load_lane(blocks[1] + OFFSET)),
+                    static_cast<long long>(load_lane(blocks[0] + OFFSET)));
+            }
+
+            static void store(const Vec VALUE, utils::Digest* digests, const size_t OFFSET) noexcept {
+                alignas(64) std::array<uint64_t, LANES> lanes{};
+                _mm512_store_si512(lanes.data(), VALUE);
+
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    store_lane(digests[lane].data() + OFFSET, lanes[lane]);
+                }
+            }
+        };
+    } // anonymous namespace
+
+    /// Hashes eight equal-length messages with AVX-512F.
+    ///
+    /// @param messages Eight pointers to LENGTH bytes each
+    /// @param LENGTH Length of every message in bytes
+    /// @param digests Eight digests to write
+    void sha3_512_x8_avx512(const uint8_t* const* messages, const size_t LENGTH, utils::Digest* digests) noexcept {
+        sha3_512_lanes<Avx512Ops>(messages, LENGTH, digests);
+    }
+} // namespace visus::cuid2::keccak
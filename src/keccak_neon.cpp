@@ -0,0 +1,62 @@
+/// @file keccak_neon.cpp
+/// @brief Two-lane NEON Keccak backend
+///
+/// NEON is part of the AArch64 baseline, so this backend needs no runtime
+/// check. Rotations use shift-left plus shift-right-and-insert with immediate
+/// offsets.
+
+#include <arm_neon.h>
+
+#include "keccak_permutation.hpp"
+
+namespace visus::cuid2::keccak {
+    namespace {
+        /// Two Keccak states per 128-bit vector.
+        struct NeonOps {
+            using Vec = uint64x2_t;
+
+            static constexpr size_t LANES = 2;
+
+            static Vec broadcast(const uint64_t VALUE) noexcept {
+                return vdupq_n_u64(VALUE);
+            }
+
+            static Vec xor_(const Vec LHS, const Vec RHS) noexcept {
+                return veorq_u64(LHS, RHS);
+            }
+
+            static Vec andnot(const Vec LHS, const Vec RHS) noexcept {
+                return vbicq_u64(RHS, LHS);
+            }
+
+            template <int N>
+            static Vec rotl(const Vec VALUE) noexcept {
+                if constexpr (N == 0) {
+                    return VALUE;
+                } else {
+                    return vsriq_n_u64(vshlq_n_u64(VALUE, N), VALUE, 64 - N);
+                }
+            }
+
+            static Vec load(const uint8_t* const* blocks, const size_t OFFSET) noexcept {
+                return vcombine_u64(
+                    vcreate_u64(load_lane(blocks[0] + OFFSET)),
+                    vcreate_u64(load_lane(blocks[1] + OFFSET)));
+            }
+
+            static void store(const Vec VALUE, utils::Digest* digests, const size_t OFFSET) noexcept {
+                store_lane(digests[0].data() + OFFSET, vgetq_lane_u64(VALUE, 0));
+                store_lane(digests[1].data() + OFFSET, vgetq_lane_u64(VALUE, 1));
+            }
+        };
+    } // anonymous namespace
+
+    /// Hashes two equal-length messages with NEON.
+    ///
+    /// @param messages Two pointers to LENGTH bytes each
+    /// @param LENGTH Length of every message in bytes
+    /// @param digests Two digests to write
+    void sha3_512_x2_neon(const uint8_t* const* messages, const size_t LENGTH, utils::Digest* digests) noexcept {
+        sha3_512_lanes<NeonOps>(messages, LENGTH, digests);
+    }
+} // namespace visus::cuid2::keccak
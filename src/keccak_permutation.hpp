@@ -0,0 +1,240 @@
+/// @file keccak_permutation.hpp
+/// @brief Lane-generic Keccak-f[1600] permutation and SHA3-512 sponge
+///
+/// Internal header shared by the scalar and SIMD Keccak translation units. The
+/// permutation and sponge are written once against a small set of vector
+/// operations; each backend supplies an operations type whose vector holds the
+/// same state lane of several independent Keccak states. Every backend file is
+/// compiled with its own instruction-set flags, so everything here has
+/// internal linkage to keep differently compiled instantiations from being
+/// merged by the linker.
+
+#ifndef LIBCUID2_KECCAK_PERMUTATION_HPP
+#define LIBCUID2_KECCAK_PERMUTATION_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include <boost/endian/conversion.hpp>
+
+#include "cuid2/keccak.hpp"
+
+namespace visus::cuid2::keccak {
+    namespace {
+        /// Number of 64-bit lanes in a Keccak-f[1600] state.
+        constexpr size_t STATE_LANES = 25;
+
+        /// Number of rounds in Keccak-f[1600].
+        constexpr size_t ROUNDS = 24;
+
+        /// SHA3-512 rate in bytes (1600 - 2 * 512 bits).
+        constexpr size_t RATE_BYTES = 72;
+
+        /// SHA3-512 rate in 64-bit lanes.
+        constexpr size_t RATE_LANES = RATE_BYTES / sizeof(uint64_t);
+
+        /// SHA3-512 output size in 64-bit lanes.
+        constexpr size_t DIGEST_LANES = utils::DIGEST_SIZE / sizeof(uint64_t);
+
+        /// SHA-3 domain separation and first padding bit.
+        constexpr uint8_t SHA3_DOMAIN_PAD = 0x06;
+
+        /// Final padding bit of the pad10*1 rule.
+        constexpr uint8_t FINAL_PAD = 0x80;
+
+        /// Iota round constants.
+        constexpr std::array<uint64_t, ROUNDS> ROUND_CONSTANTS = {
+            0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL, 0x8000000080008000ULL,
+            0x000000000000808BULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+            0x000000000000008AULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+            0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+            0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800AULL, 0x800000008000000AULL,
+            0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL,
+        };
+
+        /// Rho rotation offsets, indexed by lane x + 5y.
+        constexpr std::array<int, STATE_LANES> RHO_OFFSETS = {
+            0, 1, 62, 28, 27,
+            36, 44, 6, 55, 20,
+            3, 10, 43, 25, 39,
+            41, 45, 15, 21, 8,
+            18, 2, 61, 56, 14,
+        };
+
+        /// Destination of lane x + 5y under pi: (x, y) -> (y, 2x + 3y).
+        constexpr size_t pi_destination(const size_t INDEX) noexcept {
+            const size_t X = INDEX % 5;
+            const size_t Y = INDEX / 5;
+
+            return Y + 5 * ((2 * X + 3 * Y) % 5);
+        }
+
+        /// Applies rho and pi with compile-time rotation offsets.
+        ///
+        /// Constant offsets let backends use immediate shift forms, which NEON
+        /// requires.
+        template <class Ops, size_t... I>
+        inline void rho_pi(const typename Ops::Vec* state, typename Ops::Vec* out, std::index_sequence<I...>) noexcept {
+            ((out[pi_destination(I)] = Ops::template rotl<RHO_OFFSETS[I]>(state[I])), ...);
+        }
+
+        /// Applies the 24-round Keccak-f[1600] permutation to Ops::LANES states.
+        ///
+        /// @param state 25 vectors, vector i holding lane i of every state
+        template <class Ops>
+        inline void permute(typename Ops::Vec* state) noexcept {
+            using Vec = typename Ops::Vec;
+
+            for (const uint64_t ROUND_CONSTANT : ROUND_CONSTANTS) {
+                // Theta
+                // Plain arrays: std::array would drop the vector types' alignment attributes.
+                Vec parity[5];
+                for (size_t x = 0; x < 5; ++x) {
+                    parity[x] = Ops::xor_(
+                        Ops::xor_(Ops::xor_(state[x], state[x + 5]), Ops::xor_(state[x + 10], state[x + 15])),
+                        state[x + 20]);
+                }
+
+                for (size_t x = 0; x < 5; ++x) {
+                    const Vec EFFECT = Ops::xor_(parity[(x + 4) % 5], Ops::template rotl<1>(parity[(x + 1) % 5]));
+                    for (size_t y = 0; y < STATE_LANES; y += 5) {
+                        state[x + y] = Ops::xor_(state[x + y], EFFECT);
+                    }
+                }
+
+                // Rho and pi
+                Vec moved[STATE_LANES];
+                rho_pi<Ops>(state, moved, std::make_index_sequence<STATE_LANES>{});
+
+                // Chi
+                for (size_t y = 0; y < STATE_LANES; y += 5) {
+                    for (size_t x = 0; x < 5; ++x) {
+                        state[x + y] = Ops::xor_(moved[x + y], Ops::andnot(moved[(x + 1) % 5 + y], moved[(x + 2) % 5 + y]));
+                    }
+                }
+
+                // Iota
+                state[0] = Ops::xor_(state[0], Ops::broadcast(ROUND_CONSTANT));
+            }
+        }
+
+        /// Reads a little-endian 64-bit lane from unaligned memory.
+        inline uint64_t load_lane(const uint8_t* data) noexcept {
+            uint64_t value = 0;
+            std::memcpy(&value, data, sizeof(value));
+
+            return boost::endian::little_to_native(value);
+        }
+
+        /// Writes a 64-bit lane to unaligned memory in little-endian order.
+        inline void store_lane(uint8_t* data, const uint64_t VALUE) noexcept {
+            const uint64_t LITTLE = boost::endian::native_to_little(VALUE);
+            std::memcpy(data, &LITTLE, sizeof(LITTLE));
+        }
+
+        /// Computes SHA3-512 of Ops::LANES equal-length messages at once.
+        ///
+        /// Full rate blocks are absorbed straight from the messages; the final
+        /// partial block of each message is padded in a small per-lane buffer.
+        ///
+        /// @param messages Ops::LANES pointers to LENGTH bytes each
+        /// @param LENGTH Length of every message in bytes
+        /// @param digests Ops::LANES digests to write
+        template <class Ops>
+        inline void sha3_512_lanes(const uint8_t* const* messages, const size_t LENGTH, utils::Digest* digests) noexcept {
+            using Vec = typename Ops::Vec;
+
+            Vec state[STATE_LANES];
+            for (auto& lane : state) {
+                lane = Ops::broadcast(0);
+            }
+
+            std::array<const uint8_t*, Ops::LANES> blocks{};
+
+            size_t offset = 0;
+            for (; offset + RATE_BYTES <= LENGTH; offset += RATE_BYTES) {
+                for (size_t lane = 0; lane < Ops::LANES; ++lane) {
+                    blocks[lane] = messages[lane] + offset;
+                }
+
+                for (size_t idx = 0; idx < RATE_LANES; ++idx) {
+                    state[idx] = Ops::xor_(state[idx], Ops::load(blocks.data(), idx * sizeof(uint64_t)));
+                }
+
+                permute<Ops>(state);
+            }
+
+            const size_t REMAINDER = LENGTH - offset;
+            std::array<std::array<uint8_t, RATE_BYTES>, Ops::LANES> padded{};
+
+            for (size_t lane = 0; lane < Ops::LANES; ++lane) {
+                std::memcpy(padded[lane].data(), messages[lane] + offset, REMAINDER);
+                padded[lane][REMAINDER] = SHA3_DOMAIN_PAD;
+                padded[lane][RATE_BYTES - 1] |= FINAL_PAD;
+                blocks[lane] = padded[lane].data();
+            }
+
+            for (size_t idx = 0; idx < RATE_LANES; ++idx) {
+                state[idx] = Ops::xor_(state[idx], Ops::load(blocks.data(), idx * sizeof(uint64_t)));
+            }
+
+            permute<Ops>(state);
+
+            for (size_t idx = 0; idx < DIGEST_LANES; ++idx) {
+                Ops::store(state[idx], digests, idx * sizeof(uint64_t));
+            }
+        }
+
+        /// Single-state operations on plain 64-bit integers.
+        struct ScalarOps {
+            using Vec = uint64_t;
+
+            static constexpr size_t LANES = 1;
+
+            static Vec broadcast(const uint64_t VALUE) noexcept {
+                return VALUE;
+            }
+
+            static Vec xor_(const Vec LHS, const Vec RHS) noexcept {
+                return LHS ^ RHS;
+            }
+
+            static Vec andnot(const Vec LHS, const Vec RHS) noexcept {
+                return ~LHS & RHS;
+            }
+
+            template <int N>
+            static Vec rotl(const Vec VALUE) noexcept {
+                if constexpr (N == 0) {
+                    return VALUE;
+                } else {
+                    return (VALUE << N) | (VALUE >> (64 - N));
+                }
+            }
+
+            static Vec load(const uint8_t* const* blocks, const size_t OFFSET) noexcept {
+                return load_lane(blocks[0] + OFFSET);
+            }
+
+            static void store(const Vec VALUE, utils::Digest* digests, const size_t OFFSET) noexcept {
+                store_lane(digests[0].data() + OFFSET, VALUE);
+            }
+        };
+    } // anonymous namespace
+
+#if defined(__x86_64__) || defined(_M_X64)
+    /// Hashes four equal-length messages with AVX2 (keccak_avx2.cpp).
+    void sha3_512_x4_avx2(const uint8_t* const* messages, size_t LENGTH, utils::Digest* digests) noexcept;
+
+    /// Hashes eight equal-length messages with AVX-512F (keccak_avx512.cpp).
+    void sha3_512_x8_avx512(const uint8_t* const* messages, size_t LENGTH, utils::Digest* digests) noexcept;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    /// Hashes two equal-length messages with NEON (keccak_neon.cpp).
+    void sha3_512_x2_neon(const uint8_t* const* messages, size_t LENGTH, utils::Digest* digests) noexcept;
+#endif
+} // namespace visus::cuid2::keccak
+
+#endif // LIBCUID2_KECCAK_PERMUTATION_HPP
@@ -6,37 +6,235 @@
 /// between Windows (MSVC/MinGW) and POSIX (Linux/macOS/BSD) implementations.
 ///
 /// Key abstractions:
-/// - Cryptographically secure random number generation (OpenSSL)
+/// - Cryptographically secure random number generation from a selectable
+///   EntropySource (OpenSSL by default, see entropy.cpp), served from a
+///   per-thread buffer that is refilled in bulk
 /// - Hostname retrieval with fallback to random generation
-/// - Process ID retrieval
+/// - Process ID and NUMA node retrieval
 /// - Environment variable enumeration with automatic UTF-8 conversion
 
 #include "cuid2/platform.hpp"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <bit>
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <functional>
+#include <memory>
+#include <optional>
+#include <span>
 #include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
 
-#include <openssl/rand.h>
+#include <openssl/crypto.h>
 
 #include <fmt/core.h>
 
 #ifdef _WIN32
+    #include <cwchar>
     #include <memory>
     #include <windows.h> // NOSONAR(S3806) - Microsoft uses lowercase windows.h
     #include <processenv.h>
     #include <boost/nowide/convert.hpp>
 #else
-    #include <cstring>
-
+    #include <pthread.h>
     #include <unistd.h>
+    #ifdef __linux__
+        #include <sched.h>
+        #include <sys/syscall.h>
+    #endif
 extern char **environ; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables) NOSONAR(S5421) - POSIX-compliant implementation
 #endif
 
+#ifndef CUID2_RANDOM_POOL_SIZE
+    #define CUID2_RANDOM_POOL_SIZE 4096
+#endif
+
 namespace visus::cuid2::platform {
     namespace {
+        /// Size in bytes of each thread's entropy buffer; 0 disables buffering.
+        constexpr size_t RANDOM_POOL_SIZE = CUID2_RANDOM_POOL_SIZE;
+
+        /// Requests larger than this bypass the buffer and go straight to the
+        /// entropy source, so a single large request cannot discard most of a refill.
+        constexpr size_t MAX_POOLED_REQUEST = RANDOM_POOL_SIZE / 4;
+
+        /// Incremented in the child after every fork() and by
+        /// start_new_generation(). State derived from an older generation, such
+        /// as buffered random bytes, is refreshed so that parent and child never
+        /// hand out the same values.
+        std::atomic<uint64_t> generation{0};
+
+        /// Registers the fork handler that advances the generation.
+        ///
+        /// Runs once per process on the first generation query. The handler is
+        /// inherited by children, so it only needs registering once. It only
+        /// performs an atomic increment, which is safe in a child forked from a
+        /// multithreaded parent; everything else is refreshed lazily.
+        void register_fork_handler() noexcept {
+#ifndef _WIN32
+            static const bool REGISTERED = [] {
+                return pthread_atfork(nullptr, nullptr, [] {
+                    generation.fetch_add(1, std::memory_order_relaxed);
+                }) == 0;
+            }();
+            static_cast<void>(REGISTERED);
+#endif
+        }
+
+        /// Entropy factory chosen by set_entropy_source().
+        ///
+        /// Selections are immutable and kept until exit, so a thread can tell
+        /// that the selection changed by comparing pointers, without a lock
+        /// that a fork() could leave held in the child.
+        struct EntropySelection {
+            /// Factory for each thread's source; empty for OpenSSL RAND_bytes().
+            EntropyFactory factory{};
+
+            /// Selection this one replaced, or nullptr for the first.
+            const EntropySelection* previous = nullptr;
+        };
+
+        /// Owner of every published EntropySelection.
+        class SelectionRegistry {
+            std::atomic<const EntropySelection*> current_{nullptr};
+
+        public:
+            SelectionRegistry() = default;
+
+            ~SelectionRegistry() {
+                const EntropySelection* selection = current_.load(std::memory_order_acquire);
+
+                while (selection != nullptr) {
+                    const EntropySelection* previous = selection->previous;
+                    delete selection;
+                    selection = previous;
+                }
+            }
+
+            SelectionRegistry(const SelectionRegistry&) = delete;
+            SelectionRegistry& operator=(const SelectionRegistry&) = delete;
+            SelectionRegistry(SelectionRegistry&&) = delete;
+            SelectionRegistry& operator=(SelectionRegistry&&) = delete;
+
+            /// Returns the latest selection, or nullptr if none was made.
+            [[nodiscard]] const EntropySelection* current() const noexcept {
+                return current_.load(std::memory_order_acquire);
+            }
+
+            /// Makes factory the selection seen by every thread's next request.
+            void publish(EntropyFactory factory) {
+                auto selection = std::make_unique<EntropySelection>();
+                selection->factory = std::move(factory);
+                selection->previous = current_.load(std::memory_order_relaxed);
+
+                while (!current_.compare_exchange_weak(selection->previous, selection.get(),
+                                                       std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                }
+
+                static_cast<void>(selection.release());
+            }
+        };
+
+        /// Returns the process-wide selection registry.
+        SelectionRegistry& selections() {
+            static SelectionRegistry INSTANCE;
+
+            return INSTANCE;
+        }
+
+        /// Per-thread entropy source and buffer of its output.
+        ///
+        /// Bytes are handed out front to back and wiped as soon as they are
+        /// copied out, so the buffer only ever holds bytes that have not been
+        /// returned to a caller. Whatever remains is wiped at thread exit. The
+        /// source and buffer are replaced together when the process generation
+        /// or the selected source changes.
+        class ThreadEntropy {
+            std::unique_ptr<EntropySource> source_;
+            const EntropySelection* selection_ = nullptr;
+            uint64_t generation_ = 0;
+            std::array<unsigned char, RANDOM_POOL_SIZE> bytes_{};
+            size_t offset_ = RANDOM_POOL_SIZE;
+
+        public:
+            ThreadEntropy() = default;
+
+            ~ThreadEntropy() {
+                OPENSSL_cleanse(bytes_.data(), bytes_.size());
+            }
+
+            ThreadEntropy(const ThreadEntropy&) = delete;
+            ThreadEntropy& operator=(const ThreadEntropy&) = delete;
+            ThreadEntropy(ThreadEntropy&&) = delete;
+            ThreadEntropy& operator=(ThreadEntropy&&) = delete;
+
+            /// Returns the thread's source, replacing it first if it is stale.
+            ///
+            /// @return Source for the current generation and selection
+            /// @throws std::runtime_error if a new source cannot be created
+            EntropySource& source() {
+                const uint64_t GENERATION = process_generation();
+                const EntropySelection* selection = selections().current();
+
+                if (source_ == nullptr || generation_ != GENERATION || selection_ != selection) [[unlikely]] {
+                    discard();
+                    source_.reset();
+
+                    source_ = selection != nullptr && selection->factory
+                        ? selection->factory()
+                        : make_entropy_source(EntropyBackend::openssl);
+
+                    if (source_ == nullptr) [[unlikely]] {
+                        throw std::runtime_error("entropy factory returned no source");
+                    }
+
+                    generation_ = GENERATION;
+                    selection_ = selection;
+                }
+
+                return *source_;
+            }
+
+            /// Copies LEN buffered bytes to buf, refilling the buffer if needed.
+            ///
+            /// @param buf Destination buffer
+            /// @param LEN Number of bytes to copy (at most MAX_POOLED_REQUEST)
+            /// @throws std::runtime_error if the buffer could not be refilled
+            void take(unsigned char *buf, const size_t LEN) {
+                EntropySource& current = source();
+
+                if (RANDOM_POOL_SIZE - offset_ < LEN) [[unlikely]] {
+                    discard();
+                    current.fill(bytes_);
+                    offset_ = 0;
+                }
+
+                unsigned char *source = bytes_.data() + offset_;
+                std::memcpy(buf, source, LEN);
+                OPENSSL_cleanse(source, LEN);
+                offset_ += LEN;
+            }
+
+        private:
+            void discard() noexcept {
+                OPENSSL_cleanse(bytes_.data() + offset_, RANDOM_POOL_SIZE - offset_);
+                offset_ = RANDOM_POOL_SIZE;
+            }
+        };
+
+        /// Returns the calling thread's entropy state.
+        ThreadEntropy& thread_entropy() {
+            thread_local ThreadEntropy INSTANCE;
+
+            return INSTANCE;
+        }
+
         /// Generates a random hostname fallback as a hexadecimal string.
         ///
         /// Used when system hostname retrieval fails. Generates 8 random bytes
@@ -59,35 +257,142 @@ namespace visus::cuid2::platform {
             return result;
         }
         // GCOVR_EXCL_STOP
+
+        /// Returns the key portion of a "KEY=VALUE" environment entry.
+        ///
+        /// @param ENTRY Environment entry containing at least one '='
+        /// @return View of the characters before the first '='
+        std::string_view entry_key(const std::string_view ENTRY) noexcept {
+            return ENTRY.substr(0, ENTRY.find('='));
+        }
+
+        /// Sorts "KEY=VALUE" entries by key and appends them to a byte buffer.
+        ///
+        /// The sort is stable and only the first entry of each key is kept,
+        /// mirroring std::map::try_emplace() so the result matches
+        /// get_environment_variables() byte for byte.
+        ///
+        /// @param entries Environment entries, each containing at least one '='
+        /// @param out Buffer to append the serialized entries to
+        void append_sorted_entries(std::vector<std::string_view>& entries, std::vector<uint8_t>& out) {
+            std::ranges::stable_sort(entries, std::less<>(), entry_key);
+
+            const auto [FIRST, LAST] = std::ranges::unique(entries, std::equal_to<>(), entry_key);
+            entries.erase(FIRST, LAST);
+
+            size_t total_size = 0;
+            for (const auto ENTRY : entries) {
+                total_size += ENTRY.size();
+            }
+
+            out.reserve(out.size() + total_size);
+
+            for (const auto ENTRY : entries) {
+                out.insert(out.end(), ENTRY.begin(), ENTRY.end());
+            }
+        }
     } // anonymous namespace
 
+    /// Selects a built-in source for all threads.
+    ///
+    /// @param BACKEND Source to use from now on
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    void set_entropy_source(const EntropyBackend BACKEND) {
+        if (BACKEND == EntropyBackend::openssl) {
+            selections().publish({});
+            return;
+        }
+
+        selections().publish([BACKEND] { return make_entropy_source(BACKEND); });
+    }
+
+    /// Selects a custom source for all threads.
+    ///
+    /// @param factory Function creating one source, or empty for the default
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    void set_entropy_source(EntropyFactory factory) {
+        selections().publish(std::move(factory));
+    }
+
+    /// Returns the name of the source the calling thread draws from.
+    ///
+    /// @return Name reported by the thread's EntropySource
+    /// @throws std::runtime_error if the source cannot be created
+    std::string entropy_source_name() {
+        return std::string(thread_entropy().source().name());
+    }
+
     /// Fills a buffer with cryptographically secure random bytes.
     ///
-    /// Uses OpenSSL's RAND_bytes() which provides a CSPRNG suitable for
-    /// cryptographic operations. OpenSSL 3.x automatically initializes
-    /// the random number generator on first use.
+    /// Small requests are served from a per-thread buffer of
+    /// CUID2_RANDOM_POOL_SIZE bytes that is refilled with a single request to
+    /// the thread's EntropySource, so the common case is a memcpy without
+    /// taking the OpenSSL DRBG lock or running a cipher. Served bytes are
+    /// wiped from the buffer immediately, and buffers are discarded in the
+    /// child after fork(), by start_new_generation() and when another source
+    /// is selected. Requests larger than a quarter of the buffer, or any
+    /// request when the buffer size is 0, go directly to the source.
     ///
     /// @param buf Pointer to buffer to fill with random bytes
     /// @param LEN Number of random bytes to generate
+    /// @throws std::runtime_error if the entropy source fails
     /// @note Thread-safe: Can be called concurrently from multiple threads
-    /// @note No explicit initialization required (OpenSSL 3.x auto-initializes)
-    void get_random_bytes(unsigned char *buf, const size_t LEN) noexcept {
-        RAND_bytes(buf, static_cast<int>(LEN));
+    void get_random_bytes(unsigned char *buf, const size_t LEN) {
+        ThreadEntropy& entropy = thread_entropy();
+
+        if constexpr (RANDOM_POOL_SIZE > 0) {
+            if (LEN <= MAX_POOLED_REQUEST) [[likely]] {
+                entropy.take(buf, LEN);
+                return;
+            }
+        }
+
+        entropy.source().fill(std::span<uint8_t>(buf, LEN));
+    }
+
+    /// Returns the size of the per-thread random buffer in bytes.
+    ///
+    /// @return CUID2_RANDOM_POOL_SIZE, or 0 if every request goes to the source
+    size_t random_pool_size() noexcept {
+        return RANDOM_POOL_SIZE;
+    }
+
+    /// Returns the current process generation.
+    ///
+    /// The first call registers the fork handler, so a process that never
+    /// queries the generation pays nothing for it.
+    ///
+    /// @return Number of fork() calls and start_new_generation() calls that
+    ///         this process has gone through
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    uint64_t process_generation() noexcept {
+        register_fork_handler();
+
+        return generation.load(std::memory_order_acquire);
+    }
+
+    /// Starts a new process generation in the calling process.
+    ///
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    void start_new_generation() noexcept {
+        register_fork_handler();
+        generation.fetch_add(1, std::memory_order_acq_rel);
     }
 
     /// Generates a cryptographically secure random 64-bit integer.
     ///
     /// Convenience wrapper around get_random_bytes() for generating random
-    /// int64_t values using OpenSSL's CSPRNG. Uses std::bit_cast for
+    /// int64_t values from the selected entropy source. Uses std::bit_cast for
     /// type-safe conversion from bytes to int64_t.
     ///
     /// @return A cryptographically random int64_t value
+    /// @throws std::runtime_error if the entropy source fails
     /// @note Thread-safe: Can be called concurrently from multiple threads
-    int64_t get_random_int64() noexcept {
+    int64_t get_random_int64() {
         constexpr int BYTES_SIZE = sizeof(int64_t);
 
         std::array<unsigned char, BYTES_SIZE> bytes{};
-        RAND_bytes(bytes.data(), BYTES_SIZE);
+        get_random_bytes(bytes.data(), BYTES_SIZE);
 
         return std::bit_cast<int64_t>(bytes);
     }
@@ -108,6 +413,41 @@ namespace visus::cuid2::platform {
 #endif
     }
 
+    /// Returns the NUMA node of the CPU the calling thread is running on.
+    ///
+    /// Platform-specific implementation:
+    /// - Linux: Uses the getcpu system call directly, since the getcpu() libc
+    ///   wrapper needs glibc 2.29 and RHEL 8 ships 2.28; callers cache the
+    ///   result, so the system call is rare
+    /// - Windows: Uses GetNumaProcessorNodeEx() on GetCurrentProcessorNumberEx()
+    /// - Others: Always 0
+    ///
+    /// @return NUMA node number, or 0 if it cannot be determined
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    unsigned get_numa_node() noexcept {
+#if defined(_WIN32)
+        PROCESSOR_NUMBER processor{};
+        GetCurrentProcessorNumberEx(&processor);
+
+        USHORT node = 0;
+        if (GetNumaProcessorNodeEx(&processor, &node) == 0 || node == MAXUSHORT) { // GCOVR_EXCL_LINE
+            return 0;                                                            // GCOVR_EXCL_LINE
+        }
+
+        return node;
+#elif defined(__linux__)
+        unsigned cpu = 0;
+        unsigned node = 0;
+        if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) [[unlikely]] {
+            return 0; // GCOVR_EXCL_LINE
+        }
+
+        return node;
+#else
+        return 0;
+#endif
+    }
+
 #ifdef _WIN32
     // ============================================================================
     // Windows Implementation (MSVC/MinGW)
@@ -134,6 +474,23 @@ namespace visus::cuid2::platform {
         return generate_random_hostname();
     }
 
+    /// Reads a single environment variable (Windows).
+    ///
+    /// Uses _wgetenv() so that values outside the active code page survive,
+    /// converting the name to UTF-16 and the value back to UTF-8.
+    ///
+    /// @param NAME Variable name
+    /// @return The value (UTF-8 encoded), or std::nullopt if it is not set
+    std::optional<std::string> get_environment_variable(const char* NAME) {
+        const wchar_t* value = _wgetenv(boost::nowide::widen(NAME).c_str());
+
+        if (value == nullptr) {
+            return std::nullopt;
+        }
+
+        return boost::nowide::narrow(value);
+    }
+
     /// Retrieves all environment variables as key-value pairs (Windows).
     ///
     /// Uses GetEnvironmentStringsW() to retrieve the environment block as
@@ -184,6 +541,43 @@ namespace visus::cuid2::platform {
         return env_vars;
     }
 
+    /// Appends all environment variables to a byte buffer (Windows).
+    ///
+    /// Each UTF-16 entry of the GetEnvironmentStringsW() block is converted to
+    /// UTF-8 once, after which entries are sorted and appended exactly as on
+    /// POSIX.
+    ///
+    /// @param out Buffer to append the serialized environment to
+    void append_environment(std::vector<uint8_t>& out) {
+        /// RAII deleter for Windows environment strings block.
+        struct EnvStringsDeleter {
+            void operator()(LPWCH ptr) const noexcept {
+                if (ptr != nullptr) {
+                    FreeEnvironmentStringsW(ptr);
+                }
+            }
+        };
+
+        const std::unique_ptr<WCHAR, EnvStringsDeleter> ENV_BLOCK(GetEnvironmentStringsW());
+        if (ENV_BLOCK == nullptr) {
+            return;
+        }
+
+        std::vector<std::string> narrowed;
+        for (LPWCH env = ENV_BLOCK.get(); *env != L'\0';) {
+            const size_t LENGTH = std::wcslen(env);
+
+            if (std::wmemchr(env, L'=', LENGTH) != nullptr) [[likely]] {
+                narrowed.push_back(boost::nowide::narrow(env, LENGTH));
+            }
+
+            env += LENGTH + 1;
+        }
+
+        std::vector<std::string_view> entries(narrowed.begin(), narrowed.end());
+        append_sorted_entries(entries, out);
+    }
+
 #else
     // ============================================================================
     // POSIX Implementation (Linux/macOS/FreeBSD/OpenBSD/NetBSD)
@@ -213,6 +607,20 @@ namespace visus::cuid2::platform {
         // GCOVR_EXCL_STOP
     }
 
+    /// Reads a single environment variable (POSIX).
+    ///
+    /// @param NAME Variable name
+    /// @return The value, or std::nullopt if it is not set
+    std::optional<std::string> get_environment_variable(const char* NAME) {
+        const char* value = std::getenv(NAME); // NOLINT(concurrency-mt-unsafe) - read-only, as in environ scans
+
+        if (value == nullptr) {
+            return std::nullopt;
+        }
+
+        return std::string(value);
+    }
+
     /// Retrieves all environment variables as key-value pairs (POSIX).
     ///
     /// Iterates over the global `environ` variable to extract all environment
@@ -238,6 +646,24 @@ namespace visus::cuid2::platform {
         return env_vars;
     }
 
+    /// Appends all environment variables to a byte buffer (POSIX).
+    ///
+    /// Collects views of the `environ` entries, sorts them by key and copies
+    /// them into the buffer; no entry is copied more than once.
+    ///
+    /// @param out Buffer to append the serialized environment to
+    void append_environment(std::vector<uint8_t>& out) {
+        std::vector<std::string_view> entries;
+
+        for (const char * const *env = environ; *env != nullptr; env++) {
+            if (std::strchr(*env, '=') != nullptr) [[likely]] {
+                entries.emplace_back(*env);
+            }
+        }
+
+        append_sorted_entries(entries, out);
+    }
+
 #endif
 
 } // namespace visus::cuid2::platform
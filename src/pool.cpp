@@ -0,0 +1,408 @@
+/// @file pool.cpp
+/// @brief Pre-generated CUID2 identifier pool
+///
+/// This file implements Pool: a bounded multi-producer multi-consumer ring of
+/// fixed-size identifier slots (sequence-numbered, in the style of Vyukov's
+/// bounded queue) and a refill thread that tops it up with Generator batches.
+/// The refill thread sleeps on an atomic wait rather than a condition
+/// variable, so waking it takes no lock and a child forked while it runs
+/// cannot inherit a held mutex.
+
+#include "cuid2/pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cuid2/cuid2.hpp"
+#include "cuid2/generator.hpp"
+#include "cuid2/platform.hpp"
+
+namespace visus::cuid2 {
+    namespace {
+        /// Keeps the read position, write position and wake-up flag on
+        /// separate cache lines.
+        constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+        /// Returns the current steady-clock time in nanoseconds.
+        int64_t steady_now() noexcept {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        /// Validates options and fills in the defaulted watermarks.
+        ///
+        /// @param options Options as given to the constructor
+        /// @return Options with a power-of-two capacity and explicit watermarks
+        /// @throws std::invalid_argument if any option is out of range
+        PoolOptions resolve(PoolOptions options) {
+            if (options.length < MIN_CUID2_LENGTH || options.length > MAX_CUID2_LENGTH) [[unlikely]] {
+                throw std::invalid_argument("length must be between 4 and 32");
+            }
+
+            if (options.capacity == 0 || options.capacity > std::size_t{1} << 30) [[unlikely]] {
+                throw std::invalid_argument("capacity must be between 1 and 2^30");
+            }
+
+            if (options.refill_batch == 0) [[unlikely]] {
+                throw std::invalid_argument("refill_batch must be at least 1");
+            }
+
+            options.capacity = std::bit_ceil(options.capacity);
+
+            if (options.low_watermark == 0) {
+                options.low_watermark = options.capacity / 4;
+            }
+
+            if (options.high_watermark == 0) {
+                options.high_watermark = options.capacity;
+            }
+
+            if (options.low_watermark >= options.high_watermark || options.high_watermark > options.capacity)
+                [[unlikely]] {
+                throw std::invalid_argument("watermarks must satisfy low < high <= capacity");
+            }
+
+            return options;
+        }
+    } // anonymous namespace
+
+    /// Ring, counters and refill thread of a Pool.
+    struct Pool::State {
+        /// One pre-generated identifier.
+        ///
+        /// sequence equals the slot's ring position when the slot is free for
+        /// the producer, position + 1 once it holds an identifier, and
+        /// position + capacity after a consumer has emptied it.
+        struct Slot {
+            std::atomic<std::size_t> sequence{0};
+
+            /// Process generation the identifier was generated in.
+            uint64_t generation = 0;
+
+            std::array<char, MAX_CUID2_LENGTH> chars{};
+        };
+
+        const std::size_t length;
+        const std::size_t capacity;
+        const std::size_t mask;
+        const std::size_t low_watermark;
+        const std::size_t high_watermark;
+
+        /// Process that owns the refill thread; a forked child has none.
+        const int owner_pid = platform::get_process_id();
+
+        std::unique_ptr<Slot[]> slots;
+
+        /// Next position to read; also the number of identifiers taken.
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head{0};
+
+        /// Next position to write; only the producer advances it.
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail{0};
+
+        /// Set by the consumer that wakes the refill thread.
+        alignas(CACHE_LINE_SIZE) std::atomic<bool> refill_requested{false};
+        std::atomic<bool> stopping{false};
+        std::atomic<int64_t> requested_at{0};
+
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> discarded{0};
+        std::atomic<uint64_t> refills{0};
+        std::atomic<int64_t> last_lag{0};
+        std::atomic<int64_t> max_lag{0};
+        std::atomic<int64_t> total_lag{0};
+
+        /// Only used by the producer: the constructor, then the refill thread.
+        Generator generator;
+        std::vector<std::string> batch;
+
+        std::thread thread;
+
+        explicit State(const PoolOptions& OPTIONS)
+            : length(static_cast<std::size_t>(OPTIONS.length)),
+              capacity(OPTIONS.capacity),
+              mask(OPTIONS.capacity - 1),
+              low_watermark(OPTIONS.low_watermark),
+              high_watermark(OPTIONS.high_watermark),
+              slots(std::make_unique<Slot[]>(OPTIONS.capacity)),
+              generator(GeneratorOptions{.length = OPTIONS.length, .shared_counter = true}),
+              batch(std::min(OPTIONS.refill_batch, OPTIONS.high_watermark)) {
+            for (std::size_t idx = 0; idx < capacity; ++idx) {
+                slots[idx].sequence.store(idx, std::memory_order_relaxed);
+            }
+        }
+
+        /// Returns the number of identifiers ready, possibly including some
+        /// that are being taken concurrently.
+        [[nodiscard]] std::size_t available() const noexcept {
+            // A consumer can advance head past a slot whose push() has
+            // published its sequence but not yet stored tail, so head may be
+            // seen ahead of tail; report that as empty rather than wrapping
+            const std::size_t HEAD = head.load(std::memory_order_acquire);
+            const std::size_t TAIL = tail.load(std::memory_order_acquire);
+
+            return TAIL >= HEAD ? TAIL - HEAD : 0;
+        }
+
+        /// Appends an identifier; producer only.
+        ///
+        /// @return false if the next slot is still held by a consumer
+        bool push(const std::string& ID, const uint64_t GENERATION) noexcept {
+            const std::size_t POSITION = tail.load(std::memory_order_relaxed);
+            Slot& slot = slots[POSITION & mask];
+
+            if (slot.sequence.load(std::memory_order_acquire) != POSITION) [[unlikely]] {
+                return false;
+            }
+
+            slot.generation = GENERATION;
+            std::memcpy(slot.chars.data(), ID.data(), length);
+            slot.sequence.store(POSITION + 1, std::memory_order_release);
+            tail.store(POSITION + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /// Takes the oldest identifier of the current generation.
+        ///
+        /// Identifiers of an older generation are consumed and dropped.
+        ///
+        /// @param out Receives length characters
+        /// @param GENERATION Current process generation
+        /// @return false if the ring is empty
+        bool pop(char* out, const uint64_t GENERATION) noexcept {
+            std::size_t position = head.load(std::memory_order_relaxed);
+
+            for (;;) {
+                Slot& slot = slots[position & mask];
+                const std::size_t SEQUENCE = slot.sequence.load(std::memory_order_acquire);
+                const auto DIFFERENCE = static_cast<std::ptrdiff_t>(SEQUENCE - (position + 1));
+
+                if (DIFFERENCE < 0) {
+                    return false;
+                }
+
+                if (DIFFERENCE > 0) {
+                    // Another consumer took this position first
+                    position = head.load(std::memory_order_relaxed);
+                    continue;
+                }
+
+                if (!head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    continue;
+                }
+
+                const bool CURRENT = slot.generation == GENERATION;
+                if (CURRENT) [[likely]] {
+                    std::memcpy(out, slot.chars.data(), length);
+                }
+                slot.sequence.store(position + capacity, std::memory_order_release);
+
+                if (CURRENT) [[likely]] {
+                    return true;
+                }
+
+                discarded.fetch_add(1, std::memory_order_relaxed);
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+
+        /// Generates batches until the high watermark is reached or the ring
+        /// has no free slot; producer only.
+        void fill() {
+            // Read first: identifiers generated across a fork() are stale
+            const uint64_t GENERATION = platform::process_generation();
+
+            for (std::size_t ready = available(); ready < high_watermark; ready = available()) {
+                const std::span<std::string> OUT(batch.data(), std::min(batch.size(), high_watermark - ready));
+                generator.next_batch(OUT);
+
+                for (const auto& ID : OUT) {
+                    if (!push(ID, GENERATION)) [[unlikely]] {
+                        return;
+                    }
+                }
+            }
+        }
+
+        /// Wakes the refill thread if the ring is at or below the low
+        /// watermark and nobody has done so yet.
+        void request_refill() noexcept {
+            if (available() > low_watermark) [[likely]] {
+                return;
+            }
+
+            // Without a refill thread in a forked child there is nobody to wake
+            if (refill_requested.load(std::memory_order_relaxed) || owner_pid != platform::get_process_id()) {
+                return;
+            }
+
+            const int64_t NOW = steady_now();
+            if (!refill_requested.exchange(true, std::memory_order_acq_rel)) {
+                requested_at.store(NOW, std::memory_order_relaxed);
+                refill_requested.notify_one();
+            }
+        }
+
+        /// Refill thread body.
+        void run() noexcept {
+            for (;;) {
+                refill_requested.wait(false, std::memory_order_acquire);
+
+                if (stopping.load(std::memory_order_acquire)) {
+                    return;
+                }
+
+                refill_requested.store(false, std::memory_order_release);
+                const int64_t REQUESTED_AT = requested_at.load(std::memory_order_relaxed);
+
+                try {
+                    fill();
+                } catch (const std::exception&) {
+                    // GCOVR_EXCL_START - entropy source failure; acquire()
+                    // falls back to generate(), which reports the error
+                    continue;
+                    // GCOVR_EXCL_STOP
+                }
+
+                const int64_t LAG = std::max<int64_t>(0, steady_now() - REQUESTED_AT);
+                last_lag.store(LAG, std::memory_order_relaxed);
+                total_lag.fetch_add(LAG, std::memory_order_relaxed);
+                refills.fetch_add(1, std::memory_order_relaxed);
+
+                int64_t longest = max_lag.load(std::memory_order_relaxed);
+                while (LAG > longest && !max_lag.compare_exchange_weak(longest, LAG, std::memory_order_relaxed)) {
+                }
+            }
+        }
+
+        /// Takes an identifier from the ring or generates one inline.
+        ///
+        /// @param out Receives length characters
+        void take(char* out) {
+            if (pop(out, platform::process_generation())) [[likely]] {
+                request_refill();
+                return;
+            }
+
+            misses.fetch_add(1, std::memory_order_relaxed);
+            request_refill();
+            static_cast<void>(generate_into(out, length));
+        }
+    };
+
+    /// Creates a pool, fills it and starts its refill thread.
+    ///
+    /// @param options Length, capacity, watermarks and batch size
+    /// @throws std::invalid_argument if any option is out of range
+    /// @throws std::system_error if the refill thread cannot be started
+    Pool::Pool(const PoolOptions options) : state_(std::make_unique<State>(resolve(options))) {
+        state_->fill();
+        state_->thread = std::thread([state = state_.get()] { state->run(); });
+    }
+
+    /// Stops and joins the refill thread.
+    ///
+    /// A pool destroyed in a forked child has no refill thread to join; its
+    /// std::thread handle is intentionally leaked, since neither joining nor
+    /// detaching a thread of the parent is valid.
+    Pool::~Pool() {
+        if (state_->owner_pid != platform::get_process_id()) [[unlikely]] {
+            // GCOVR_EXCL_START - only reached in forked children
+            static_cast<void>(new std::thread(std::move(state_->thread)));
+            return;
+            // GCOVR_EXCL_STOP
+        }
+
+        state_->stopping.store(true, std::memory_order_release);
+        state_->refill_requested.store(true, std::memory_order_release);
+        state_->refill_requested.notify_one();
+        state_->thread.join();
+    }
+
+    /// Takes an identifier, generating one inline if the ring is empty.
+    ///
+    /// @return A CUID2 identifier of the configured length
+    std::string Pool::acquire() {
+        std::string result(state_->length, '\0');
+        state_->take(result.data());
+
+        return result;
+    }
+
+    /// Takes an identifier into a caller-provided buffer.
+    ///
+    /// @param out Destination buffer; must hold at least length() characters
+    /// @return Number of characters written (always length())
+    /// @throws std::invalid_argument if out is shorter than length()
+    std::size_t Pool::acquire_into(const std::span<char> out) {
+        if (out.size() < state_->length) [[unlikely]] {
+            throw std::invalid_argument("buffer is shorter than the pool's identifier length");
+        }
+
+        state_->take(out.data());
+
+        return state_->length;
+    }
+
+    /// Takes an identifier only if one is ready.
+    ///
+    /// @param out Destination buffer; must hold at least length() characters
+    /// @return true if length() characters were written
+    /// @throws std::invalid_argument if out is shorter than length()
+    bool Pool::try_acquire_into(const std::span<char> out) {
+        if (out.size() < state_->length) [[unlikely]] {
+            throw std::invalid_argument("buffer is shorter than the pool's identifier length");
+        }
+
+        const bool TAKEN = state_->pop(out.data(), platform::process_generation());
+        state_->request_refill();
+
+        return TAKEN;
+    }
+
+    /// Returns the configured identifier length.
+    ///
+    /// @return Length of every identifier served
+    int Pool::length() const noexcept {
+        return static_cast<int>(state_->length);
+    }
+
+    /// Returns the ring capacity after rounding.
+    ///
+    /// @return Maximum number of identifiers held
+    std::size_t Pool::capacity() const noexcept {
+        return state_->capacity;
+    }
+
+    /// Returns the pool counters.
+    ///
+    /// @return Snapshot of the hit, miss and refill counters
+    PoolStats Pool::stats() const noexcept {
+        const State& STATE = *state_;
+        PoolStats result;
+
+        result.discarded = STATE.discarded.load(std::memory_order_relaxed);
+        result.hits = STATE.head.load(std::memory_order_relaxed) - result.discarded;
+        result.misses = STATE.misses.load(std::memory_order_relaxed);
+        result.refills = STATE.refills.load(std::memory_order_relaxed);
+        result.available = STATE.available();
+        result.last_refill_lag = std::chrono::nanoseconds(STATE.last_lag.load(std::memory_order_relaxed));
+        result.max_refill_lag = std::chrono::nanoseconds(STATE.max_lag.load(std::memory_order_relaxed));
+        result.total_refill_lag = std::chrono::nanoseconds(STATE.total_lag.load(std::memory_order_relaxed));
+
+        return result;
+    }
+} // namespace visus::cuid2
@@ -0,0 +1,260 @@
+/// @file stats.cpp
+/// @brief Per-stage timing counters for the generation pipeline
+///
+/// Each thread records into its own set of relaxed atomics, written only by
+/// that thread, and registers them in a process-wide list so snapshots can sum
+/// them without pausing generation. Counters of exiting threads are folded
+/// into a retired total. reset_stats() stores a baseline that later snapshots
+/// subtract, so it never writes to another thread's counters.
+
+#include "cuid2/stats.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#include "instrumentation.hpp"
+
+#ifdef CUID2_ENABLE_INSTRUMENTATION
+    #include <algorithm>
+    #include <atomic>
+    #include <memory>
+    #include <mutex>
+    #include <vector>
+
+    #if defined(__x86_64__) || defined(_M_X64)
+        #ifdef _MSC_VER
+            #include <intrin.h>
+        #else
+            #include <x86intrin.h>
+        #endif
+    #elif defined(_M_ARM64)
+        #include <intrin.h>
+    #elif !defined(__aarch64__)
+        #include <chrono>
+    #endif
+#endif
+
+namespace visus::cuid2 {
+#ifdef CUID2_ENABLE_INSTRUMENTATION
+    namespace {
+        struct ThreadCounters;
+
+        /// Process-wide list of live thread counters and the shared settings.
+        struct Registry {
+            /// Guards every member except interval.
+            std::mutex mutex;
+
+            /// Counters of threads that have recorded at least once and are still running.
+            std::vector<ThreadCounters*> threads;
+
+            /// Totals of threads that have exited.
+            Stats retired;
+
+            /// Totals at the last reset_stats(), subtracted from snapshots.
+            Stats baseline;
+
+            /// Installed callback, copied out before it is invoked.
+            std::shared_ptr<const StatsCallback> callback;
+
+            /// Identifiers per thread between callbacks; 0 when no callback is set.
+            std::atomic<uint64_t> interval{0};
+        };
+
+        /// Returns the registry, which is intentionally never destroyed so
+        /// threads exiting during shutdown can still retire their counters.
+        Registry& registry() {
+            static auto* const INSTANCE = new Registry();
+
+            return *INSTANCE;
+        }
+
+        /// Adds DELTA to a counter written only by the owning thread.
+        ///
+        /// A load and store avoids a locked read-modify-write on the hot path;
+        /// readers on other threads still see whole values.
+        void bump(std::atomic<uint64_t>& counter, const uint64_t DELTA) noexcept {
+            counter.store(counter.load(std::memory_order_relaxed) + DELTA, std::memory_order_relaxed);
+        }
+
+        /// Counters owned by one thread.
+        struct ThreadCounters {
+            std::array<std::atomic<uint64_t>, STAGE_COUNT> calls{};
+            std::array<std::atomic<uint64_t>, STAGE_COUNT> cycles{};
+            std::atomic<uint64_t> identifiers{0};
+
+            /// Identifiers since this thread last ran the callback.
+            uint64_t since_callback = 0;
+
+            ThreadCounters() {
+                auto& reg = registry();
+                const std::scoped_lock LOCK(reg.mutex);
+                reg.threads.push_back(this);
+            }
+
+            ~ThreadCounters() {
+                auto& reg = registry();
+                const std::scoped_lock LOCK(reg.mutex);
+                add_to(reg.retired);
+                std::erase(reg.threads, this);
+            }
+
+            ThreadCounters(const ThreadCounters&) = delete;
+            ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+            /// Adds these counters to a snapshot.
+            void add_to(Stats& out) const noexcept {
+                for (size_t idx = 0; idx < STAGE_COUNT; ++idx) {
+                    out.stages[idx].calls += calls[idx].load(std::memory_order_relaxed);
+                    out.stages[idx].cycles += cycles[idx].load(std::memory_order_relaxed);
+                }
+                out.identifiers += identifiers.load(std::memory_order_relaxed);
+            }
+        };
+
+        /// Returns the calling thread's counters, registering them on first use.
+        ThreadCounters& local_counters() {
+            thread_local ThreadCounters counters;
+
+            return counters;
+        }
+
+        /// Sums retired and live counters; the registry lock must be held.
+        Stats collect_locked(const Registry& reg) noexcept {
+            Stats result = reg.retired;
+
+            for (const ThreadCounters* counters : reg.threads) {
+                counters->add_to(result);
+            }
+
+            return result;
+        }
+    } // anonymous namespace
+
+    namespace instrumentation {
+        /// Reads the cheapest monotonic cycle source on this platform.
+        ///
+        /// @return Raw counter value; only differences are meaningful
+        uint64_t read_cycles() noexcept {
+    #if defined(__x86_64__) || defined(_M_X64)
+            return __rdtsc();
+    #elif defined(_M_ARM64)
+            return static_cast<uint64_t>(_ReadStatusReg(ARM64_CNTVCT));
+    #elif defined(__aarch64__)
+            uint64_t value = 0;
+            asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+            return value;
+    #else
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    #endif
+        }
+
+        /// Adds one call of STAGE lasting CYCLES to the calling thread's counters.
+        void record_stage(const Stage STAGE, const uint64_t CYCLES) noexcept {
+            auto& counters = local_counters();
+            const auto INDEX = static_cast<size_t>(STAGE);
+
+            bump(counters.calls[INDEX], 1);
+            bump(counters.cycles[INDEX], CYCLES);
+        }
+
+        /// Adds COUNT identifiers to the calling thread's counters and runs the
+        /// stats callback when its interval has elapsed.
+        void record_identifiers(const uint64_t COUNT) {
+            auto& counters = local_counters();
+            bump(counters.identifiers, COUNT);
+
+            auto& reg = registry();
+            const uint64_t INTERVAL = reg.interval.load(std::memory_order_relaxed);
+            if (INTERVAL == 0) [[likely]] {
+                return;
+            }
+
+            counters.since_callback += COUNT;
+            if (counters.since_callback < INTERVAL) [[likely]] {
+                return;
+            }
+            counters.since_callback = 0;
+
+            std::shared_ptr<const StatsCallback> callback;
+            {
+                const std::scoped_lock LOCK(reg.mutex);
+                callback = reg.callback;
+            }
+
+            if (callback) {
+                (*callback)(stats());
+            }
+        }
+    } // namespace instrumentation
+#endif
+
+    /// Reports whether the library was built with ENABLE_INSTRUMENTATION.
+    ///
+    /// @return true if stage counters are being recorded
+    bool instrumentation_enabled() noexcept {
+        return instrumentation::ENABLED;
+    }
+
+    /// Returns the counters accumulated since start-up or the last reset_stats().
+    ///
+    /// @return Snapshot summed over all threads; all zeros when disabled
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    Stats stats() {
+#ifdef CUID2_ENABLE_INSTRUMENTATION
+        auto& reg = registry();
+        const std::scoped_lock LOCK(reg.mutex);
+
+        Stats result = collect_locked(reg);
+
+        // Counters only grow, so the baseline never exceeds the current totals
+        for (size_t idx = 0; idx < STAGE_COUNT; ++idx) {
+            result.stages[idx].calls -= reg.baseline.stages[idx].calls;
+            result.stages[idx].cycles -= reg.baseline.stages[idx].cycles;
+        }
+        result.identifiers -= reg.baseline.identifiers;
+
+        return result;
+#else
+        return {};
+#endif
+    }
+
+    /// Starts a new measurement window; later snapshots count from this point.
+    ///
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    void reset_stats() {
+#ifdef CUID2_ENABLE_INSTRUMENTATION
+        auto& reg = registry();
+        const std::scoped_lock LOCK(reg.mutex);
+
+        reg.baseline = collect_locked(reg);
+#endif
+    }
+
+    /// Installs a callback invoked with a fresh snapshot every INTERVAL
+    /// identifiers generated by each thread.
+    ///
+    /// @param callback Function to call, or empty to remove
+    /// @param INTERVAL Identifiers per thread between calls (at least 1)
+    /// @throws std::invalid_argument if INTERVAL is 0 and callback is set
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    void set_stats_callback(StatsCallback callback, const uint64_t INTERVAL) {
+        if (callback && INTERVAL == 0) [[unlikely]] {
+            throw std::invalid_argument("INTERVAL must be at least 1");
+        }
+
+#ifdef CUID2_ENABLE_INSTRUMENTATION
+        auto& reg = registry();
+        const std::scoped_lock LOCK(reg.mutex);
+
+        if (callback) {
+            reg.callback = std::make_shared<const StatsCallback>(std::move(callback));
+            reg.interval.store(INTERVAL, std::memory_order_relaxed);
+        } else {
+            reg.callback.reset();
+            reg.interval.store(0, std::memory_order_relaxed);
+        }
+#endif
+    }
+} // namespace visus::cuid2
@@ -2,8 +2,10 @@
 /// @brief Utility functions for CUID2 generation
 ///
 /// This file provides helper functions for CUID2 identifier generation including:
-/// - Base-36 encoding using Boost.Multiprecision for arbitrary precision
-/// - Timestamp generation in 100-nanosecond ticks
+/// - Base-36 encoding using Boost.Multiprecision for arbitrary precision, with a
+///   fixed-width 512-bit kernel for SHA3-512 digests
+/// - Timestamp generation in 100-nanosecond ticks, from the precise or the
+///   coarse system clock
 /// - Random prefix character generation (a-z)
 
 #include "cuid2/utils.hpp"
@@ -13,47 +15,233 @@
 #include <ranges>
 #include <stdexcept>
 #include <string_view>
+#include <vector>
 
 #include <boost/multiprecision/cpp_int.hpp>
 
+#if defined(_MSC_VER) && defined(_M_X64)
+    #include <intrin.h>
+#endif
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h> // NOSONAR(S3806) - Microsoft uses lowercase windows.h
+#else
+    #include <time.h>
+#endif
+
+#if defined(CLOCK_REALTIME_COARSE)
+    #define CUID2_COARSE_CLOCK CLOCK_REALTIME_COARSE
+#elif defined(CLOCK_REALTIME_FAST)
+    #define CUID2_COARSE_CLOCK CLOCK_REALTIME_FAST
+#endif
+
 #include "cuid2/platform.hpp"
 
 namespace visus::cuid2::utils {
     using boost::multiprecision::cpp_int;
 
     namespace {
-        /// Number of lowercase letters in the English alphabet (a-z).
-        constexpr uint8_t LOWERCASE_LETTER_COUNT = 26;
-
         /// Base-36 radix for encoding (0-9, a-z).
         constexpr int BASE36_RADIX = 36;
 
         /// Number of bits in a byte, used for bit-shifting operations.
         constexpr uint8_t BITS_PER_BYTE = 8;
 
+        /// Number of base-36 digits emitted per limb division (36^12 < 2^63).
+        constexpr size_t BASE36_CHUNK_DIGITS = 12;
+
+        /// Divisor used per pass of the fixed-width kernel (36^12).
+        constexpr uint64_t BASE36_CHUNK_DIVISOR = 4'738'381'338'321'616'896ULL;
+
+        /// Number of 64-bit limbs in a SHA3-512 digest.
+        constexpr size_t DIGEST_LIMBS = DIGEST_SIZE / sizeof(uint64_t);
+
+        /// Maximum number of base-36 digits of a 512-bit value (ceil(512 / log2(36))).
+        constexpr size_t DIGEST_BASE36_DIGITS = 100;
+
+        /// Maximum number of 36^12 chunks of a 512-bit value (ceil(100 / 12)).
+        constexpr size_t DIGEST_BASE36_CHUNKS = 9;
+
+        /// Returns 36^EXPONENT for the exponents used within a single chunk.
+        ///
+        /// @param EXPONENT Power of 36 to compute, at most BASE36_CHUNK_DIGITS
+        /// @return 36 raised to EXPONENT
+        constexpr uint64_t base36_power(const size_t EXPONENT) noexcept {
+            uint64_t result = 1;
+            for (size_t idx = 0; idx < EXPONENT; ++idx) {
+                result *= 36U;
+            }
+
+            return result;
+        }
+
+        static_assert(base36_power(BASE36_CHUNK_DIGITS) == BASE36_CHUNK_DIVISOR);
+
         /// Number of 100-nanosecond ticks per second.
         /// Used for high-resolution timestamp generation with cross-platform compatibility.
         constexpr int64_t TICKS_PER_SECOND = 10'000'000;
 
-        /// Returns the base-36 character set as a compile-time constant.
+        /// Divides the 128-bit value (HIGH:LOW) by a 64-bit divisor.
         ///
-        /// The character set consists of digits 0-9 followed by lowercase letters a-z,
-        /// providing 36 unique characters for base-36 encoding.
+        /// Uses the native 128-bit integer type or compiler intrinsic where one is
+        /// available, and falls back to binary long division elsewhere.
         ///
-        /// @return A string_view containing "0123456789abcdefghijklmnopqrstuvwxyz"
-        consteval std::string_view get_base36_chars() noexcept {
-            return "0123456789abcdefghijklmnopqrstuvwxyz";
+        /// @param HIGH Upper 64 bits of the dividend, must be less than DIVISOR
+        /// @param LOW Lower 64 bits of the dividend
+        /// @param DIVISOR Divisor, must be less than 2^63 for the portable fallback
+        /// @param remainder Receives the remainder of the division
+        /// @return The 64-bit quotient
+        uint64_t divide_128_by_64(const uint64_t HIGH, const uint64_t LOW, const uint64_t DIVISOR, uint64_t& remainder) noexcept {
+#if defined(__SIZEOF_INT128__)
+            __extension__ using uint128_t = unsigned __int128;
+
+            const uint128_t DIVIDEND = (static_cast<uint128_t>(HIGH) << 64U) | LOW;
+
+            remainder = static_cast<uint64_t>(DIVIDEND % DIVISOR);
+            return static_cast<uint64_t>(DIVIDEND / DIVISOR);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            return _udiv128(HIGH, LOW, DIVISOR, &remainder);
+#else
+            uint64_t quotient = 0;
+            uint64_t partial = HIGH;
+
+            for (int bit = 63; bit >= 0; --bit) {
+                partial = (partial << 1U) | ((LOW >> bit) & 1U);
+                quotient <<= 1U;
+
+                if (partial >= DIVISOR) {
+                    partial -= DIVISOR;
+                    quotient |= 1U;
+                }
+            }
+
+            remainder = partial;
+            return quotient;
+#endif
         }
 
-        /// Converts a random byte to a lowercase letter (a-z).
+        /// Divides a big-endian multi-limb integer in place by a 64-bit divisor.
         ///
-        /// Maps a random byte value to one of 26 lowercase letters using modulo
-        /// arithmetic. This ensures uniform distribution across the alphabet.
+        /// @param limbs Limbs ordered from most to least significant
+        /// @param DIVISOR Divisor applied to the whole value
+        /// @return Remainder of the division
+        uint64_t divide_limbs(const std::span<uint64_t> limbs, const uint64_t DIVISOR) noexcept {
+            uint64_t remainder = 0;
+
+            for (auto& limb : limbs) {
+                limb = divide_128_by_64(remainder, limb, DIVISOR, remainder);
+            }
+
+            return remainder;
+        }
+
+        /// Returns a safe upper bound on the number of 36^12 chunks of a limb array.
+        ///
+        /// Each chunk carries 12 * log2(36) (about 62.04) bits, so one extra chunk
+        /// per sixteen limbs plus one more always suffices.
+        ///
+        /// @param LIMB_COUNT Number of 64-bit limbs
+        /// @return Upper bound on the number of chunks produced by the conversion
+        constexpr size_t max_base36_chunks(const size_t LIMB_COUNT) noexcept {
+            return LIMB_COUNT + (LIMB_COUNT / 16) + 1;
+        }
+
+        static_assert(max_base36_chunks(DIGEST_LIMBS) <= DIGEST_BASE36_CHUNKS);
+
+        /// Loads a big-endian byte sequence into big-endian ordered 64-bit limbs.
         ///
-        /// @param random_byte A random byte value
-        /// @return A lowercase letter from 'a' to 'z'
-        constexpr char prefix_from_byte(uint8_t random_byte) noexcept {
-            return static_cast<char>('a' + (random_byte % LOWERCASE_LETTER_COUNT));
+        /// The first limb holds the leading (data.size() % 8) bytes when the input
+        /// is not a multiple of eight bytes long.
+        ///
+        /// @param data Bytes to load (interpreted as big-endian)
+        /// @param limbs Destination, must hold exactly ceil(data.size() / 8) limbs
+        void load_limbs(const std::span<const uint8_t> data, const std::span<uint64_t> limbs) noexcept {
+            size_t byte_index = 0;
+            size_t leading = data.size() % sizeof(uint64_t);
+            if (leading == 0) {
+                leading = sizeof(uint64_t);
+            }
+
+            for (size_t idx = 0; idx < limbs.size(); ++idx) {
+                const size_t LIMB_BYTES = idx == 0 ? leading : sizeof(uint64_t);
+
+                uint64_t limb = 0;
+                for (size_t byte = 0; byte < LIMB_BYTES; ++byte) {
+                    limb = (limb << BITS_PER_BYTE) | data[byte_index++];
+                }
+
+                limbs[idx] = limb;
+            }
+        }
+
+        /// Writes the first COUNT digits of a chunk that is WIDTH digits wide.
+        ///
+        /// @param chunk Chunk value in [0, 36^WIDTH)
+        /// @param WIDTH Number of digits the chunk represents (with leading zeros)
+        /// @param COUNT Number of most significant digits to write, at most WIDTH
+        /// @param out Destination for COUNT characters
+        void write_chunk_digits(uint64_t chunk, const size_t WIDTH, const size_t COUNT, char* out) noexcept {
+            chunk /= base36_power(WIDTH - COUNT);
+
+            for (size_t idx = COUNT; idx > 0; --idx) {
+                out[idx - 1] = BASE36_ALPHABET[chunk % BASE36_RADIX];
+                chunk /= BASE36_RADIX;
+            }
+        }
+
+        /// Writes the most significant base-36 digits of a multi-limb integer.
+        ///
+        /// Repeatedly divides the value by 36^12, recording each remainder as a
+        /// twelve-digit chunk, until the value is exhausted. Only the chunks that
+        /// hold the requested leading digits are then formatted, so low-order
+        /// digits that the caller discards are never converted to characters.
+        ///
+        /// @param limbs Value to encode, ordered from most to least significant (destroyed)
+        /// @param chunks Scratch space, must hold max_base36_chunks(limbs.size()) values
+        /// @param out Destination for the leading digits
+        /// @return Number of digits written: min(out.size(), total digit count)
+        size_t write_base36_prefix(std::span<uint64_t> limbs, const std::span<uint64_t> chunks, const std::span<char> out) noexcept {
+            if (out.empty()) [[unlikely]] {
+                return 0;
+            }
+
+            size_t first = 0;
+            while (first < limbs.size() && limbs[first] == 0) {
+                ++first;
+            }
+
+            if (first == limbs.size()) [[unlikely]] {
+                out[0] = '0';
+                return 1;
+            }
+
+            size_t chunk_count = 0;
+            while (first < limbs.size()) {
+                chunks[chunk_count++] = divide_limbs(limbs.subspan(first), BASE36_CHUNK_DIVISOR);
+
+                while (first < limbs.size() && limbs[first] == 0) {
+                    ++first;
+                }
+            }
+
+            size_t top_width = 0;
+            for (uint64_t top = chunks[chunk_count - 1]; top > 0; top /= BASE36_RADIX) {
+                ++top_width;
+            }
+
+            size_t written = 0;
+            for (size_t chunk = chunk_count; chunk > 0 && written < out.size(); --chunk) {
+                const size_t WIDTH = chunk == chunk_count ? top_width : BASE36_CHUNK_DIGITS;
+                const size_t COUNT = std::min(WIDTH, out.size() - written);
+
+                write_chunk_digits(chunks[chunk - 1], WIDTH, COUNT, out.data() + written);
+                written += COUNT;
+            }
+
+            return written;
         }
     }
 
@@ -65,8 +253,9 @@ namespace visus::cuid2::utils {
     /// programming languages.
     ///
     /// @return A random lowercase letter from 'a' to 'z'
+    /// @throws std::runtime_error if the entropy source fails
     /// @note Thread-safe: Can be called concurrently from multiple threads
-    char generate_prefix() noexcept {
+    char generate_prefix() {
         uint8_t random_byte = 0;
         platform::get_random_bytes(&random_byte, 1);
 
@@ -96,14 +285,13 @@ namespace visus::cuid2::utils {
             return "0";
         }
 
-        constexpr auto BASE36_CHARS = get_base36_chars();
         std::string result;
 
         result.reserve(data.size() * 2);
 
         while (num > 0) {
             cpp_int const REMAINDER = num % BASE36_RADIX;
-            result.push_back(BASE36_CHARS[static_cast<int>(REMAINDER)]);
+            result.push_back(BASE36_ALPHABET[static_cast<int>(REMAINDER)]);
             num /= BASE36_RADIX;
         }
 
@@ -112,12 +300,75 @@ namespace visus::cuid2::utils {
         return result;
     }
 
+    /// Encodes a SHA3-512 digest as a base-36 string.
+    ///
+    /// Loads the digest into eight big-endian 64-bit limbs and repeatedly
+    /// divides the whole value by 36^12. Each pass yields a remainder holding
+    /// the next twelve least-significant digits. Leading zero limbs are skipped
+    /// as the value shrinks, and all scratch space lives on the stack.
+    ///
+    /// @param digest Digest to encode (interpreted as big-endian)
+    /// @return Base-36 encoded string, or "0" if the digest is all zeros
+    std::string encode_base36(const Digest& digest) {
+        std::array<uint64_t, DIGEST_LIMBS> limbs{};
+        std::array<uint64_t, DIGEST_BASE36_CHUNKS> chunks{};
+        std::array<char, DIGEST_BASE36_DIGITS> buffer{};
+
+        load_limbs(digest, limbs);
+
+        const size_t WRITTEN = write_base36_prefix(limbs, chunks, buffer);
+
+        return {buffer.data(), WRITTEN};
+    }
+
+    /// Encodes the most significant base-36 digits of a byte array.
+    ///
+    /// @param data Span of bytes to encode (interpreted as big-endian)
+    /// @param DIGITS Maximum number of leading digits to produce
+    /// @return The first DIGITS characters of encode_base36(data)
+    std::string encode_base36_prefix(const std::span<const uint8_t> data, const size_t DIGITS) {
+        std::string result(DIGITS, '\0');
+        result.resize(encode_base36_prefix(data, result));
+
+        return result;
+    }
+
+    /// Writes the most significant base-36 digits of a byte array into a buffer.
+    ///
+    /// Inputs of up to 64 bytes (including every SHA3-512 digest) are converted
+    /// entirely in stack buffers; longer inputs use a heap-allocated limb array.
+    /// Only the chunks containing the requested digits are formatted.
+    ///
+    /// @param data Span of bytes to encode (interpreted as big-endian)
+    /// @param out Destination for the leading digits (not NUL-terminated)
+    /// @return Number of digits written: min(out.size(), total digit count)
+    size_t encode_base36_prefix(const std::span<const uint8_t> data, const std::span<char> out) {
+        const size_t LIMB_COUNT = (data.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        if (LIMB_COUNT <= DIGEST_LIMBS) [[likely]] {
+            std::array<uint64_t, DIGEST_LIMBS> limbs{};
+            std::array<uint64_t, DIGEST_BASE36_CHUNKS> chunks{};
+
+            const std::span<uint64_t> VALUE(limbs.data(), LIMB_COUNT);
+            load_limbs(data, VALUE);
+
+            return write_base36_prefix(VALUE, chunks, out);
+        }
+
+        std::vector<uint64_t> limbs(LIMB_COUNT);
+        std::vector<uint64_t> chunks(max_base36_chunks(LIMB_COUNT));
+
+        load_limbs(data, limbs);
+
+        return write_base36_prefix(limbs, chunks, out);
+    }
+
     /// Returns the current time as 100-nanosecond ticks since Unix epoch.
     ///
     /// Provides a high-resolution timestamp as the number of 100-nanosecond
     /// intervals since January 1, 1970 00:00:00 UTC (Unix epoch). The timestamp
-    /// is monotonically increasing (within clock precision) and suitable for
-    /// sortable identifier generation.
+    /// is monotonically increasing (within clock precision); it is hashed into
+    /// default identifiers and leads sortable ones.
     ///
     /// @return Current timestamp as 100-nanosecond ticks since Unix epoch
     /// @note Thread-safe: Can be called concurrently from multiple threads
@@ -129,4 +380,45 @@ namespace visus::cuid2::utils {
 
         return TICKS.count();
     }
+
+    /// Returns the current time from the coarse real-time clock as
+    /// 100-nanosecond ticks since Unix epoch.
+    ///
+    /// @return Current coarse timestamp as 100-nanosecond ticks since Unix epoch
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    int64_t get_coarse_timestamp_ticks() noexcept {
+#if defined(_WIN32)
+        // FILETIME counts 100-nanosecond intervals since 1601-01-01
+        constexpr int64_t FILETIME_UNIX_EPOCH = 116'444'736'000'000'000;
+
+        FILETIME file_time{};
+        GetSystemTimeAsFileTime(&file_time);
+
+        const auto TICKS = (static_cast<uint64_t>(file_time.dwHighDateTime) << 32) | file_time.dwLowDateTime;
+
+        return static_cast<int64_t>(TICKS) - FILETIME_UNIX_EPOCH;
+#elif defined(CUID2_COARSE_CLOCK)
+        constexpr int64_t NANOSECONDS_PER_TICK = 1'000'000'000 / TICKS_PER_SECOND;
+
+        timespec now{};
+        if (clock_gettime(CUID2_COARSE_CLOCK, &now) != 0) [[unlikely]] {
+            return get_timestamp_ticks(); // GCOVR_EXCL_LINE
+        }
+
+        return static_cast<int64_t>(now.tv_sec) * TICKS_PER_SECOND + static_cast<int64_t>(now.tv_nsec) / NANOSECONDS_PER_TICK;
+#else
+        return get_timestamp_ticks();
+#endif
+    }
+
+    /// Reports whether a coarse clock is available on this platform.
+    ///
+    /// @return true if get_coarse_timestamp_ticks() does not fall back
+    bool has_coarse_clock() noexcept {
+#if defined(_WIN32) || defined(CUID2_COARSE_CLOCK)
+        return true;
+#else
+        return false;
+#endif
+    }
 } // namespace visus::cuid2::utils
@@ -0,0 +1,259 @@
+/// @file validate.cpp
+/// @brief CUID2 identifier validation and kernel dispatch
+///
+/// This file selects the widest range-check backend supported by the running
+/// CPU and applies it to single identifiers, batches of views and strided
+/// columns. The SIMD kernels live in validate_sse42.cpp, validate_avx2.cpp and
+/// validate_neon.cpp, each compiled with its own instruction-set flags.
+
+#include "cuid2/validate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+#include "cuid2/cuid2.hpp"
+#include "validate_kernels.hpp"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+    #include <immintrin.h>
+    #include <intrin.h>
+#endif
+
+namespace visus::cuid2 {
+    namespace validation {
+        namespace {
+            /// Queries the CPU for the widest usable backend.
+            ///
+            /// On x86-64 AVX2 also needs operating system support for the
+            /// 256-bit register state. AArch64 always has NEON.
+            ///
+            /// @return Widest backend the running CPU supports
+            Backend query_cpu() noexcept {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+                __builtin_cpu_init();
+
+                if (__builtin_cpu_supports("avx2")) {
+                    return Backend::avx2;
+                }
+
+                if (__builtin_cpu_supports("sse4.2")) {
+                    return Backend::sse42;
+                }
+
+                return Backend::scalar;
+#elif defined(_MSC_VER) && defined(_M_X64)
+                constexpr int SSE42_BIT = 1 << 20;
+                constexpr int OSXSAVE_BIT = 1 << 27;
+                constexpr int AVX2_BIT = 1 << 5;
+                constexpr unsigned long long YMM_STATE = 0x6;
+
+                std::array<int, 4> registers{};
+                __cpuid(registers.data(), 1);
+                const bool HAS_SSE42 = (registers[2] & SSE42_BIT) != 0;
+
+                if ((registers[2] & OSXSAVE_BIT) != 0 && (_xgetbv(0) & YMM_STATE) == YMM_STATE) {
+                    __cpuidex(registers.data(), 7, 0);
+
+                    if ((registers[1] & AVX2_BIT) != 0) {
+                        return Backend::avx2;
+                    }
+                }
+
+                return HAS_SSE42 ? Backend::sse42 : Backend::scalar;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+                return Backend::neon;
+#else
+                return Backend::scalar;
+#endif
+            }
+        } // anonymous namespace
+
+        /// Returns the widest backend supported by the compiler and running CPU.
+        ///
+        /// @return Preferred backend for this process
+        /// @note Thread-safe: Can be called concurrently from multiple threads
+        Backend detect_backend() noexcept {
+            static const Backend DETECTED = query_cpu();
+
+            return DETECTED;
+        }
+
+        /// Reports whether a backend can run on this build and CPU.
+        ///
+        /// Every x86-64 CPU with AVX2 also has SSE4.2, so a backend is usable
+        /// when it is not wider than the detected one.
+        ///
+        /// @param BACKEND Backend to check
+        /// @return true if kernels_for(BACKEND) may be called
+        bool is_supported(const Backend BACKEND) noexcept {
+            const Backend DETECTED = detect_backend();
+
+            switch (BACKEND) {
+                case Backend::scalar:
+                    return true;
+                case Backend::sse42:
+                    return DETECTED == Backend::sse42 || DETECTED == Backend::avx2;
+                case Backend::avx2:
+                    return DETECTED == Backend::avx2;
+                case Backend::neon:
+                    return DETECTED == Backend::neon;
+            }
+
+            // GCOVR_EXCL_START - every enumerator is handled above
+            return false;
+            // GCOVR_EXCL_STOP
+        }
+
+        /// Returns a short human-readable backend name.
+        ///
+        /// @param BACKEND Backend to name
+        /// @return Name with static storage duration
+        std::string_view backend_name(const Backend BACKEND) noexcept {
+            switch (BACKEND) {
+                case Backend::sse42:
+                    return "sse4.2";
+                case Backend::avx2:
+                    return "avx2";
+                case Backend::neon:
+                    return "neon";
+                default:
+                    return "scalar";
+            }
+        }
+
+        /// Returns the kernels of a backend.
+        ///
+        /// @param BACKEND Backend; must satisfy is_supported()
+        /// @return Exact and padded kernels
+        Kernels kernels_for(const Backend BACKEND) noexcept {
+            switch (BACKEND) {
+#if defined(__x86_64__) || defined(_M_X64)
+                case Backend::sse42:
+                    return {.exact = is_base36_sse42, .padded = is_base36_sse42_padded};
+                case Backend::avx2:
+                    return {.exact = is_base36_avx2, .padded = is_base36_avx2_padded};
+#elif defined(__aarch64__) || defined(_M_ARM64)
+                case Backend::neon:
+                    return {.exact = is_base36_neon, .padded = is_base36_neon};
+#endif
+                default:
+                    return {.exact = swar::is_base36, .padded = swar::is_base36};
+            }
+        }
+    } // namespace validation
+
+    namespace {
+        /// Returns the kernels of the detected backend, selected once.
+        const validation::Kernels& active_kernels() noexcept {
+            static const validation::Kernels KERNELS = validation::kernels_for(validation::detect_backend());
+
+            return KERNELS;
+        }
+
+        /// Checks the leading letter and then the whole text with KERNEL.
+        ///
+        /// @param TEXT Start of an identifier already known to be 4-32 characters
+        /// @param LENGTH Identifier length
+        /// @param KERNEL Range-check kernel allowed to read this record
+        bool check(const char* TEXT, const size_t LENGTH, const validation::Kernel KERNEL) noexcept {
+            if (TEXT[0] < validation::LETTER_FIRST || TEXT[0] > validation::LETTER_LAST) {
+                return false;
+            }
+
+            return KERNEL(TEXT, LENGTH);
+        }
+
+        /// Checks one view against the length bounds and EXPECTED_LENGTH.
+        bool check_view(const std::string_view TEXT, const int EXPECTED_LENGTH,
+                        const validation::Kernel KERNEL) noexcept {
+            if (EXPECTED_LENGTH != ANY_LENGTH && TEXT.size() != static_cast<size_t>(EXPECTED_LENGTH)) {
+                return false;
+            }
+
+            if (TEXT.size() < static_cast<size_t>(MIN_CUID2_LENGTH) ||
+                TEXT.size() > static_cast<size_t>(MAX_CUID2_LENGTH)) {
+                return false;
+            }
+
+            return check(TEXT.data(), TEXT.size(), KERNEL);
+        }
+    } // anonymous namespace
+
+    /// Checks whether text is a well-formed CUID2 identifier.
+    ///
+    /// @param TEXT Text to check
+    /// @param EXPECTED_LENGTH Required length, or ANY_LENGTH for 4 to 32
+    /// @return true if TEXT has the CUID2 shape and the expected length
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    bool is_cuid2(const std::string_view TEXT, const int EXPECTED_LENGTH) noexcept {
+        return check_view(TEXT, EXPECTED_LENGTH, active_kernels().exact);
+    }
+
+    /// Checks many identifiers at once.
+    ///
+    /// @param ids Text to check
+    /// @param results Receives one result per element of ids
+    /// @param EXPECTED_LENGTH Required length, or ANY_LENGTH for 4 to 32
+    /// @throws std::invalid_argument if results and ids differ in size
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    void validate_batch(const std::span<const std::string_view> ids, const std::span<bool> results,
+                        const int EXPECTED_LENGTH) {
+        if (results.size() != ids.size()) [[unlikely]] {
+            throw std::invalid_argument("results must have one entry per identifier");
+        }
+
+        const validation::Kernel KERNEL = active_kernels().exact;
+
+        for (size_t idx = 0; idx < ids.size(); ++idx) {
+            results[idx] = check_view(ids[idx], EXPECTED_LENGTH, KERNEL);
+        }
+    }
+
+    /// Checks fixed-width identifiers stored at a fixed stride.
+    ///
+    /// Records whose start is at least PADDED_READ bytes before the end of the
+    /// column use the padded kernel; the last few fall back to the exact one so
+    /// nothing is read past the buffer.
+    ///
+    /// @param column Buffer holding results.size() records
+    /// @param STRIDE Distance in bytes between consecutive records
+    /// @param LENGTH Length of every identifier (min: 4, max: 32, at most STRIDE)
+    /// @param results Receives one result per record
+    /// @throws std::invalid_argument if LENGTH, STRIDE or the column size is invalid
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    void validate_batch(const std::span<const char> column, const std::size_t STRIDE, const int LENGTH,
+                        const std::span<bool> results) {
+        if (LENGTH < MIN_CUID2_LENGTH || LENGTH > MAX_CUID2_LENGTH) [[unlikely]] {
+            throw std::invalid_argument("LENGTH must be between 4 and 32");
+        }
+
+        const auto RECORD_LENGTH = static_cast<size_t>(LENGTH);
+        if (STRIDE < RECORD_LENGTH) [[unlikely]] {
+            throw std::invalid_argument("STRIDE must be at least LENGTH");
+        }
+
+        const size_t COUNT = results.size();
+        if (COUNT == 0) {
+            return;
+        }
+
+        // Written as a division so a huge COUNT cannot overflow the product
+        if (column.size() < RECORD_LENGTH || (column.size() - RECORD_LENGTH) / STRIDE < COUNT - 1) [[unlikely]] {
+            throw std::invalid_argument("column is too small for the requested records");
+        }
+
+        const validation::Kernels& KERNELS = active_kernels();
+        const size_t PADDED_COUNT = column.size() < validation::PADDED_READ
+            ? 0
+            : std::min(COUNT, (column.size() - validation::PADDED_READ) / STRIDE + 1);
+
+        for (size_t idx = 0; idx < PADDED_COUNT; ++idx) {
+            results[idx] = check(column.data() + idx * STRIDE, RECORD_LENGTH, KERNELS.padded);
+        }
+
+        for (size_t idx = PADDED_COUNT; idx < COUNT; ++idx) {
+            results[idx] = check(column.data() + idx * STRIDE, RECORD_LENGTH, KERNELS.exact);
+        }
+    }
+} // namespace visus::cuid2
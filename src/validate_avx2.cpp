@@ -0,0 +1,56 @@
+/// @file validate_avx2.cpp
+/// @brief AVX2 base-36 range-check kernels
+///
+/// Compiled with AVX2 enabled; only called after detect_backend() has
+/// confirmed CPU and operating system support. Every identifier fits in one
+/// 256-bit vector, so a check is two range compares and one movemask.
+
+#include <immintrin.h>
+
+#include "validate_kernels.hpp"
+
+namespace visus::cuid2::validation {
+    namespace {
+        constexpr size_t HALF_BYTES = 16;
+
+        /// Marks the bytes of BYTES that lie in [LO, HI] with 0xFF.
+        ///
+        /// Subtracting LO wraps everything below it to a large unsigned value,
+        /// so one unsigned minimum against HI - LO tests both bounds.
+        __m256i in_range(const __m256i BYTES, const char LO, const char HI) noexcept {
+            const __m256i SHIFTED = _mm256_sub_epi8(BYTES, _mm256_set1_epi8(LO));
+
+            return _mm256_cmpeq_epi8(_mm256_min_epu8(SHIFTED, _mm256_set1_epi8(static_cast<char>(HI - LO))), SHIFTED);
+        }
+
+        /// Returns one bit per byte, set for base-36 digits.
+        uint32_t base36_mask(const __m256i BYTES) noexcept {
+            const __m256i VALID = _mm256_or_si256(
+                in_range(BYTES, DIGIT_FIRST, DIGIT_LAST), in_range(BYTES, LETTER_FIRST, LETTER_LAST));
+
+            return static_cast<uint32_t>(_mm256_movemask_epi8(VALID));
+        }
+    } // anonymous namespace
+
+    /// Checks LENGTH bytes with the two sixteen-byte halves loaded from the
+    /// start and the end, or with the SWAR kernel when LENGTH is below sixteen.
+    bool is_base36_avx2(const char* TEXT, const size_t LENGTH) noexcept {
+        if (LENGTH < HALF_BYTES) {
+            return swar::is_base36(TEXT, LENGTH);
+        }
+
+        const __m256i BYTES = _mm256_loadu2_m128i(
+            reinterpret_cast<const __m128i*>(TEXT + LENGTH - HALF_BYTES), reinterpret_cast<const __m128i*>(TEXT));
+
+        return base36_mask(BYTES) == UINT32_MAX;
+    }
+
+    /// Checks LENGTH bytes of a record followed by at least PADDED_READ - LENGTH
+    /// readable bytes; the bytes after LENGTH are loaded but ignored.
+    bool is_base36_avx2_padded(const char* TEXT, const size_t LENGTH) noexcept {
+        const __m256i BYTES = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(TEXT));
+        const auto WANTED = static_cast<uint32_t>((uint64_t{1} << LENGTH) - 1);
+
+        return (base36_mask(BYTES) & WANTED) == WANTED;
+    }
+} // namespace visus::cuid2::validation
@@ -0,0 +1,163 @@
+/// @file validate_kernels.hpp
+/// @brief Base-36 range-check kernels behind is_cuid2() and validate_batch()
+///
+/// Internal header. A kernel checks that every byte of a 4-32 character range
+/// is a lowercase base-36 digit; the caller checks the leading letter. Exact
+/// kernels read only the LENGTH bytes they are given and cover lengths that
+/// are not a multiple of the vector width with overlapping loads. Padded
+/// kernels may read PADDED_READ bytes, which columnar records with enough
+/// bytes after them allow, and mask off the positions past LENGTH.
+
+#ifndef LIBCUID2_VALIDATE_KERNELS_HPP
+#define LIBCUID2_VALIDATE_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "cuid2/cuid2.hpp"
+#include "cuid2/utils.hpp"
+
+namespace visus::cuid2::validation {
+    /// Range-check implementation.
+    enum class Backend {
+        /// Eight characters per 64-bit word (SWAR), on every platform.
+        scalar,
+
+        /// SSE4.2 PCMPESTRI range compares (x86-64).
+        sse42,
+
+        /// One 256-bit compare per identifier (x86-64 with AVX2).
+        avx2,
+
+        /// Two 128-bit compares per identifier (AArch64).
+        neon,
+    };
+
+    /// Checks LENGTH bytes at TEXT, with LENGTH in [MIN_CUID2_LENGTH, MAX_CUID2_LENGTH].
+    using Kernel = bool (*)(const char* TEXT, size_t LENGTH) noexcept;
+
+    /// Kernels of one backend.
+    struct Kernels {
+        /// Reads only [TEXT, TEXT + LENGTH).
+        Kernel exact = nullptr;
+
+        /// May read [TEXT, TEXT + PADDED_READ).
+        Kernel padded = nullptr;
+    };
+
+    /// Bytes a padded kernel may read from the start of a record.
+    constexpr size_t PADDED_READ = static_cast<size_t>(MAX_CUID2_LENGTH);
+
+    /// Bounds of the two contiguous runs of the base-36 alphabet.
+    constexpr char DIGIT_FIRST = utils::BASE36_ALPHABET[0];
+    constexpr char DIGIT_LAST = utils::BASE36_ALPHABET[9];
+    constexpr char LETTER_FIRST = utils::BASE36_ALPHABET[10];
+    constexpr char LETTER_LAST = utils::BASE36_ALPHABET[35];
+
+    static_assert(utils::BASE36_ALPHABET.size() == 36);
+    static_assert(DIGIT_LAST - DIGIT_FIRST == 9 && LETTER_LAST - LETTER_FIRST == 25,
+        "range checks assume the alphabet is '0'-'9' followed by 'a'-'z'");
+
+    /// Returns the widest backend supported by the compiler and running CPU.
+    ///
+    /// The CPU is queried once; later calls return the cached result.
+    ///
+    /// @return Preferred backend for this process
+    /// @note Thread-safe: Can be called concurrently from multiple threads
+    [[nodiscard]] Backend detect_backend() noexcept;
+
+    /// Reports whether a backend can run on this build and CPU.
+    ///
+    /// @param BACKEND Backend to check
+    /// @return true if kernels_for(BACKEND) may be called
+    [[nodiscard]] bool is_supported(Backend BACKEND) noexcept;
+
+    /// Returns a short human-readable backend name ("scalar", "sse4.2", ...).
+    ///
+    /// @param BACKEND Backend to name
+    /// @return Name with static storage duration
+    [[nodiscard]] std::string_view backend_name(Backend BACKEND) noexcept;
+
+    /// Returns the kernels of a backend.
+    ///
+    /// @param BACKEND Backend; must satisfy is_supported()
+    /// @return Exact and padded kernels
+    [[nodiscard]] Kernels kernels_for(Backend BACKEND) noexcept;
+
+    namespace swar {
+        /// Repeats a byte in every byte of a word.
+        constexpr uint64_t broadcast(const uint8_t BYTE) noexcept {
+            return 0x0101010101010101ULL * BYTE;
+        }
+
+        constexpr uint64_t HIGH_BITS = broadcast(0x80);
+
+        /// Sets the high bit of every byte of WORD that lies in [LO, HI].
+        ///
+        /// Bytes must be below 0x80 so the additions never carry between bytes.
+        constexpr uint64_t bytes_in_range(const uint64_t WORD, const char LO, const char HI) noexcept {
+            const uint64_t AT_LEAST_LO = WORD + broadcast(static_cast<uint8_t>(0x80 - LO));
+            const uint64_t ABOVE_HI = WORD + broadcast(static_cast<uint8_t>(0x7F - HI));
+
+            return AT_LEAST_LO & ~ABOVE_HI & HIGH_BITS;
+        }
+
+        /// Checks that every byte of WORD is a lowercase base-36 digit.
+        constexpr bool is_base36_word(const uint64_t WORD) noexcept {
+            if ((WORD & HIGH_BITS) != 0) {
+                return false;
+            }
+
+            return (bytes_in_range(WORD, DIGIT_FIRST, DIGIT_LAST) |
+                    bytes_in_range(WORD, LETTER_FIRST, LETTER_LAST)) == HIGH_BITS;
+        }
+
+        /// Reads eight bytes at TEXT.
+        inline uint64_t load_word(const char* TEXT) noexcept {
+            uint64_t word = 0;
+            std::memcpy(&word, TEXT, sizeof(word));
+
+            return word;
+        }
+
+        /// Checks LENGTH bytes one word at a time.
+        ///
+        /// The last word is read at LENGTH - 8 and may overlap the previous one;
+        /// lengths below eight are covered by two overlapping four-byte reads.
+        inline bool is_base36(const char* TEXT, const size_t LENGTH) noexcept {
+            if (LENGTH < sizeof(uint64_t)) {
+                uint32_t head = 0;
+                uint32_t tail = 0;
+                std::memcpy(&head, TEXT, sizeof(head));
+                std::memcpy(&tail, TEXT + LENGTH - sizeof(tail), sizeof(tail));
+
+                return is_base36_word(head | (static_cast<uint64_t>(tail) << 32));
+            }
+
+            for (size_t offset = 0; offset + sizeof(uint64_t) < LENGTH; offset += sizeof(uint64_t)) {
+                if (!is_base36_word(load_word(TEXT + offset))) {
+                    return false;
+                }
+            }
+
+            return is_base36_word(load_word(TEXT + LENGTH - sizeof(uint64_t)));
+        }
+    } // namespace swar
+
+#if defined(__x86_64__) || defined(_M_X64)
+    /// SSE4.2 kernels (validate_sse42.cpp).
+    bool is_base36_sse42(const char* TEXT, size_t LENGTH) noexcept;
+    bool is_base36_sse42_padded(const char* TEXT, size_t LENGTH) noexcept;
+
+    /// AVX2 kernels (validate_avx2.cpp).
+    bool is_base36_avx2(const char* TEXT, size_t LENGTH) noexcept;
+    bool is_base36_avx2_padded(const char* TEXT, size_t LENGTH) noexcept;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    /// NEON kernel (validate_neon.cpp); also used for padded records.
+    bool is_base36_neon(const char* TEXT, size_t LENGTH) noexcept;
+#endif
+} // namespace visus::cuid2::validation
+
+#endif // LIBCUID2_VALIDATE_KERNELS_HPP
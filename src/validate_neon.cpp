@@ -0,0 +1,39 @@
+/// @file validate_neon.cpp
+/// @brief NEON base-36 range-check kernel
+///
+/// NEON is part of the AArch64 baseline, so no CPU check is needed. Records
+/// of sixteen bytes or more are covered by two overlapping 128-bit loads.
+
+#include <arm_neon.h>
+
+#include "validate_kernels.hpp"
+
+namespace visus::cuid2::validation {
+    namespace {
+        constexpr size_t VECTOR_BYTES = 16;
+
+        /// Marks the bytes of BYTES that lie in [LO, HI] with 0xFF.
+        uint8x16_t in_range(const uint8x16_t BYTES, const char LO, const char HI) noexcept {
+            const uint8x16_t SHIFTED = vsubq_u8(BYTES, vdupq_n_u8(static_cast<uint8_t>(LO)));
+
+            return vcleq_u8(SHIFTED, vdupq_n_u8(static_cast<uint8_t>(HI - LO)));
+        }
+
+        uint8x16_t base36_bytes(const char* TEXT) noexcept {
+            const uint8x16_t BYTES = vld1q_u8(reinterpret_cast<const uint8_t*>(TEXT));
+
+            return vorrq_u8(in_range(BYTES, DIGIT_FIRST, DIGIT_LAST), in_range(BYTES, LETTER_FIRST, LETTER_LAST));
+        }
+    } // anonymous namespace
+
+    /// Checks LENGTH bytes, using the SWAR kernel when LENGTH is below sixteen.
+    bool is_base36_neon(const char* TEXT, const size_t LENGTH) noexcept {
+        if (LENGTH < VECTOR_BYTES) {
+            return swar::is_base36(TEXT, LENGTH);
+        }
+
+        const uint8x16_t VALID = vandq_u8(base36_bytes(TEXT), base36_bytes(TEXT + LENGTH - VECTOR_BYTES));
+
+        return vminvq_u8(VALID) == UINT8_MAX;
+    }
+} // namespace visus::cuid2::validation
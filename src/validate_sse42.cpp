@@ -0,0 +1,60 @@
+/// @file validate_sse42.cpp
+/// @brief SSE4.2 base-36 range-check kernels
+///
+/// Compiled with SSE4.2 enabled; only called after detect_backend() has
+/// confirmed CPU support. PCMPESTRI in ranges mode tests sixteen bytes against
+/// both alphabet runs in one instruction and honours an explicit length, so
+/// the padded kernel needs no separate mask.
+
+#include <nmmintrin.h>
+
+#include "validate_kernels.hpp"
+
+namespace visus::cuid2::validation {
+    namespace {
+        constexpr size_t VECTOR_BYTES = 16;
+
+        /// Carry is set when any of the first LENGTH bytes lies outside every range.
+        constexpr int MODE = _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_MASKED_NEGATIVE_POLARITY;
+
+        /// Range pairs [DIGIT_FIRST, DIGIT_LAST] and [LETTER_FIRST, LETTER_LAST].
+        __m128i ranges() noexcept {
+            return _mm_setr_epi8(DIGIT_FIRST, DIGIT_LAST, LETTER_FIRST, LETTER_LAST, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        }
+
+        /// Checks the first LENGTH bytes of a vector.
+        bool in_ranges(const __m128i RANGES, const __m128i BYTES, const size_t LENGTH) noexcept {
+            return _mm_cmpestrc(RANGES, 4, BYTES, static_cast<int>(LENGTH), MODE) == 0;
+        }
+
+        __m128i load(const char* TEXT) noexcept {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(TEXT));
+        }
+    } // anonymous namespace
+
+    /// Checks LENGTH bytes using two overlapping sixteen-byte loads, or the
+    /// SWAR kernel when LENGTH is below sixteen.
+    bool is_base36_sse42(const char* TEXT, const size_t LENGTH) noexcept {
+        if (LENGTH < VECTOR_BYTES) {
+            return swar::is_base36(TEXT, LENGTH);
+        }
+
+        const __m128i RANGES = ranges();
+
+        return in_ranges(RANGES, load(TEXT), VECTOR_BYTES) &&
+               in_ranges(RANGES, load(TEXT + LENGTH - VECTOR_BYTES), VECTOR_BYTES);
+    }
+
+    /// Checks LENGTH bytes of a record followed by at least PADDED_READ - LENGTH
+    /// readable bytes.
+    bool is_base36_sse42_padded(const char* TEXT, const size_t LENGTH) noexcept {
+        const __m128i RANGES = ranges();
+
+        if (LENGTH <= VECTOR_BYTES) {
+            return in_ranges(RANGES, load(TEXT), LENGTH);
+        }
+
+        return in_ranges(RANGES, load(TEXT), VECTOR_BYTES) &&
+               in_ranges(RANGES, load(TEXT + VECTOR_BYTES), LENGTH - VECTOR_BYTES);
+    }
+} // namespace visus::cuid2::validation
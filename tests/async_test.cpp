@@ -0,0 +1,275 @@
+#define BOOST_TEST_MODULE AsyncTest
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "cuid2/async.hpp"
+#include "cuid2/pool.hpp"
+#include "entropy_guard.hpp"
+
+namespace {
+    /// Fire-and-forget coroutine that starts immediately.
+    struct Task {
+        struct promise_type {
+            Task get_return_object() noexcept {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() noexcept {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept {
+                return {};
+            }
+
+            void return_void() noexcept {}
+
+            void unhandled_exception() noexcept {
+                std::terminate();
+            }
+        };
+    };
+
+    /// What an awaiting coroutine observed.
+    struct Outcome {
+        std::vector<std::string> ids;
+        std::exception_ptr error;
+        std::thread::id resumed_on;
+    };
+
+    /// Awaits async_generate() and reports the outcome through a promise.
+    Task await_ids(const std::size_t COUNT, visus::cuid2::AsyncOptions options, std::promise<Outcome>& done) {
+        Outcome outcome;
+
+        try {
+            outcome.ids = co_await visus::cuid2::async_generate(COUNT, std::move(options));
+        } catch (...) {
+            outcome.error = std::current_exception();
+        }
+
+        outcome.resumed_on = std::this_thread::get_id();
+        done.set_value(std::move(outcome));
+    }
+
+    /// Runs await_ids() from the calling thread and waits for it to finish.
+    Outcome run(const std::size_t COUNT, visus::cuid2::AsyncOptions options = {}) {
+        std::promise<Outcome> done;
+        auto result = done.get_future();
+
+        await_ids(COUNT, std::move(options), done);
+
+        BOOST_REQUIRE(result.wait_for(std::chrono::seconds(30)) == std::future_status::ready);
+
+        return result.get();
+    }
+
+    /// Executor that runs each job on a new thread and counts the jobs.
+    struct ThreadExecutor {
+        std::shared_ptr<std::atomic<int>> calls = std::make_shared<std::atomic<int>>(0);
+        std::shared_ptr<std::vector<std::thread>> threads = std::make_shared<std::vector<std::thread>>();
+
+        /// Thread that ran the most recent job.
+        std::shared_ptr<std::thread::id> last_thread = std::make_shared<std::thread::id>();
+
+        void operator()(std::function<void()> job) const {
+            calls->fetch_add(1);
+            threads->emplace_back([last = last_thread, job = std::move(job)] {
+                *last = std::this_thread::get_id();
+                job();
+            });
+        }
+
+        void join() const {
+            for (auto& thread : *threads) {
+                thread.join();
+            }
+        }
+    };
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(AsyncTests)
+
+BOOST_AUTO_TEST_CASE(test_async_generate_on_shared_worker)
+{
+    const Outcome OUTCOME = run(500, {.length = 16});
+
+    BOOST_TEST_REQUIRE(!OUTCOME.error);
+    BOOST_TEST(OUTCOME.ids.size() == 500U);
+    BOOST_TEST(OUTCOME.resumed_on != std::this_thread::get_id());
+
+    const std::set<std::string> UNIQUE(OUTCOME.ids.begin(), OUTCOME.ids.end());
+    BOOST_TEST(UNIQUE.size() == 500U);
+
+    for (const auto& ID : OUTCOME.ids) {
+        BOOST_TEST_REQUIRE(visus::cuid2::is_cuid2(ID, 16), "identifier " << ID);
+    }
+
+    // The worker is reused, not restarted per request
+    BOOST_TEST((run(1).resumed_on == OUTCOME.resumed_on));
+}
+
+BOOST_AUTO_TEST_CASE(test_async_generate_custom_executors)
+{
+    const ThreadExecutor WORKERS;
+    const ThreadExecutor RESUMER;
+
+    const Outcome OUTCOME = run(32, {.executor = WORKERS, .resume = RESUMER});
+    WORKERS.join();
+    RESUMER.join();
+
+    BOOST_TEST_REQUIRE(!OUTCOME.error);
+    BOOST_TEST(OUTCOME.ids.size() == 32U);
+    BOOST_TEST(WORKERS.calls->load() == 1);
+    BOOST_TEST(RESUMER.calls->load() == 1);
+    BOOST_TEST((OUTCOME.resumed_on == *RESUMER.last_thread));
+    BOOST_TEST((*WORKERS.last_thread != *RESUMER.last_thread));
+}
+
+BOOST_AUTO_TEST_CASE(test_async_generate_inline_executor)
+{
+    // An executor that runs the job before returning resumes the coroutine
+    // from inside await_suspend()
+    int calls = 0;
+    const Outcome OUTCOME = run(4, {.executor = [&calls](const std::function<void()>& job) {
+                                        ++calls;
+                                        job();
+                                    }});
+
+    BOOST_TEST_REQUIRE(!OUTCOME.error);
+    BOOST_TEST(OUTCOME.ids.size() == 4U);
+    BOOST_TEST(calls == 1);
+    BOOST_TEST((OUTCOME.resumed_on == std::this_thread::get_id()));
+}
+
+BOOST_AUTO_TEST_CASE(test_async_generate_from_pool_without_suspending)
+{
+    visus::cuid2::Pool pool({.length = 24, .capacity = 64});
+    const ThreadExecutor WORKERS;
+
+    const Outcome OUTCOME = run(40, {.pool = &pool, .executor = WORKERS});
+
+    BOOST_TEST_REQUIRE(!OUTCOME.error);
+    BOOST_TEST(OUTCOME.ids.size() == 40U);
+    BOOST_TEST(WORKERS.calls->load() == 0);
+    BOOST_TEST((OUTCOME.resumed_on == std::this_thread::get_id()));
+    BOOST_TEST(pool.stats().hits == 40U);
+    BOOST_TEST(pool.stats().misses == 0U);
+}
+
+BOOST_AUTO_TEST_CASE(test_async_generate_pool_shortfall)
+{
+    // More than the ring holds: the rest is generated on the executor
+    visus::cuid2::Pool pool({.length = 12, .capacity = 8, .refill_batch = 8});
+    const ThreadExecutor WORKERS;
+
+    const Outcome OUTCOME = run(100, {.length = 12, .pool = &pool, .executor = WORKERS});
+    WORKERS.join();
+
+    BOOST_TEST_REQUIRE(!OUTCOME.error);
+    BOOST_TEST(OUTCOME.ids.size() == 100U);
+    BOOST_TEST(WORKERS.calls->load() == 1);
+    BOOST_TEST(pool.stats().misses == 0U);
+
+    const std::set<std::string> UNIQUE(OUTCOME.ids.begin(), OUTCOME.ids.end());
+    BOOST_TEST(UNIQUE.size() == 100U);
+
+    for (const auto& ID : OUTCOME.ids) {
+        BOOST_TEST_REQUIRE(visus::cuid2::is_cuid2(ID, 12), "identifier " << ID);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_async_generate_empty_request)
+{
+    const Outcome OUTCOME = run(0);
+
+    BOOST_TEST(!OUTCOME.error);
+    BOOST_TEST(OUTCOME.ids.empty());
+    BOOST_TEST((OUTCOME.resumed_on == std::this_thread::get_id()));
+}
+
+BOOST_AUTO_TEST_CASE(test_async_generate_rejects_bad_options)
+{
+    visus::cuid2::Pool pool({.length = 16, .capacity = 8});
+
+    BOOST_CHECK_THROW(static_cast<void>(visus::cuid2::async_generate(1, {.length = 3})), std::invalid_argument);
+    BOOST_CHECK_THROW(static_cast<void>(visus::cuid2::async_generate(1, {.length = 33})), std::invalid_argument);
+    BOOST_CHECK_THROW(static_cast<void>(visus::cuid2::async_generate(1, {.length = 24, .pool = &pool})),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_async_generate_propagates_errors)
+{
+    {
+        const visus::cuid2::test::FailingSourceGuard GUARD;
+        const Outcome OUTCOME = run(8);
+
+        BOOST_TEST_REQUIRE(static_cast<bool>(OUTCOME.error));
+        BOOST_CHECK_THROW(std::rethrow_exception(OUTCOME.error), std::runtime_error);
+    }
+
+    BOOST_TEST(run(8).ids.size() == 8U);
+}
+
+BOOST_AUTO_TEST_CASE(test_pool_try_acquire_into)
+{
+    visus::cuid2::Pool pool({.length = 10, .capacity = 4, .low_watermark = 1, .high_watermark = 4});
+
+    std::string id(10, '\0');
+    BOOST_TEST(pool.try_acquire_into(id));
+    BOOST_TEST(visus::cuid2::is_cuid2(id, 10));
+
+    std::string short_buffer(9, '\0');
+    BOOST_CHECK_THROW(pool.try_acquire_into(short_buffer), std::invalid_argument);
+    BOOST_TEST(pool.stats().misses == 0U);
+}
+
+#ifndef _WIN32
+BOOST_AUTO_TEST_CASE(test_async_generate_in_forked_child)
+{
+    // Start the parent's worker, then fork: the child must get its own
+    BOOST_TEST_REQUIRE(run(1).ids.size() == 1U);
+
+    const pid_t PID = fork();
+    BOOST_REQUIRE(PID >= 0);
+
+    if (PID == 0) {
+        std::promise<Outcome> done;
+        auto result = done.get_future();
+
+        await_ids(16, {}, done);
+
+        const bool OK = result.wait_for(std::chrono::seconds(10)) == std::future_status::ready &&
+                        result.get().ids.size() == 16U;
+        _exit(OK ? 0 : 1);
+    }
+
+    int status = 0;
+    waitpid(PID, &status, 0);
+
+    BOOST_TEST(WIFEXITED(status));
+    BOOST_TEST(WEXITSTATUS(status) == 0);
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
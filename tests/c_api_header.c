@@ -0,0 +1,34 @@
+/// @file c_api_header.c
+/// @brief Calls the C interface from a C99 translation unit
+///
+/// Compiled as C so that cuid2.h is checked by a C compiler; c_api_test.cpp
+/// calls these functions to confirm the C translation unit links and runs.
+
+#include <cuid2/cuid2.h>
+
+/// Writes count NUL-terminated default-length identifiers into rows, one per
+/// CUID2_DEFAULT_LENGTH + 1 bytes.
+int c_api_generate_rows(char* rows, size_t count);
+
+/// Checks a NUL-terminated string with cuid2_is_cuid2().
+int c_api_is_cuid2(const char* text);
+
+int c_api_generate_rows(char* rows, size_t count) {
+    size_t row = 0;
+
+    for (row = 0; row < count; ++row) {
+        rows[row * (CUID2_DEFAULT_LENGTH + 1) + CUID2_DEFAULT_LENGTH] = '\0';
+    }
+
+    return cuid2_generate_batch(rows, CUID2_DEFAULT_LENGTH + 1, count, CUID2_DEFAULT_LENGTH);
+}
+
+int c_api_is_cuid2(const char* text) {
+    size_t size = 0;
+
+    while (text[size] != '\0') {
+        ++size;
+    }
+
+    return cuid2_is_cuid2(text, size, CUID2_ANY_LENGTH);
+}
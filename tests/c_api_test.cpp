@@ -0,0 +1,176 @@
+#define BOOST_TEST_MODULE CApiTest
+#define BOOST_TEST_DYN_LINK
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+
+#include "cuid2/cuid2.h"
+#include "cuid2/cuid2.hpp"
+#include "entropy_guard.hpp"
+
+extern "C" {
+    int c_api_generate_rows(char* rows, std::size_t count);
+    int c_api_is_cuid2(const char* text);
+}
+
+BOOST_AUTO_TEST_SUITE(CApiTests)
+
+BOOST_AUTO_TEST_CASE(test_constants_match_cpp)
+{
+    BOOST_TEST(cuid2_abi_version() == CUID2_C_API_VERSION);
+    BOOST_TEST(CUID2_DEFAULT_LENGTH == visus::cuid2::DEFAULT_LENGTH);
+    BOOST_TEST(CUID2_MIN_LENGTH == visus::cuid2::MIN_CUID2_LENGTH);
+    BOOST_TEST(CUID2_MAX_LENGTH == visus::cuid2::MAX_CUID2_LENGTH);
+    BOOST_TEST(CUID2_ANY_LENGTH == visus::cuid2::ANY_LENGTH);
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_into)
+{
+    for (std::size_t length = CUID2_MIN_LENGTH; length <= CUID2_MAX_LENGTH; ++length) {
+        std::array<char, CUID2_MAX_LENGTH + 1> buffer{};
+        buffer.fill('#');
+
+        BOOST_TEST_REQUIRE(cuid2_generate_into(buffer.data(), length) == CUID2_OK);
+        BOOST_TEST(visus::cuid2::is_cuid2(std::string_view(buffer.data(), length), static_cast<int>(length)));
+        BOOST_TEST(buffer[length] == '#');
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_into_rejects_bad_arguments)
+{
+    std::array<char, 64> buffer{};
+
+    BOOST_TEST(cuid2_generate_into(nullptr, 24) == CUID2_ERROR_INVALID_ARGUMENT);
+    BOOST_TEST(cuid2_generate_into(buffer.data(), 3) == CUID2_ERROR_INVALID_ARGUMENT);
+    BOOST_TEST(cuid2_generate_into(buffer.data(), 33) == CUID2_ERROR_INVALID_ARGUMENT);
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_batch_strided)
+{
+    constexpr std::size_t COUNT = 1000;
+    constexpr std::size_t LENGTH = 20;
+    constexpr std::size_t STRIDE = 23;
+
+    // The buffer ends exactly after the last record
+    std::vector<char> buffer((COUNT - 1) * STRIDE + LENGTH, '#');
+
+    BOOST_TEST_REQUIRE(cuid2_generate_batch(buffer.data(), STRIDE, COUNT, static_cast<int>(LENGTH)) == CUID2_OK);
+
+    std::set<std::string> ids;
+    for (std::size_t idx = 0; idx < COUNT; ++idx) {
+        const std::string ID(buffer.data() + idx * STRIDE, LENGTH);
+
+        BOOST_TEST_REQUIRE(visus::cuid2::is_cuid2(ID, static_cast<int>(LENGTH)), "record " << idx << ": " << ID);
+        ids.insert(ID);
+
+        if (idx + 1 < COUNT) {
+            BOOST_TEST(std::string_view(buffer.data() + idx * STRIDE + LENGTH, STRIDE - LENGTH) == "###");
+        }
+    }
+
+    BOOST_TEST(ids.size() == COUNT);
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_batch_packed)
+{
+    constexpr std::size_t COUNT = 300;
+
+    std::vector<char> buffer(COUNT * CUID2_DEFAULT_LENGTH);
+    BOOST_TEST_REQUIRE(cuid2_generate_batch(buffer.data(), CUID2_DEFAULT_LENGTH, COUNT, CUID2_DEFAULT_LENGTH) == CUID2_OK);
+
+    const auto RESULTS = std::make_unique<bool[]>(COUNT);
+    visus::cuid2::validate_batch(buffer, CUID2_DEFAULT_LENGTH, CUID2_DEFAULT_LENGTH,
+                                 std::span<bool>(RESULTS.get(), COUNT));
+
+    for (std::size_t idx = 0; idx < COUNT; ++idx) {
+        BOOST_TEST_REQUIRE(RESULTS[idx], "record " << idx);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_batch_rejects_bad_arguments)
+{
+    std::array<char, 256> buffer{};
+
+    BOOST_TEST(cuid2_generate_batch(buffer.data(), 24, 4, 3) == CUID2_ERROR_INVALID_ARGUMENT);
+    BOOST_TEST(cuid2_generate_batch(buffer.data(), 40, 4, 33) == CUID2_ERROR_INVALID_ARGUMENT);
+    BOOST_TEST(cuid2_generate_batch(buffer.data(), 23, 4, 24) == CUID2_ERROR_INVALID_ARGUMENT);
+    BOOST_TEST(cuid2_generate_batch(nullptr, 24, 4, 24) == CUID2_ERROR_INVALID_ARGUMENT);
+
+    // An extent past SIZE_MAX is rejected before anything is written
+    BOOST_TEST(cuid2_generate_batch(buffer.data(), SIZE_MAX / 2, 3, 24) == CUID2_ERROR_INVALID_ARGUMENT);
+    BOOST_TEST(buffer[0] == '\0');
+
+    // An empty batch touches nothing, so a NULL buffer is allowed
+    BOOST_TEST(cuid2_generate_batch(nullptr, 24, 0, 24) == CUID2_OK);
+}
+
+BOOST_AUTO_TEST_CASE(test_runtime_errors_become_status_codes)
+{
+    std::array<char, 4 * CUID2_DEFAULT_LENGTH> buffer{};
+
+    {
+        const visus::cuid2::test::FailingSourceGuard GUARD;
+
+        BOOST_TEST(cuid2_generate_into(buffer.data(), CUID2_DEFAULT_LENGTH) == CUID2_ERROR_RUNTIME);
+        BOOST_TEST(cuid2_generate_batch(buffer.data(), CUID2_DEFAULT_LENGTH, 4, CUID2_DEFAULT_LENGTH) ==
+                   CUID2_ERROR_RUNTIME);
+    }
+
+    BOOST_TEST(cuid2_generate_into(buffer.data(), CUID2_DEFAULT_LENGTH) == CUID2_OK);
+}
+
+BOOST_AUTO_TEST_CASE(test_is_cuid2)
+{
+    const std::string ID = visus::cuid2::generate(16);
+
+    BOOST_TEST(cuid2_is_cuid2(ID.data(), ID.size(), 16) == 1);
+    BOOST_TEST(cuid2_is_cuid2(ID.data(), ID.size(), CUID2_ANY_LENGTH) == 1);
+    BOOST_TEST(cuid2_is_cuid2(ID.data(), ID.size(), 24) == 0);
+    BOOST_TEST(cuid2_is_cuid2("Abcd", 4, CUID2_ANY_LENGTH) == 0);
+    BOOST_TEST(cuid2_is_cuid2(nullptr, 0, CUID2_ANY_LENGTH) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_reseed_and_strerror)
+{
+    cuid2_reseed();
+
+    std::array<char, CUID2_DEFAULT_LENGTH> buffer{};
+    BOOST_TEST(cuid2_generate_into(buffer.data(), buffer.size()) == CUID2_OK);
+
+    const std::array<int, 6> STATUSES = {CUID2_OK, CUID2_ERROR_INVALID_ARGUMENT, CUID2_ERROR_RUNTIME,
+                                         CUID2_ERROR_OUT_OF_MEMORY, CUID2_ERROR_UNKNOWN, 42};
+
+    for (const int STATUS : STATUSES) {
+        const char* MESSAGE = cuid2_strerror(STATUS);
+
+        BOOST_TEST_REQUIRE(MESSAGE != static_cast<const char*>(nullptr));
+        BOOST_TEST(std::strlen(MESSAGE) > 0U);
+    }
+
+    BOOST_TEST(std::string_view(cuid2_strerror(42)) != std::string_view(cuid2_strerror(CUID2_ERROR_UNKNOWN)));
+}
+
+BOOST_AUTO_TEST_CASE(test_header_compiles_as_c)
+{
+    constexpr std::size_t COUNT = 8;
+    std::array<char, COUNT * (CUID2_DEFAULT_LENGTH + 1)> rows{};
+    rows.fill('#');
+
+    BOOST_TEST_REQUIRE(c_api_generate_rows(rows.data(), COUNT) == CUID2_OK);
+
+    for (std::size_t row = 0; row < COUNT; ++row) {
+        BOOST_TEST(c_api_is_cuid2(rows.data() + row * (CUID2_DEFAULT_LENGTH + 1)) == 1);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
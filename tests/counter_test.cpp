@@ -1,14 +1,22 @@
 #define BOOST_TEST_MODULE CounterTest
 
+#include <array>
 #include <atomic>
 #include <set>
+#include <stdexcept>
 #include <thread>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/unit_test_suite.hpp>
 
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 #include "cuid2/counter.hpp"
+#include "cuid2/platform.hpp"
 
 BOOST_AUTO_TEST_SUITE(CounterTests)
 
@@ -111,4 +119,291 @@ BOOST_AUTO_TEST_CASE(test_counter_concurrent_access_stability)
     BOOST_TEST(all_unique_values.size() == static_cast<size_t>(NUM_THREADS * ITERATIONS));
 }
 
+BOOST_AUTO_TEST_CASE(test_counter_reserve_contiguous_range)
+{
+    constexpr int64_t BLOCK_SIZE = 256;
+
+    const int64_t FIRST = visus::cuid2::Counter::reserve(BLOCK_SIZE);
+    const int64_t NEXT = visus::cuid2::Counter::next();
+
+    BOOST_TEST(NEXT == FIRST + BLOCK_SIZE);
+}
+
+BOOST_AUTO_TEST_CASE(test_counter_reserve_disjoint_across_threads)
+{
+    constexpr int NUM_THREADS = 10;
+    constexpr int RESERVATIONS_PER_THREAD = 100;
+    constexpr int64_t BLOCK_SIZE = 64;
+
+    std::vector<std::jthread> threads;
+    std::vector<std::vector<int64_t>> thread_values(NUM_THREADS);
+
+    threads.reserve(NUM_THREADS);
+
+    for (int thread_idx = 0; thread_idx < NUM_THREADS; ++thread_idx) {
+        threads.emplace_back([thread_idx, &thread_values]() {
+            for (int idx = 0; idx < RESERVATIONS_PER_THREAD; ++idx) {
+                const int64_t FIRST = visus::cuid2::Counter::reserve(BLOCK_SIZE);
+                for (int64_t offset = 0; offset < BLOCK_SIZE; ++offset) {
+                    thread_values[thread_idx].push_back(FIRST + offset);
+                }
+            }
+        });
+    }
+
+    // Explicitly join to ensure threads complete before accessing results
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::set<int64_t> all_values;
+    for (const auto& values : thread_values) {
+        all_values.insert(values.begin(), values.end());
+    }
+
+    BOOST_TEST(all_values.size() == static_cast<size_t>(NUM_THREADS * RESERVATIONS_PER_THREAD * BLOCK_SIZE));
+}
+
+BOOST_AUTO_TEST_CASE(test_counter_thread_blocks_unique_across_threads)
+{
+    constexpr int NUM_THREADS = 10;
+    constexpr int VALUES_PER_THREAD = 5000;
+    constexpr int64_t BLOCK_SIZE = 1024;
+
+    visus::cuid2::Counter::set_thread_block_size(BLOCK_SIZE);
+    BOOST_TEST(visus::cuid2::Counter::thread_block_size() == BLOCK_SIZE);
+
+    std::vector<std::jthread> threads;
+    std::vector<std::vector<int64_t>> thread_values(NUM_THREADS);
+
+    threads.reserve(NUM_THREADS);
+
+    for (int thread_idx = 0; thread_idx < NUM_THREADS; ++thread_idx) {
+        threads.emplace_back([thread_idx, &thread_values]() {
+            thread_values[thread_idx].reserve(VALUES_PER_THREAD);
+            for (int idx = 0; idx < VALUES_PER_THREAD; ++idx) {
+                thread_values[thread_idx].push_back(visus::cuid2::Counter::next());
+            }
+        });
+    }
+
+    // Explicitly join to ensure threads complete before accessing results
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    visus::cuid2::Counter::set_thread_block_size(1);
+
+    std::set<int64_t> all_values;
+    for (const auto& values : thread_values) {
+        all_values.insert(values.begin(), values.end());
+
+        // Values within one block are handed out sequentially
+        for (size_t idx = 1; idx < static_cast<size_t>(BLOCK_SIZE); ++idx) {
+            BOOST_TEST(values[idx] == values[idx - 1] + 1);
+        }
+    }
+
+    BOOST_TEST(all_values.size() == static_cast<size_t>(NUM_THREADS * VALUES_PER_THREAD));
+}
+
+BOOST_AUTO_TEST_CASE(test_counter_thread_blocks_disjoint_from_shared_values)
+{
+    constexpr int64_t BLOCK_SIZE = 512;
+
+    std::set<int64_t> values;
+
+    visus::cuid2::Counter::set_thread_block_size(BLOCK_SIZE);
+
+    // A worker reserves a block and leaves most of it unused
+    std::jthread worker([&values]() {
+        values.insert(visus::cuid2::Counter::next());
+    });
+    worker.join();
+
+    visus::cuid2::Counter::set_thread_block_size(1);
+
+    // Shared increments resume after the reserved block
+    for (int idx = 0; idx < 1000; ++idx) {
+        values.insert(visus::cuid2::Counter::next());
+    }
+
+    BOOST_TEST(values.size() == 1001U);
+}
+
+BOOST_AUTO_TEST_CASE(test_counter_thread_block_size_invalid)
+{
+    BOOST_CHECK_THROW(visus::cuid2::Counter::set_thread_block_size(0), std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::Counter::set_thread_block_size(-1), std::invalid_argument);
+    BOOST_TEST(visus::cuid2::Counter::thread_block_size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_counter_new_generation_jumps)
+{
+    const int64_t BEFORE = visus::cuid2::Counter::next();
+
+    visus::cuid2::platform::start_new_generation();
+
+    const int64_t AFTER = visus::cuid2::Counter::next();
+    BOOST_TEST(AFTER != BEFORE + 1);
+    BOOST_TEST(visus::cuid2::Counter::next() == AFTER + 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_counter_new_generation_discards_thread_block)
+{
+    visus::cuid2::Counter::set_thread_block_size(1024);
+
+    const int64_t FIRST = visus::cuid2::Counter::next();
+    BOOST_TEST(visus::cuid2::Counter::next() == FIRST + 1);
+
+    // The unused rest of the block belongs to the old generation
+    visus::cuid2::platform::start_new_generation();
+
+    const int64_t AFTER = visus::cuid2::Counter::next();
+    BOOST_TEST(AFTER != FIRST + 2);
+    BOOST_TEST(visus::cuid2::Counter::next() == AFTER + 1);
+
+    visus::cuid2::Counter::set_thread_block_size(1);
+}
+
+BOOST_AUTO_TEST_CASE(test_counter_numa_partitions_unique_across_threads)
+{
+    constexpr int NUM_THREADS = 10;
+    constexpr int VALUES_PER_THREAD = 5000;
+
+    visus::cuid2::Counter::set_numa_partitioned(true);
+    BOOST_TEST(visus::cuid2::Counter::numa_partitioned());
+
+    std::vector<std::jthread> threads;
+    std::vector<std::vector<int64_t>> thread_values(NUM_THREADS);
+
+    threads.reserve(NUM_THREADS);
+
+    for (int thread_idx = 0; thread_idx < NUM_THREADS; ++thread_idx) {
+        threads.emplace_back([thread_idx, &thread_values]() {
+            thread_values[thread_idx].reserve(VALUES_PER_THREAD);
+            for (int idx = 0; idx < VALUES_PER_THREAD; ++idx) {
+                // Mix single values and ranges drawn from the same partition
+                if (idx % 100 == 0) {
+                    const int64_t FIRST = visus::cuid2::Counter::reserve(4);
+                    for (int64_t offset = 0; offset < 4; ++offset) {
+                        thread_values[thread_idx].push_back(FIRST + offset);
+                    }
+                } else {
+                    thread_values[thread_idx].push_back(visus::cuid2::Counter::next());
+                }
+            }
+        });
+    }
+
+    // Explicitly join to ensure threads complete before accessing results
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    visus::cuid2::Counter::set_numa_partitioned(false);
+
+    std::set<int64_t> all_values;
+    size_t total_count = 0;
+
+    for (const auto& values : thread_values) {
+        total_count += values.size();
+        all_values.insert(values.begin(), values.end());
+    }
+
+    BOOST_TEST(all_values.size() == total_count);
+}
+
+BOOST_AUTO_TEST_CASE(test_counter_numa_partition_contiguous_within_thread)
+{
+    int64_t first = 0;
+    int64_t next = 0;
+
+    visus::cuid2::Counter::set_numa_partitioned(true);
+
+    // A new thread queries its node once and keeps using that partition
+    std::jthread worker([&first, &next]() {
+        first = visus::cuid2::Counter::reserve(256);
+        next = visus::cuid2::Counter::next();
+    });
+    worker.join();
+
+    visus::cuid2::Counter::set_numa_partitioned(false);
+
+    BOOST_TEST(next == first + 256);
+}
+
+BOOST_AUTO_TEST_CASE(test_counter_numa_partitions_disjoint_from_shared_values)
+{
+    std::set<int64_t> values;
+
+    for (int round = 0; round < 3; ++round) {
+        visus::cuid2::Counter::set_numa_partitioned(true);
+        for (int idx = 0; idx < 500; ++idx) {
+            values.insert(visus::cuid2::Counter::next());
+        }
+
+        // A request larger than a partition goes to the shared value
+        values.insert(visus::cuid2::Counter::reserve((int64_t{1} << 40) + 1));
+
+        visus::cuid2::Counter::set_numa_partitioned(false);
+        for (int idx = 0; idx < 500; ++idx) {
+            values.insert(visus::cuid2::Counter::next());
+        }
+    }
+
+    BOOST_TEST(values.size() == 3003U);
+}
+
+BOOST_AUTO_TEST_CASE(test_counter_numa_partition_replaced_in_new_generation)
+{
+    visus::cuid2::Counter::set_numa_partitioned(true);
+
+    const int64_t BEFORE = visus::cuid2::Counter::next();
+    BOOST_TEST(visus::cuid2::Counter::next() == BEFORE + 1);
+
+    visus::cuid2::platform::start_new_generation();
+
+    const int64_t AFTER = visus::cuid2::Counter::next();
+    BOOST_TEST(AFTER != BEFORE + 2);
+    BOOST_TEST(visus::cuid2::Counter::next() == AFTER + 1);
+
+    visus::cuid2::Counter::set_numa_partitioned(false);
+}
+
+#ifndef _WIN32
+BOOST_AUTO_TEST_CASE(test_counter_diverges_after_fork)
+{
+    static_cast<void>(visus::cuid2::Counter::next());
+
+    std::array<int, 2> pipe_fds{};
+    BOOST_REQUIRE(pipe(pipe_fds.data()) == 0);
+
+    const pid_t PID = fork();
+    BOOST_REQUIRE(PID >= 0);
+
+    if (PID == 0) {
+        const int64_t CHILD_VALUE = visus::cuid2::Counter::next();
+        const bool WRITTEN = write(pipe_fds[1], &CHILD_VALUE, sizeof(CHILD_VALUE)) ==
+                             static_cast<ssize_t>(sizeof(CHILD_VALUE));
+        _exit(WRITTEN ? 0 : 1);
+    }
+
+    close(pipe_fds[1]);
+
+    const int64_t PARENT_VALUE = visus::cuid2::Counter::next();
+
+    int64_t child_value = 0;
+    const ssize_t READ = read(pipe_fds[0], &child_value, sizeof(child_value));
+    close(pipe_fds[0]);
+
+    int status = 0;
+    waitpid(PID, &status, 0);
+
+    BOOST_REQUIRE(READ == static_cast<ssize_t>(sizeof(child_value)));
+    BOOST_TEST(WIFEXITED(status));
+    BOOST_TEST(child_value != PARENT_VALUE);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
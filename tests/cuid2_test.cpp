@@ -2,8 +2,14 @@
 #define BOOST_TEST_DYN_LINK
 
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <memory_resource>
 #include <set>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <span>
 #include <string>
 #include <thread>
 #include <vector>
@@ -12,6 +18,8 @@
 #include <boost/test/unit_test_suite.hpp>
 
 #include "cuid2/cuid2.hpp"
+#include "cuid2/fingerprint.hpp"
+#include "cuid2/generator.hpp"
 
 BOOST_AUTO_TEST_SUITE(Cuid2Tests)
 
@@ -273,6 +281,22 @@ BOOST_AUTO_TEST_CASE(test_rapid_generation_no_duplicates)
     BOOST_TEST(unique_ids.size() == ids.size());
 }
 
+BOOST_AUTO_TEST_CASE(test_reseed_no_duplicates)
+{
+    std::set<std::string> ids;
+
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 1000; ++i) {
+            ids.insert(visus::cuid2::generate());
+        }
+
+        visus::cuid2::reseed();
+    }
+
+    BOOST_TEST(ids.size() == 10000U);
+    BOOST_TEST(std::ranges::all_of(ids, [](const std::string& id) { return visus::cuid2::is_cuid2(id, 24); }));
+}
+
 BOOST_AUTO_TEST_CASE(test_multiple_lengths_concurrent)
 {
     constexpr int NUM_THREADS = 5;
@@ -322,4 +346,291 @@ BOOST_AUTO_TEST_CASE(test_short_ids_have_higher_collision_rate)
     BOOST_TEST(ids.size() >= 150U);
 }
 
+BOOST_AUTO_TEST_CASE(test_generate_batch_format)
+{
+    for (int length = visus::cuid2::MIN_CUID2_LENGTH; length <= visus::cuid2::MAX_CUID2_LENGTH; ++length) {
+        const auto IDS = visus::cuid2::generate_batch(50, length);
+
+        BOOST_TEST(IDS.size() == 50U);
+        for (const auto& id : IDS) {
+            BOOST_TEST(is_valid_cuid2_format(id, length));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_batch_uniqueness)
+{
+    constexpr size_t BATCH_SIZE = 10000;
+
+    const auto IDS = visus::cuid2::generate_batch(BATCH_SIZE);
+    const std::set<std::string> UNIQUE_IDS(IDS.begin(), IDS.end());
+
+    BOOST_TEST(UNIQUE_IDS.size() == BATCH_SIZE);
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_batch_overwrites_span)
+{
+    std::vector<std::string> ids(300, "stale");
+
+    visus::cuid2::generate_batch(std::span<std::string>(ids).subspan(100, 100), 16);
+
+    for (size_t idx = 0; idx < ids.size(); ++idx) {
+        if (idx >= 100 && idx < 200) {
+            BOOST_TEST(is_valid_cuid2_format(ids[idx], 16));
+        } else {
+            BOOST_TEST(ids[idx] == "stale");
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_batch_empty)
+{
+    std::vector<std::string> ids;
+
+    BOOST_CHECK_NO_THROW(visus::cuid2::generate_batch(std::span<std::string>(ids)));
+    BOOST_TEST(visus::cuid2::generate_batch(0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_batch_invalid_length)
+{
+    std::vector<std::string> ids(4);
+
+    BOOST_CHECK_THROW(visus::cuid2::generate_batch(std::span<std::string>(ids), 3), std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::generate_batch(std::span<std::string>(ids), 33), std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::generate_batch(4, 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_batch_concurrent)
+{
+    constexpr int NUM_THREADS = 8;
+    constexpr size_t IDS_PER_THREAD = 2000;
+
+    std::vector<std::jthread> threads;
+    std::vector<std::vector<std::string>> thread_ids(NUM_THREADS);
+
+    threads.reserve(NUM_THREADS);
+
+    for (int thread_idx = 0; thread_idx < NUM_THREADS; ++thread_idx) {
+        threads.emplace_back([thread_idx, &thread_ids]() {
+            thread_ids[thread_idx] = visus::cuid2::generate_batch(IDS_PER_THREAD);
+        });
+    }
+
+    // Explicitly join to ensure threads complete before accessing results
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::set<std::string> all_ids;
+    for (const auto& ids : thread_ids) {
+        all_ids.insert(ids.begin(), ids.end());
+        all_ids.insert(visus::cuid2::generate());
+    }
+
+    BOOST_TEST(all_ids.size() == (NUM_THREADS * IDS_PER_THREAD) + NUM_THREADS);
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_into_all_valid_lengths)
+{
+    for (int length = visus::cuid2::MIN_CUID2_LENGTH; length <= visus::cuid2::MAX_CUID2_LENGTH; ++length) {
+        std::array<char, visus::cuid2::MAX_CUID2_LENGTH + 1> buffer{};
+        buffer.fill('#');
+
+        const size_t WRITTEN = visus::cuid2::generate_into(buffer.data(), static_cast<size_t>(length));
+
+        BOOST_TEST(WRITTEN == static_cast<size_t>(length));
+        BOOST_TEST(is_valid_cuid2_format(std::string(buffer.data(), WRITTEN), length));
+        BOOST_TEST(std::all_of(buffer.begin() + length, buffer.end(), [](const char chr) { return chr == '#'; }));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_into_span)
+{
+    std::array<char, visus::cuid2::DEFAULT_LENGTH> buffer{};
+
+    const size_t WRITTEN = visus::cuid2::generate_into(buffer);
+
+    BOOST_TEST(WRITTEN == buffer.size());
+    BOOST_TEST(is_valid_cuid2_format(std::string(buffer.begin(), buffer.end()), buffer.size()));
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_into_invalid_length)
+{
+    std::array<char, 64> buffer{};
+
+    BOOST_CHECK_THROW(visus::cuid2::generate_into(buffer.data(), 0), std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::generate_into(buffer.data(), 3), std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::generate_into(buffer.data(), 33), std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::generate_into(buffer), std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::generate_into(std::span<char>(buffer).first(2)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_into_uniqueness)
+{
+    constexpr size_t COUNT = 10000;
+
+    std::vector<char> rows(COUNT * visus::cuid2::DEFAULT_LENGTH);
+    for (size_t row = 0; row < COUNT; ++row) {
+        visus::cuid2::generate_into(rows.data() + (row * visus::cuid2::DEFAULT_LENGTH), visus::cuid2::DEFAULT_LENGTH);
+    }
+
+    std::set<std::string> unique_ids;
+    for (size_t row = 0; row < COUNT; ++row) {
+        unique_ids.emplace(rows.data() + (row * visus::cuid2::DEFAULT_LENGTH), visus::cuid2::DEFAULT_LENGTH);
+    }
+
+    BOOST_TEST(unique_ids.size() == COUNT);
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_pmr_uses_resource)
+{
+    // An arena with no upstream throws std::bad_alloc rather than falling
+    // back to the global heap
+    std::array<std::byte, 1024> storage{};
+    std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size(), std::pmr::null_memory_resource());
+
+    for (int length = visus::cuid2::MIN_CUID2_LENGTH; length <= visus::cuid2::MAX_CUID2_LENGTH; ++length) {
+        const std::pmr::string ID = visus::cuid2::generate(&arena, length);
+
+        BOOST_TEST(ID.get_allocator().resource() == &arena);
+        BOOST_TEST(is_valid_cuid2_format(std::string(ID), static_cast<size_t>(length)));
+    }
+
+    const std::pmr::string DEFAULT_ID = visus::cuid2::generate(&arena);
+    BOOST_TEST(DEFAULT_ID.size() == static_cast<size_t>(visus::cuid2::DEFAULT_LENGTH));
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_batch_pmr_uses_resource)
+{
+    constexpr size_t COUNT = 500;
+
+    std::vector<std::byte> storage(COUNT * 128);
+    std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size(), std::pmr::null_memory_resource());
+
+    const std::pmr::vector<std::pmr::string> IDS = visus::cuid2::generate_batch(COUNT, &arena, 32);
+
+    BOOST_TEST(IDS.size() == COUNT);
+    BOOST_TEST(IDS.get_allocator().resource() == &arena);
+
+    std::set<std::string> unique_ids;
+    for (const auto& ID : IDS) {
+        BOOST_TEST_REQUIRE(ID.get_allocator().resource() == &arena);
+        BOOST_TEST_REQUIRE(is_valid_cuid2_format(std::string(ID), 32));
+        unique_ids.emplace(ID);
+    }
+
+    BOOST_TEST(unique_ids.size() == COUNT);
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_batch_pmr_span_reuses_strings)
+{
+    std::pmr::unsynchronized_pool_resource pool;
+    std::pmr::vector<std::pmr::string> ids(16, &pool);
+
+    visus::cuid2::generate_batch(std::span<std::pmr::string>(ids), 20);
+    for (const auto& ID : ids) {
+        BOOST_TEST(is_valid_cuid2_format(std::string(ID), 20));
+    }
+
+    // Regenerating shorter identifiers keeps the strings' storage
+    const char* const FIRST_DATA = ids.front().data();
+    visus::cuid2::generate_batch(std::span<std::pmr::string>(ids), 18);
+
+    BOOST_TEST(ids.front().data() == FIRST_DATA);
+    BOOST_TEST(is_valid_cuid2_format(std::string(ids.front()), 18));
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_pmr_invalid_arguments)
+{
+    std::pmr::monotonic_buffer_resource arena;
+
+    BOOST_CHECK_THROW(static_cast<void>(visus::cuid2::generate(nullptr)), std::invalid_argument);
+    BOOST_CHECK_THROW(static_cast<void>(visus::cuid2::generate(&arena, 3)), std::invalid_argument);
+    BOOST_CHECK_THROW(static_cast<void>(visus::cuid2::generate_batch(4, nullptr)), std::invalid_argument);
+    BOOST_CHECK_THROW(static_cast<void>(visus::cuid2::generate_batch(4, &arena, 33)), std::invalid_argument);
+
+    visus::cuid2::Generator generator({.length = 12});
+    BOOST_CHECK_THROW(static_cast<void>(generator.next(nullptr)), std::invalid_argument);
+
+    const std::pmr::string ID = generator.next(&arena);
+    BOOST_TEST(ID.get_allocator().resource() == &arena);
+    BOOST_TEST(is_valid_cuid2_format(std::string(ID), 12));
+}
+
+namespace {
+    template <int N>
+    concept can_generate_fixed = requires { visus::cuid2::generate<N>(); };
+} // anonymous namespace
+
+static_assert(can_generate_fixed<visus::cuid2::MIN_CUID2_LENGTH>);
+static_assert(can_generate_fixed<visus::cuid2::MAX_CUID2_LENGTH>);
+static_assert(!can_generate_fixed<visus::cuid2::MIN_CUID2_LENGTH - 1>);
+static_assert(!can_generate_fixed<visus::cuid2::MAX_CUID2_LENGTH + 1>);
+static_assert(sizeof(visus::cuid2::id<24>) == 24);
+static_assert(std::is_trivially_copyable_v<visus::cuid2::id<24>>);
+
+BOOST_AUTO_TEST_CASE(test_generate_fixed_length)
+{
+    const auto SHORT_ID = visus::cuid2::generate<visus::cuid2::MIN_CUID2_LENGTH>();
+    const auto DEFAULT_ID = visus::cuid2::generate<visus::cuid2::DEFAULT_LENGTH>();
+    const auto LONG_ID = visus::cuid2::generate<visus::cuid2::MAX_CUID2_LENGTH>();
+
+    for (const std::string_view ID : {SHORT_ID.view(), DEFAULT_ID.view(), LONG_ID.view()}) {
+        BOOST_TEST(is_lowercase_letter(ID.front()));
+        BOOST_TEST(std::ranges::all_of(ID, is_base36_char));
+    }
+
+    BOOST_TEST(SHORT_ID.view().size() == 4U);
+    BOOST_TEST(DEFAULT_ID.view().size() == 24U);
+    BOOST_TEST(LONG_ID.view().size() == 32U);
+}
+
+BOOST_AUTO_TEST_CASE(test_generate_fixed_uniqueness)
+{
+    constexpr int COUNT = 10000;
+    std::unordered_set<visus::cuid2::id<24>> ids;
+
+    for (int idx = 0; idx < COUNT; ++idx) {
+        ids.insert(visus::cuid2::generate<24>());
+    }
+
+    BOOST_TEST(ids.size() == static_cast<size_t>(COUNT));
+}
+
+BOOST_AUTO_TEST_CASE(test_fixed_id_value_semantics)
+{
+    const auto ID = visus::cuid2::generate<16>();
+    const visus::cuid2::id<16> COPY = ID;
+    const std::string_view VIEW = ID;
+
+    BOOST_TEST(COPY == ID);
+    BOOST_TEST(VIEW == ID.str());
+    BOOST_TEST(std::string(ID.begin(), ID.end()) == ID.str());
+    BOOST_TEST((visus::cuid2::id<16>() < ID));
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_next_id)
+{
+    visus::cuid2::Generator generator(visus::cuid2::GeneratorOptions{.length = 8});
+
+    const auto ID = generator.next_id<32>();
+
+    BOOST_TEST(ID.view().size() == 32U);
+    BOOST_TEST(is_lowercase_letter(ID.view().front()));
+    BOOST_TEST(std::ranges::all_of(ID.view(), is_base36_char));
+    BOOST_TEST(generator.next().size() == 8U);
+}
+
+BOOST_AUTO_TEST_CASE(test_backend_info)
+{
+    const auto INFO = visus::cuid2::backend_info();
+
+    BOOST_TEST(INFO.crypto_library.find("OpenSSL") != std::string::npos);
+    BOOST_TEST(!INFO.hash_backend.empty());
+    BOOST_TEST(!INFO.batch_hash_backend.empty());
+    BOOST_TEST(!INFO.random_backend.empty());
+    BOOST_TEST(!INFO.validation_backend.empty());
+    BOOST_TEST(INFO.fingerprint_size == visus::cuid2::Fingerprint::get().size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
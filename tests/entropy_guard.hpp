@@ -0,0 +1,52 @@
+/// @file entropy_guard.hpp
+/// @brief Entropy source helpers shared by the unit tests
+///
+/// Tests that replace the process-wide entropy source use these guards, so the
+/// default source is restored when the test case ends even if a check fails.
+
+#ifndef LIBCUID2_TESTS_ENTROPY_GUARD_HPP
+#define LIBCUID2_TESTS_ENTROPY_GUARD_HPP
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+#include "cuid2/platform.hpp"
+
+namespace visus::cuid2::test {
+    /// Entropy source whose every request fails.
+    class FailingSource final : public platform::EntropySource {
+    public:
+        void fill(std::span<uint8_t> /*out*/) override {
+            throw std::runtime_error("no entropy");
+        }
+
+        [[nodiscard]] std::string_view name() const noexcept override {
+            return "failing";
+        }
+    };
+
+    /// Restores the default source when it goes out of scope.
+    class DefaultSourceGuard {
+    public:
+        DefaultSourceGuard() = default;
+        DefaultSourceGuard(const DefaultSourceGuard&) = delete;
+        DefaultSourceGuard& operator=(const DefaultSourceGuard&) = delete;
+
+        ~DefaultSourceGuard() {
+            platform::set_entropy_source(platform::EntropyBackend::openssl);
+        }
+    };
+
+    /// Installs a FailingSource for every thread until it goes out of scope.
+    class FailingSourceGuard : public DefaultSourceGuard {
+    public:
+        FailingSourceGuard() {
+            platform::set_entropy_source([] { return std::make_unique<FailingSource>(); });
+        }
+    };
+} // namespace visus::cuid2::test
+
+#endif // LIBCUID2_TESTS_ENTROPY_GUARD_HPP
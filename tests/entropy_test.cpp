@@ -0,0 +1,219 @@
+#define BOOST_TEST_MODULE EntropyTest
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+
+#include "cuid2/platform.hpp"
+#include "entropy_guard.hpp"
+
+namespace {
+    using visus::cuid2::platform::EntropyBackend;
+    using visus::cuid2::test::DefaultSourceGuard;
+
+    constexpr std::array<EntropyBackend, 4> ALL_BACKENDS = {
+        EntropyBackend::openssl, EntropyBackend::system, EntropyBackend::chacha20, EntropyBackend::aes_ctr};
+
+    using Seed = std::array<uint8_t, visus::cuid2::platform::ENTROPY_SEED_SIZE>;
+
+    /// Draws COUNT bytes from a source in requests of CHUNK bytes.
+    std::vector<uint8_t> draw(visus::cuid2::platform::EntropySource& source, const size_t COUNT, const size_t CHUNK) {
+        std::vector<uint8_t> result(COUNT);
+
+        for (size_t offset = 0; offset < COUNT; offset += CHUNK) {
+            source.fill(std::span<uint8_t>(result).subspan(offset, std::min(CHUNK, COUNT - offset)));
+        }
+
+        return result;
+    }
+
+    /// Draws COUNT bytes through get_random_bytes() in 16-byte requests.
+    std::vector<uint8_t> draw_pooled(const size_t COUNT) {
+        std::vector<uint8_t> result(COUNT);
+
+        for (size_t offset = 0; offset < COUNT; offset += 16) {
+            visus::cuid2::platform::get_random_bytes(result.data() + offset, 16);
+        }
+
+        return result;
+    }
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(EntropyTests)
+
+BOOST_AUTO_TEST_CASE(test_backends_fill_varied_bytes)
+{
+    for (const EntropyBackend BACKEND : ALL_BACKENDS) {
+        const auto SOURCE = visus::cuid2::platform::make_entropy_source(BACKEND);
+
+        BOOST_TEST_CONTEXT("backend " << SOURCE->name()) {
+            BOOST_TEST(!SOURCE->name().empty());
+
+            std::set<std::array<uint8_t, 16>> values;
+            for (int idx = 0; idx < 256; ++idx) {
+                std::array<uint8_t, 16> buffer{};
+                SOURCE->fill(buffer);
+                values.insert(buffer);
+            }
+            BOOST_TEST(values.size() == 256U);
+
+            // Large and empty requests
+            std::vector<uint8_t> large(256 * 1024);
+            SOURCE->fill(large);
+            BOOST_TEST(std::count(large.begin(), large.end(), 0) < 2048);
+            BOOST_CHECK_NO_THROW(SOURCE->fill(std::span<uint8_t>()));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_drbg_reseeds_past_interval)
+{
+    // Crossing the reseed interval must neither fail nor repeat output
+    const auto SOURCE = visus::cuid2::platform::make_entropy_source(EntropyBackend::chacha20);
+    constexpr size_t CHUNK = 64 * 1024;
+
+    std::set<std::vector<uint8_t>> chunks;
+    for (size_t total = 0; total < 3 * visus::cuid2::platform::ENTROPY_RESEED_INTERVAL; total += CHUNK) {
+        chunks.insert(draw(*SOURCE, CHUNK, CHUNK));
+    }
+
+    BOOST_TEST(chunks.size() == 3 * visus::cuid2::platform::ENTROPY_RESEED_INTERVAL / CHUNK);
+}
+
+BOOST_AUTO_TEST_CASE(test_seeded_sources_known_answer)
+{
+    const Seed ZERO_KEY{};
+
+    // RFC 7539 section 2.3.2 and FIPS-197 keystream for an all-zero key and IV
+    const std::array<uint8_t, 16> CHACHA20_EXPECTED = {
+        0x76, 0xb8, 0xe0, 0xad, 0xa0, 0xf1, 0x3d, 0x90, 0x40, 0x5d, 0x6a, 0xe5, 0x53, 0x86, 0xbd, 0x28};
+    const std::array<uint8_t, 16> AES_EXPECTED = {
+        0xdc, 0x95, 0xc0, 0x78, 0xa2, 0x40, 0x89, 0x89, 0xad, 0x48, 0xa2, 0x14, 0x92, 0x84, 0x20, 0x87};
+
+    std::array<uint8_t, 16> actual{};
+
+    visus::cuid2::platform::make_seeded_entropy_source(EntropyBackend::chacha20, ZERO_KEY)->fill(actual);
+    BOOST_TEST(actual == CHACHA20_EXPECTED);
+
+    visus::cuid2::platform::make_seeded_entropy_source(EntropyBackend::aes_ctr, ZERO_KEY)->fill(actual);
+    BOOST_TEST(actual == AES_EXPECTED);
+}
+
+BOOST_AUTO_TEST_CASE(test_seeded_sources_are_deterministic)
+{
+    Seed seed{};
+    std::iota(seed.begin(), seed.end(), uint8_t{1});
+
+    for (const EntropyBackend BACKEND : {EntropyBackend::chacha20, EntropyBackend::aes_ctr}) {
+        const auto FIRST = visus::cuid2::platform::make_seeded_entropy_source(BACKEND, seed);
+        const auto SECOND = visus::cuid2::platform::make_seeded_entropy_source(BACKEND, seed);
+
+        BOOST_TEST_CONTEXT("backend " << FIRST->name()) {
+            const auto EXPECTED = draw(*FIRST, 4096, 100);
+            BOOST_TEST(draw(*SECOND, 4096, 100) == EXPECTED);
+
+            // Keys are erased after every request, so the output depends on
+            // how the stream was requested, and never repeats
+            const auto THIRD = visus::cuid2::platform::make_seeded_entropy_source(BACKEND, seed);
+            BOOST_TEST(draw(*THIRD, 4096, 4096) != EXPECTED);
+            BOOST_TEST(draw(*FIRST, 4096, 100) != EXPECTED);
+
+            Seed other = seed;
+            other[0] ^= 1;
+            const auto OTHER = visus::cuid2::platform::make_seeded_entropy_source(BACKEND, other);
+            BOOST_TEST(draw(*OTHER, 4096, 100) != EXPECTED);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_seeded_source_rejects_bad_arguments)
+{
+    const Seed SEED{};
+    const std::array<uint8_t, 16> SHORT_SEED{};
+
+    BOOST_CHECK_THROW(static_cast<void>(visus::cuid2::platform::make_seeded_entropy_source(EntropyBackend::openssl, SEED)),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(static_cast<void>(visus::cuid2::platform::make_seeded_entropy_source(EntropyBackend::system, SEED)),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(
+        static_cast<void>(visus::cuid2::platform::make_seeded_entropy_source(EntropyBackend::chacha20, SHORT_SEED)),
+        std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_set_entropy_source_selects_backend)
+{
+    const DefaultSourceGuard GUARD;
+
+    BOOST_TEST(visus::cuid2::platform::entropy_source_name() == "OpenSSL RAND_bytes");
+
+    for (const EntropyBackend BACKEND : ALL_BACKENDS) {
+        visus::cuid2::platform::set_entropy_source(BACKEND);
+
+        const std::string EXPECTED(visus::cuid2::platform::make_entropy_source(BACKEND)->name());
+        BOOST_TEST(visus::cuid2::platform::entropy_source_name() == EXPECTED);
+
+        std::set<std::array<uint8_t, 16>> values;
+        for (int idx = 0; idx < 1024; ++idx) {
+            std::array<uint8_t, 16> buffer{};
+            visus::cuid2::platform::get_random_bytes(buffer.data(), buffer.size());
+            values.insert(buffer);
+        }
+        BOOST_TEST(values.size() == 1024U);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_seeded_factory_replays)
+{
+    const DefaultSourceGuard GUARD;
+
+    Seed seed{};
+    seed.fill(0x5a);
+
+    const auto FACTORY = [seed] {
+        return visus::cuid2::platform::make_seeded_entropy_source(EntropyBackend::chacha20, seed);
+    };
+
+    // Selecting the factory again restarts every thread's stream
+    visus::cuid2::platform::set_entropy_source(FACTORY);
+    const auto FIRST = draw_pooled(8192);
+
+    visus::cuid2::platform::set_entropy_source(FACTORY);
+    BOOST_TEST(draw_pooled(8192) == FIRST);
+
+    // A new process generation also replaces the thread's source
+    visus::cuid2::platform::start_new_generation();
+    BOOST_TEST(draw_pooled(8192) == FIRST);
+
+    BOOST_TEST(draw_pooled(8192) != FIRST);
+}
+
+BOOST_AUTO_TEST_CASE(test_custom_source_errors_propagate)
+{
+    const visus::cuid2::test::FailingSourceGuard GUARD;
+
+    std::array<unsigned char, 16> buffer{};
+
+    BOOST_CHECK_THROW(visus::cuid2::platform::get_random_bytes(buffer.data(), buffer.size()), std::runtime_error);
+    BOOST_CHECK_THROW(static_cast<void>(visus::cuid2::platform::get_random_int64()), std::runtime_error);
+
+    visus::cuid2::platform::set_entropy_source([] { return std::unique_ptr<visus::cuid2::platform::EntropySource>(); });
+    BOOST_CHECK_THROW(visus::cuid2::platform::get_random_bytes(buffer.data(), buffer.size()), std::runtime_error);
+
+    // An empty factory restores the default
+    visus::cuid2::platform::set_entropy_source(visus::cuid2::platform::EntropyFactory());
+    BOOST_CHECK_NO_THROW(visus::cuid2::platform::get_random_bytes(buffer.data(), buffer.size()));
+    BOOST_TEST(visus::cuid2::platform::entropy_source_name() == "OpenSSL RAND_bytes");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
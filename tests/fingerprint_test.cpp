@@ -1,15 +1,25 @@
 #define BOOST_TEST_MODULE FingerprintTest
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cstdint>
 #include <set>
+#include <string>
 #include <thread>
 #include <vector>
 
+#include <boost/endian/conversion.hpp>
 #include <boost/test/unit_test.hpp>
 #include <boost/test/unit_test_suite.hpp>
 
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 #include "cuid2/fingerprint.hpp"
+#include "cuid2/hash.hpp"
 #include "cuid2/platform.hpp"
 
 BOOST_AUTO_TEST_SUITE(FingerprintTests)
@@ -156,4 +166,101 @@ BOOST_AUTO_TEST_CASE(test_fingerprint_deterministic_structure)
     BOOST_TEST(std::equal(ACTUAL.begin(), ACTUAL.end(), expected.begin(), expected.end()));
 }
 
+BOOST_AUTO_TEST_CASE(test_fingerprint_digest_matches_bytes)
+{
+    const auto& FINGERPRINT = visus::cuid2::Fingerprint::get();
+    const auto& DIGEST = visus::cuid2::Fingerprint::digest();
+
+    visus::cuid2::HashContext context;
+
+    BOOST_TEST(DIGEST == context.hash(FINGERPRINT));
+    BOOST_TEST(&DIGEST == &visus::cuid2::Fingerprint::digest());
+}
+
+BOOST_AUTO_TEST_CASE(test_fingerprint_new_generation_keeps_bytes)
+{
+    const auto& BEFORE = visus::cuid2::Fingerprint::get();
+    const auto BEFORE_DIGEST = visus::cuid2::Fingerprint::digest();
+
+    visus::cuid2::platform::start_new_generation();
+
+    // Same process, so the refreshed version has the same contents, and the
+    // old reference is still valid
+    const auto& AFTER = visus::cuid2::Fingerprint::get();
+    BOOST_TEST(&AFTER != &BEFORE);
+    BOOST_TEST(AFTER == BEFORE);
+    BOOST_TEST(visus::cuid2::Fingerprint::digest() == BEFORE_DIGEST);
+    BOOST_TEST(&visus::cuid2::Fingerprint::get() == &AFTER);
+}
+
+BOOST_AUTO_TEST_CASE(test_fingerprint_node_id_replaces_host_and_environment)
+{
+    const auto DEFAULT_DIGEST = visus::cuid2::Fingerprint::digest();
+
+    visus::cuid2::Fingerprint::set_node_id("pod-7f3c9a1e");
+
+    // The node identifier followed by the little-endian process ID
+    const std::string NODE_ID = "pod-7f3c9a1e";
+    std::vector<uint8_t> expected(NODE_ID.begin(), NODE_ID.end());
+    const auto PID = boost::endian::native_to_little(static_cast<uint32_t>(visus::cuid2::platform::get_process_id()));
+    const auto PID_BYTES = std::bit_cast<std::array<uint8_t, sizeof(uint32_t)>>(PID);
+    expected.insert(expected.end(), PID_BYTES.begin(), PID_BYTES.end());
+
+    visus::cuid2::HashContext context;
+    BOOST_TEST(visus::cuid2::Fingerprint::get() == expected);
+    BOOST_TEST(visus::cuid2::Fingerprint::digest() == context.hash(expected));
+
+    // A new generation patches the process ID at the node identifier's offset
+    visus::cuid2::platform::start_new_generation();
+    BOOST_TEST(visus::cuid2::Fingerprint::get() == expected);
+
+    // An empty node identifier restores the default fingerprint
+    visus::cuid2::Fingerprint::set_node_id("");
+    BOOST_TEST(visus::cuid2::Fingerprint::digest() == DEFAULT_DIGEST);
+}
+
+#ifndef _WIN32
+BOOST_AUTO_TEST_CASE(test_fingerprint_child_patches_process_id)
+{
+    const std::vector<uint8_t> PARENT_BYTES = visus::cuid2::Fingerprint::get();
+    const auto PARENT_DIGEST = visus::cuid2::Fingerprint::digest();
+
+    std::array<int, 2> pipe_fds{};
+    BOOST_REQUIRE(pipe(pipe_fds.data()) == 0);
+
+    const pid_t PID = fork();
+    BOOST_REQUIRE(PID >= 0);
+
+    if (PID == 0) {
+        const auto& CHILD_DIGEST = visus::cuid2::Fingerprint::digest();
+        const bool WRITTEN = write(pipe_fds[1], CHILD_DIGEST.data(), CHILD_DIGEST.size()) ==
+                             static_cast<ssize_t>(CHILD_DIGEST.size());
+        _exit(WRITTEN ? 0 : 1);
+    }
+
+    close(pipe_fds[1]);
+
+    visus::cuid2::utils::Digest child_digest{};
+    const ssize_t READ = read(pipe_fds[0], child_digest.data(), child_digest.size());
+    close(pipe_fds[0]);
+
+    int status = 0;
+    waitpid(PID, &status, 0);
+
+    BOOST_REQUIRE(READ == static_cast<ssize_t>(child_digest.size()));
+    BOOST_TEST(WIFEXITED(status));
+
+    // The child's fingerprint is the parent's with only the process ID replaced
+    std::vector<uint8_t> expected = PARENT_BYTES;
+    const auto CHILD_PID = boost::endian::native_to_little(static_cast<uint32_t>(PID));
+    const auto PID_BYTES = std::bit_cast<std::array<uint8_t, sizeof(uint32_t)>>(CHILD_PID);
+    std::ranges::copy(PID_BYTES, expected.begin() + static_cast<std::ptrdiff_t>(visus::cuid2::platform::get_hostname().size()));
+
+    visus::cuid2::HashContext context;
+    BOOST_TEST(child_digest != PARENT_DIGEST);
+    BOOST_TEST(child_digest == context.hash(expected));
+    BOOST_TEST(visus::cuid2::Fingerprint::digest() == PARENT_DIGEST);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,421 @@
+#define BOOST_TEST_MODULE GeneratorTest
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+
+#include "cuid2/generator.hpp"
+#include "cuid2/platform.hpp"
+#include "cuid2/utils.hpp"
+
+namespace {
+    /// Helper function to validate CUID2 format
+    bool is_valid_cuid2_format(const std::string& cuid, const size_t expected_length) {
+        if (cuid.length() != expected_length) {
+            return false;
+        }
+
+        if (cuid.front() < 'a' || cuid.front() > 'z') {
+            return false;
+        }
+
+        return std::all_of(cuid.begin(), cuid.end(), [](const char chr) {
+            return (chr >= '0' && chr <= '9') || (chr >= 'a' && chr <= 'z');
+        });
+    }
+
+    /// Decodes the time prefix of a sortable identifier to milliseconds.
+    int64_t sortable_millis(const std::string_view CUID) {
+        int64_t millis = CUID.front() - 'a';
+
+        for (const char CHR : CUID.substr(1, visus::cuid2::SORTABLE_TIME_LENGTH - 1)) {
+            millis = millis * 36 + static_cast<int64_t>(visus::cuid2::utils::BASE36_ALPHABET.find(CHR));
+        }
+
+        return millis;
+    }
+
+    /// Current time in milliseconds on the clock sortable identifiers use.
+    int64_t now_millis() {
+        return visus::cuid2::utils::get_timestamp_ticks() / 10'000;
+    }
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(GeneratorTests)
+
+BOOST_AUTO_TEST_CASE(test_generator_default_options)
+{
+    visus::cuid2::Generator generator;
+
+    BOOST_TEST(generator.length() == visus::cuid2::DEFAULT_LENGTH);
+    BOOST_TEST(is_valid_cuid2_format(generator.next(), visus::cuid2::DEFAULT_LENGTH));
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_custom_length)
+{
+    for (int length = visus::cuid2::MIN_CUID2_LENGTH; length <= visus::cuid2::MAX_CUID2_LENGTH; ++length) {
+        visus::cuid2::Generator generator({.length = length});
+
+        BOOST_TEST(generator.length() == length);
+        BOOST_TEST(is_valid_cuid2_format(generator.next(), static_cast<size_t>(length)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_invalid_length)
+{
+    BOOST_CHECK_THROW(visus::cuid2::Generator({.length = 3}), std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::Generator({.length = 33}), std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::Generator({.length = -1}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_timestamp_sources)
+{
+    using visus::cuid2::TimestampSource;
+
+    for (const TimestampSource SOURCE : {TimestampSource::precise, TimestampSource::coarse, TimestampSource::cached}) {
+        BOOST_TEST_CONTEXT("source " << static_cast<int>(SOURCE)) {
+            visus::cuid2::Generator generator({.timestamp = SOURCE, .timestamp_refresh = 7});
+
+            std::set<std::string> ids;
+            for (int idx = 0; idx < 100; ++idx) {
+                const std::string CUID = generator.next();
+
+                BOOST_TEST(is_valid_cuid2_format(CUID, visus::cuid2::DEFAULT_LENGTH));
+                ids.insert(CUID);
+            }
+
+            // Batches straddle refreshes of the cached reading
+            std::vector<std::string> batch(50);
+            for (int round = 0; round < 10; ++round) {
+                generator.next_batch(batch);
+                ids.insert(batch.begin(), batch.end());
+            }
+
+            BOOST_TEST(ids.size() == 600U);
+        }
+    }
+
+    BOOST_CHECK_THROW(visus::cuid2::Generator({.timestamp = TimestampSource::cached, .timestamp_refresh = 0}),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_sortable_time_prefix)
+{
+    visus::cuid2::Generator generator({.sortable = true});
+
+    const int64_t BEFORE = now_millis();
+    const std::string SINGLE = generator.next();
+
+    std::vector<std::string> batch(300);
+    generator.next_batch(batch);
+
+    std::array<char, 20> record{};
+    generator.next_batch_into(record, record.size(), 1, 20);
+
+    const auto FIXED = generator.next_id<visus::cuid2::MAX_CUID2_LENGTH>();
+    const int64_t AFTER = now_millis();
+
+    std::vector<std::string> ids{SINGLE, std::string(record.data(), record.size()), std::string(FIXED.view())};
+    ids.insert(ids.end(), batch.begin(), batch.end());
+
+    for (const auto& ID : ids) {
+        BOOST_TEST_REQUIRE(is_valid_cuid2_format(ID, ID.size()), "identifier " << ID);
+
+        const int64_t MILLIS = sortable_millis(ID);
+        BOOST_TEST(MILLIS >= BEFORE);
+        BOOST_TEST(MILLIS <= AFTER);
+    }
+
+    // A batch shares one timestamp
+    BOOST_TEST(std::all_of(batch.begin(), batch.end(), [&batch](const std::string& ID) {
+        return ID.compare(0, visus::cuid2::SORTABLE_TIME_LENGTH, batch.front(), 0,
+                          visus::cuid2::SORTABLE_TIME_LENGTH) == 0;
+    }));
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_sortable_ids_sort_by_time)
+{
+    visus::cuid2::Generator generator({.length = 16, .sortable = true});
+
+    std::vector<std::string> ids;
+    for (int round = 0; round < 5; ++round) {
+        ids.push_back(generator.next());
+
+        // Step past the millisecond resolution of the prefix
+        const int64_t START = now_millis();
+        while (now_millis() <= START) {
+            std::this_thread::yield();
+        }
+    }
+
+    BOOST_TEST(std::is_sorted(ids.begin(), ids.end()));
+    BOOST_TEST((std::adjacent_find(ids.begin(), ids.end()) == ids.end()));
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_sortable_uniqueness)
+{
+    visus::cuid2::Generator generator({.length = visus::cuid2::MIN_SORTABLE_LENGTH, .sortable = true});
+
+    std::vector<std::string> batch(1000);
+    std::set<std::string> ids;
+
+    for (int round = 0; round < 20; ++round) {
+        generator.next_batch(batch);
+        ids.insert(batch.begin(), batch.end());
+    }
+
+    BOOST_TEST(ids.size() == 20000U);
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_sortable_rejects_short_lengths)
+{
+    BOOST_CHECK_THROW(visus::cuid2::Generator({.length = visus::cuid2::MIN_SORTABLE_LENGTH - 1, .sortable = true}),
+                      std::invalid_argument);
+
+    visus::cuid2::Generator generator({.sortable = true});
+
+    std::array<char, 12> buffer{};
+    BOOST_CHECK_THROW(static_cast<void>(generator.next_into(buffer)), std::invalid_argument);
+
+    std::vector<std::string> batch(4);
+    BOOST_CHECK_THROW(generator.next_batch(batch, 12), std::invalid_argument);
+    BOOST_CHECK_THROW(generator.next_batch_into(buffer, buffer.size(), 1, 12), std::invalid_argument);
+    BOOST_CHECK_THROW(static_cast<void>(generator.next_id<12>()), std::invalid_argument);
+
+    // The default layout still accepts every length
+    visus::cuid2::Generator unsorted({.length = 4});
+    BOOST_TEST(unsorted.next_id<4>().view().size() == 4U);
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_next_into)
+{
+    visus::cuid2::Generator generator;
+
+    std::array<char, 12> buffer{};
+    BOOST_TEST(generator.next_into(buffer) == buffer.size());
+    BOOST_TEST(is_valid_cuid2_format(std::string(buffer.data(), buffer.size()), buffer.size()));
+
+    std::array<char, 3> too_small{};
+    BOOST_CHECK_THROW(static_cast<void>(generator.next_into(too_small)), std::invalid_argument);
+
+    std::array<char, 33> too_large{};
+    BOOST_CHECK_THROW(static_cast<void>(generator.next_into(too_large)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_next_batch)
+{
+    constexpr size_t BATCH_SIZE = 300;
+
+    visus::cuid2::Generator generator({.length = 10});
+
+    std::vector<std::string> ids(BATCH_SIZE);
+    generator.next_batch(ids);
+
+    for (const auto& cuid : ids) {
+        BOOST_TEST(is_valid_cuid2_format(cuid, 10));
+    }
+
+    generator.next_batch(ids, 28);
+
+    for (const auto& cuid : ids) {
+        BOOST_TEST(is_valid_cuid2_format(cuid, 28));
+    }
+
+    const std::set<std::string> UNIQUE(ids.begin(), ids.end());
+    BOOST_TEST(UNIQUE.size() == BATCH_SIZE);
+
+    BOOST_CHECK_THROW(generator.next_batch(ids, 3), std::invalid_argument);
+    BOOST_CHECK_THROW(generator.next_batch(ids, 33), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_next_batch_into)
+{
+    constexpr size_t COUNT = 300;
+    constexpr size_t LENGTH = 16;
+    constexpr size_t STRIDE = 17;
+
+    visus::cuid2::Generator generator;
+
+    std::vector<char> column((COUNT - 1) * STRIDE + LENGTH, '\0');
+    generator.next_batch_into(column, STRIDE, COUNT, static_cast<int>(LENGTH));
+
+    std::set<std::string> ids;
+    for (size_t idx = 0; idx < COUNT; ++idx) {
+        const std::string CUID(column.data() + idx * STRIDE, LENGTH);
+
+        BOOST_TEST(is_valid_cuid2_format(CUID, LENGTH));
+        ids.insert(CUID);
+
+        // Gaps between records are left untouched
+        if (idx + 1 < COUNT) {
+            BOOST_TEST(column[idx * STRIDE + LENGTH] == '\0');
+        }
+    }
+    BOOST_TEST(ids.size() == COUNT);
+
+    BOOST_CHECK_NO_THROW(generator.next_batch_into(std::span<char>(), STRIDE, 0, static_cast<int>(LENGTH)));
+    BOOST_CHECK_THROW(generator.next_batch_into(column, STRIDE, COUNT, 3), std::invalid_argument);
+    BOOST_CHECK_THROW(generator.next_batch_into(column, STRIDE, COUNT, 33), std::invalid_argument);
+    BOOST_CHECK_THROW(generator.next_batch_into(column, LENGTH - 1, COUNT, static_cast<int>(LENGTH)),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(generator.next_batch_into(column, STRIDE, COUNT + 1, static_cast<int>(LENGTH)),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_uniqueness)
+{
+    constexpr int NUM_IDS = 10000;
+
+    visus::cuid2::Generator generator;
+    std::set<std::string> ids;
+
+    for (int idx = 0; idx < NUM_IDS; ++idx) {
+        ids.insert(generator.next());
+    }
+
+    BOOST_TEST(ids.size() == static_cast<size_t>(NUM_IDS));
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_custom_entropy)
+{
+    constexpr int LENGTH = 16;
+    constexpr size_t BATCH_SIZE = 200;
+
+    size_t requested = 0;
+
+    visus::cuid2::Generator generator({
+        .length = LENGTH,
+        .entropy = [&requested](std::span<uint8_t> out) {
+            std::ranges::fill(out, uint8_t{0});
+            requested += out.size();
+        },
+    });
+
+    // The instance counter is seeded from the entropy source
+    BOOST_TEST(requested == sizeof(uint64_t));
+
+    // A zero prefix byte always maps to the first letter
+    const std::string CUID = generator.next();
+    BOOST_TEST(CUID.front() == 'a');
+    BOOST_TEST(requested == sizeof(uint64_t) + LENGTH + 1);
+
+    // Constant entropy still yields distinct identifiers through the counter
+    std::vector<std::string> ids(BATCH_SIZE);
+    generator.next_batch(ids);
+
+    const std::set<std::string> UNIQUE(ids.begin(), ids.end());
+    BOOST_TEST(UNIQUE.size() == BATCH_SIZE);
+    BOOST_TEST(requested == sizeof(uint64_t) + (BATCH_SIZE + 1) * (LENGTH + 1));
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_reseeds_owned_counter)
+{
+    constexpr int LENGTH = 16;
+
+    size_t requested = 0;
+
+    visus::cuid2::Generator generator({
+        .length = LENGTH,
+        .entropy = [&requested](std::span<uint8_t> out) {
+            std::ranges::fill(out, uint8_t{0});
+            requested += out.size();
+        },
+    });
+
+    static_cast<void>(generator.next());
+    BOOST_TEST(requested == sizeof(uint64_t) + LENGTH + 1);
+
+    // The next identifier in a new generation first draws a new counter seed
+    visus::cuid2::platform::start_new_generation();
+    static_cast<void>(generator.next());
+    BOOST_TEST(requested == 2 * (sizeof(uint64_t) + LENGTH + 1));
+
+    static_cast<void>(generator.next());
+    BOOST_TEST(requested == 2 * sizeof(uint64_t) + 3 * (LENGTH + 1));
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_custom_fingerprint)
+{
+    visus::cuid2::Generator generator({.fingerprint = std::vector<uint8_t>{'n', 'o', 'd', 'e', '-', '1'}});
+
+    std::set<std::string> ids;
+    for (int idx = 0; idx < 1000; ++idx) {
+        const std::string CUID = generator.next();
+        BOOST_TEST(is_valid_cuid2_format(CUID, visus::cuid2::DEFAULT_LENGTH));
+        ids.insert(CUID);
+    }
+
+    BOOST_TEST(ids.size() == 1000U);
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_shared_counter)
+{
+    visus::cuid2::Generator generator({.shared_counter = true});
+
+    std::vector<std::string> ids(100);
+    generator.next_batch(ids);
+
+    const std::set<std::string> UNIQUE(ids.begin(), ids.end());
+    BOOST_TEST(UNIQUE.size() == ids.size());
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_per_thread_instances)
+{
+    constexpr int NUM_THREADS = 8;
+    constexpr int IDS_PER_THREAD = 2000;
+
+    std::vector<std::jthread> threads;
+    std::vector<std::vector<std::string>> thread_ids(NUM_THREADS);
+
+    threads.reserve(NUM_THREADS);
+
+    for (int thread_idx = 0; thread_idx < NUM_THREADS; ++thread_idx) {
+        threads.emplace_back([thread_idx, &thread_ids]() {
+            visus::cuid2::Generator generator;
+
+            thread_ids[thread_idx].reserve(IDS_PER_THREAD);
+            for (int idx = 0; idx < IDS_PER_THREAD; ++idx) {
+                thread_ids[thread_idx].push_back(generator.next());
+            }
+        });
+    }
+
+    // Explicitly join to ensure threads complete before accessing results
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::set<std::string> all_ids;
+    for (const auto& ids : thread_ids) {
+        all_ids.insert(ids.begin(), ids.end());
+    }
+
+    BOOST_TEST(all_ids.size() == static_cast<size_t>(NUM_THREADS * IDS_PER_THREAD));
+}
+
+BOOST_AUTO_TEST_CASE(test_generator_move)
+{
+    visus::cuid2::Generator original({.length = 20});
+    visus::cuid2::Generator moved(std::move(original));
+
+    BOOST_TEST(is_valid_cuid2_format(moved.next(), 20));
+
+    visus::cuid2::Generator assigned;
+    assigned = std::move(moved);
+
+    BOOST_TEST(assigned.length() == 20);
+    BOOST_TEST(is_valid_cuid2_format(assigned.next(), 20));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,105 @@
+#define BOOST_TEST_MODULE HashTest
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+
+#include "cuid2/hash.hpp"
+
+namespace {
+    std::span<const uint8_t> as_bytes(std::string_view text) {
+        return {reinterpret_cast<const uint8_t*>(text.data()), text.size()};
+    }
+
+    std::string to_hex(const visus::cuid2::utils::Digest& digest) {
+        constexpr std::string_view HEX_DIGITS = "0123456789abcdef";
+
+        std::string result;
+        result.reserve(digest.size() * 2);
+
+        for (const uint8_t BYTE : digest) {
+            result.push_back(HEX_DIGITS[BYTE >> 4]);
+            result.push_back(HEX_DIGITS[BYTE & 0x0F]);
+        }
+
+        return result;
+    }
+
+    constexpr std::string_view SHA3_512_EMPTY =
+        "a69f73cca23a9ac5c8b567dc185a756e97c982164fe25859e0d1dcc1475c80a6"
+        "15b2123af1f5f94c11e3e9402c3ac558f500199d95b6d3e301758586281dcd26";
+
+    constexpr std::string_view SHA3_512_ABC =
+        "b751850b1a57168a5693cd924b6b096e08f621827444f70d884f5d0240d2712e"
+        "10e116e9192af3c91a7ec57647e3934057340b4cf408d5a56592f8274eec53f0";
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(HashTests)
+
+BOOST_AUTO_TEST_CASE(test_hash_known_answers)
+{
+    visus::cuid2::HashContext context;
+
+    BOOST_TEST(to_hex(context.hash({})) == SHA3_512_EMPTY);
+    BOOST_TEST(to_hex(context.hash(as_bytes("abc"))) == SHA3_512_ABC);
+}
+
+BOOST_AUTO_TEST_CASE(test_hash_context_reuse)
+{
+    visus::cuid2::HashContext context;
+
+    // Re-initializing must discard all state from the previous computation
+    for (int idx = 0; idx < 100; ++idx) {
+        BOOST_TEST(to_hex(context.hash(as_bytes("abc"))) == SHA3_512_ABC);
+        BOOST_TEST(to_hex(context.hash({})) == SHA3_512_EMPTY);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_hash_incremental_updates)
+{
+    visus::cuid2::HashContext context;
+
+    context.init();
+    context.update(as_bytes("a"));
+    context.update({});
+    context.update(as_bytes("bc"));
+
+    BOOST_TEST(to_hex(context.finalize()) == SHA3_512_ABC);
+}
+
+BOOST_AUTO_TEST_CASE(test_hash_context_per_thread)
+{
+    visus::cuid2::HashContext context;
+    std::string other_result;
+
+    std::jthread worker([&other_result]() {
+        visus::cuid2::HashContext other;
+        other_result = to_hex(other.hash(as_bytes("abc")));
+    });
+    worker.join();
+
+    BOOST_TEST(other_result == SHA3_512_ABC);
+    BOOST_TEST(to_hex(context.hash(as_bytes("abc"))) == SHA3_512_ABC);
+}
+
+BOOST_AUTO_TEST_CASE(test_hash_move)
+{
+    visus::cuid2::HashContext original;
+    visus::cuid2::HashContext moved(std::move(original));
+
+    BOOST_TEST(to_hex(moved.hash(as_bytes("abc"))) == SHA3_512_ABC);
+
+    visus::cuid2::HashContext assigned;
+    assigned = std::move(moved);
+
+    BOOST_TEST(to_hex(assigned.hash({})) == SHA3_512_EMPTY);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,142 @@
+#define BOOST_TEST_MODULE IdentifierTest
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+
+#include "cuid2/cuid2.hpp"
+#include "cuid2/identifier.hpp"
+
+using visus::cuid2::Cuid2;
+
+static_assert(sizeof(Cuid2) == 24);
+static_assert(std::is_trivially_copyable_v<Cuid2>);
+
+BOOST_AUTO_TEST_SUITE(IdentifierTests)
+
+BOOST_AUTO_TEST_CASE(test_round_trip_every_length)
+{
+    for (int length = visus::cuid2::MIN_CUID2_LENGTH; length <= visus::cuid2::MAX_CUID2_LENGTH; ++length) {
+        for (int iteration = 0; iteration < 100; ++iteration) {
+            const std::string TEXT = visus::cuid2::generate(length);
+            const Cuid2 VALUE = Cuid2::parse(TEXT);
+
+            BOOST_TEST(VALUE.size() == TEXT.size());
+            BOOST_TEST(VALUE.str() == TEXT);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_round_trip_extreme_characters)
+{
+    for (const std::string_view TEXT : {"a000", "zzzz", "z0z0z0z0z0z0z0z0z0z0z0z0z0z0z0z0", "azzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz"}) {
+        BOOST_TEST(Cuid2::parse(TEXT).str() == TEXT);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_rejects_invalid_text)
+{
+    const std::vector<std::string> INVALID = {
+        "",
+        "abc",
+        std::string(33, 'a'),
+        "1abc",
+        "Abcd",
+        "abcD",
+        "abc-",
+        "abc/",
+        "abc:",
+        "abc`",
+        "abc{",
+        "abc@",
+        std::string("ab\0d", 4),
+        "abc\xE9",
+        "abcdefghijklmnopqrstuvwxyz01234_",
+    };
+
+    for (const auto& text : INVALID) {
+        BOOST_TEST(!Cuid2::try_parse(text).has_value(), "accepted '" << text << "'");
+        BOOST_CHECK_THROW(static_cast<void>(Cuid2::parse(text)), std::invalid_argument);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_ordering_matches_text)
+{
+    std::vector<std::string> texts = {"a000", "a0000", "a001", "abcd", "abcde", "b000", "zzzz", "zzzzz"};
+    for (int idx = 0; idx < 200; ++idx) {
+        texts.push_back(visus::cuid2::generate(4 + idx % 29));
+    }
+
+    for (const auto& lhs : texts) {
+        for (const auto& rhs : texts) {
+            const auto EXPECTED = lhs <=> rhs;
+            BOOST_TEST(((Cuid2::parse(lhs) <=> Cuid2::parse(rhs)) == EXPECTED), lhs << " vs " << rhs);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_empty_value)
+{
+    const Cuid2 EMPTY;
+
+    BOOST_TEST(EMPTY.empty());
+    BOOST_TEST(EMPTY.size() == 0U);
+    BOOST_TEST(EMPTY.str().empty());
+    BOOST_TEST((EMPTY < Cuid2::parse("a000")));
+}
+
+BOOST_AUTO_TEST_CASE(test_to_chars)
+{
+    const Cuid2 VALUE = Cuid2::parse("k2p9xa7r2p9xa7r2");
+    std::array<char, 16> exact{};
+    std::array<char, 15> small{};
+
+    const auto OK = VALUE.to_chars(exact.data(), exact.data() + exact.size());
+    BOOST_TEST((OK.ec == std::errc{}));
+    BOOST_TEST(static_cast<size_t>(OK.ptr - exact.data()) == exact.size());
+    BOOST_TEST(std::string_view(exact.data(), exact.size()) == "k2p9xa7r2p9xa7r2");
+
+    const auto TOO_SMALL = VALUE.to_chars(small.data(), small.data() + small.size());
+    BOOST_TEST((TOO_SMALL.ec == std::errc::value_too_large));
+}
+
+BOOST_AUTO_TEST_CASE(test_hash_set)
+{
+    std::unordered_set<Cuid2> values;
+    std::vector<std::string> texts;
+
+    for (int idx = 0; idx < 10000; ++idx) {
+        texts.push_back(visus::cuid2::generate());
+        values.insert(Cuid2::parse(texts.back()));
+    }
+
+    BOOST_TEST(values.size() == texts.size());
+    BOOST_TEST(std::ranges::all_of(texts, [&](const auto& text) { return values.contains(Cuid2::parse(text)); }));
+    BOOST_TEST(std::hash<Cuid2>{}(Cuid2::parse(texts.front())) == std::hash<Cuid2>{}(Cuid2::parse(texts.front())));
+}
+
+BOOST_AUTO_TEST_CASE(test_from_limbs)
+{
+    const Cuid2 VALUE = Cuid2::parse(visus::cuid2::generate());
+
+    BOOST_TEST((Cuid2::from_limbs(VALUE.limbs()) == VALUE));
+
+    // Empty, a digit prefix, a gap in the codes, and an out-of-range code
+    BOOST_CHECK_THROW(static_cast<void>(Cuid2::from_limbs({})), std::invalid_argument);
+    BOOST_CHECK_THROW(static_cast<void>(Cuid2::from_limbs({uint64_t{1} << 58 | 1, 0, 0})), std::invalid_argument);
+    BOOST_CHECK_THROW(static_cast<void>(Cuid2::from_limbs({uint64_t{11} << 58 | 1, 0, 0})), std::invalid_argument);
+    BOOST_CHECK_THROW(static_cast<void>(Cuid2::from_limbs({~uint64_t{0}, 0, 0})), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,119 @@
+#define BOOST_TEST_MODULE KeccakTest
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+
+#include "cuid2/generator.hpp"
+#include "cuid2/hash.hpp"
+#include "cuid2/keccak.hpp"
+
+namespace {
+    using visus::cuid2::HashContext;
+    using visus::cuid2::keccak::Backend;
+    using visus::cuid2::utils::Digest;
+
+    constexpr std::array<Backend, 4> ALL_BACKENDS = {Backend::scalar, Backend::avx2, Backend::avx512, Backend::neon};
+
+    /// Fills a buffer with a deterministic, position-dependent byte pattern.
+    std::vector<uint8_t> make_messages(const size_t COUNT, const size_t STRIDE) {
+        std::vector<uint8_t> result(COUNT * STRIDE);
+
+        for (size_t idx = 0; idx < result.size(); ++idx) {
+            result[idx] = static_cast<uint8_t>((idx * 131) ^ (idx >> 3));
+        }
+
+        return result;
+    }
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(KeccakTests)
+
+BOOST_AUTO_TEST_CASE(test_scalar_always_supported)
+{
+    BOOST_TEST(visus::cuid2::keccak::is_supported(Backend::scalar));
+    BOOST_TEST(visus::cuid2::keccak::lane_count(Backend::scalar) == 1U);
+    BOOST_TEST(visus::cuid2::keccak::is_supported(visus::cuid2::keccak::detect_backend()));
+}
+
+BOOST_AUTO_TEST_CASE(test_backends_match_evp)
+{
+    constexpr std::array<size_t, 8> LENGTHS = {0, 1, 71, 72, 73, 104, 144, 250};
+    constexpr size_t STRIDE = 256;
+
+    HashContext context;
+
+    for (const Backend BACKEND : ALL_BACKENDS) {
+        if (!visus::cuid2::keccak::is_supported(BACKEND)) {
+            continue;
+        }
+
+        BOOST_TEST_CONTEXT("backend " << visus::cuid2::keccak::backend_name(BACKEND)) {
+            for (const size_t LENGTH : LENGTHS) {
+                for (size_t count = 1; count <= 17; ++count) {
+                    const auto MESSAGES = make_messages(count, STRIDE);
+                    std::vector<Digest> digests(count);
+
+                    visus::cuid2::keccak::sha3_512_strided(MESSAGES, STRIDE, LENGTH, digests, BACKEND);
+
+                    for (size_t idx = 0; idx < count; ++idx) {
+                        const auto EXPECTED = context.hash(std::span(MESSAGES).subspan(idx * STRIDE, LENGTH));
+                        BOOST_TEST(digests[idx] == EXPECTED, "length " << LENGTH << ", count " << count << ", message " << idx);
+                    }
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_rejects_invalid_layout)
+{
+    const auto MESSAGES = make_messages(4, 64);
+    std::vector<Digest> digests(4);
+
+    // Message longer than its stride
+    BOOST_CHECK_THROW(visus::cuid2::keccak::sha3_512_strided(MESSAGES, 64, 65, digests, Backend::scalar), std::invalid_argument);
+
+    // More messages than the buffer holds
+    std::vector<Digest> too_many(5);
+    BOOST_CHECK_THROW(visus::cuid2::keccak::sha3_512_strided(MESSAGES, 64, 64, too_many, Backend::scalar), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_rejects_unsupported_backend)
+{
+    const auto MESSAGES = make_messages(1, 64);
+    std::vector<Digest> digests(1);
+
+    for (const Backend BACKEND : ALL_BACKENDS) {
+        if (!visus::cuid2::keccak::is_supported(BACKEND)) {
+            BOOST_CHECK_THROW(visus::cuid2::keccak::sha3_512_strided(MESSAGES, 64, 64, digests, BACKEND), std::invalid_argument);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_generation_uses_valid_format)
+{
+    for (const int LENGTH : {4, 24, 32}) {
+        visus::cuid2::Generator generator(visus::cuid2::GeneratorOptions{.length = LENGTH});
+
+        std::vector<std::string> ids(301);
+        generator.next_batch(ids);
+
+        for (const auto& id : ids) {
+            BOOST_TEST(id.size() == static_cast<size_t>(LENGTH));
+            BOOST_TEST((id.front() >= 'a' && id.front() <= 'z'));
+
+            for (const char CHR : id) {
+                BOOST_TEST(((CHR >= '0' && CHR <= '9') || (CHR >= 'a' && CHR <= 'z')));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2,11 +2,20 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
+#include <filesystem>
 #include <set>
+#include <string>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
 
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+extern char **environ; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+#endif
+
 #include "cuid2/platform.hpp"
 
 BOOST_AUTO_TEST_SUITE(PlatformTests)
@@ -39,6 +48,103 @@ BOOST_AUTO_TEST_CASE(test_get_random_bytes_fills_buffer)
     BOOST_TEST(!all_zeros);
 }
 
+BOOST_AUTO_TEST_CASE(test_get_random_bytes_small_requests_do_not_repeat)
+{
+    // Enough 16-byte requests to cross several buffer refills
+    constexpr int REQUEST_COUNT = 2048;
+
+    std::set<std::array<unsigned char, 16>> values;
+
+    for (int idx = 0; idx < REQUEST_COUNT; ++idx) {
+        std::array<unsigned char, 16> buffer{};
+        visus::cuid2::platform::get_random_bytes(buffer.data(), buffer.size());
+        values.insert(buffer);
+    }
+
+    BOOST_TEST(values.size() == static_cast<size_t>(REQUEST_COUNT));
+}
+
+BOOST_AUTO_TEST_CASE(test_get_random_bytes_large_request)
+{
+    std::vector<unsigned char> first(64 * 1024);
+    std::vector<unsigned char> second(64 * 1024);
+
+    visus::cuid2::platform::get_random_bytes(first.data(), first.size());
+    visus::cuid2::platform::get_random_bytes(second.data(), second.size());
+
+    BOOST_TEST(first != second);
+    BOOST_TEST(std::count(first.begin(), first.end(), 0) < 1024);
+}
+
+#ifndef _WIN32
+BOOST_AUTO_TEST_CASE(test_get_random_bytes_differs_after_fork)
+{
+    // Prime this thread's buffer so the child inherits buffered bytes
+    std::array<unsigned char, 16> primer{};
+    visus::cuid2::platform::get_random_bytes(primer.data(), primer.size());
+
+    std::array<int, 2> pipe_fds{};
+    BOOST_REQUIRE(pipe(pipe_fds.data()) == 0);
+
+    const pid_t PID = fork();
+    BOOST_REQUIRE(PID >= 0);
+
+    if (PID == 0) {
+        std::array<unsigned char, 16> child_bytes{};
+        visus::cuid2::platform::get_random_bytes(child_bytes.data(), child_bytes.size());
+        const bool WRITTEN = write(pipe_fds[1], child_bytes.data(), child_bytes.size()) ==
+                             static_cast<ssize_t>(child_bytes.size());
+        _exit(WRITTEN ? 0 : 1);
+    }
+
+    close(pipe_fds[1]);
+
+    std::array<unsigned char, 16> parent_bytes{};
+    visus::cuid2::platform::get_random_bytes(parent_bytes.data(), parent_bytes.size());
+
+    std::array<unsigned char, 16> child_bytes{};
+    const ssize_t READ = read(pipe_fds[0], child_bytes.data(), child_bytes.size());
+    close(pipe_fds[0]);
+
+    int status = 0;
+    waitpid(PID, &status, 0);
+
+    BOOST_REQUIRE(READ == static_cast<ssize_t>(child_bytes.size()));
+    BOOST_TEST(WIFEXITED(status));
+    BOOST_TEST(parent_bytes != child_bytes);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(test_start_new_generation_advances)
+{
+    const uint64_t BEFORE = visus::cuid2::platform::process_generation();
+
+    visus::cuid2::platform::start_new_generation();
+
+    BOOST_TEST(visus::cuid2::platform::process_generation() == BEFORE + 1);
+}
+
+#ifndef _WIN32
+BOOST_AUTO_TEST_CASE(test_process_generation_advances_in_child)
+{
+    const uint64_t PARENT_GENERATION = visus::cuid2::platform::process_generation();
+
+    const pid_t PID = fork();
+    BOOST_REQUIRE(PID >= 0);
+
+    if (PID == 0) {
+        _exit(visus::cuid2::platform::process_generation() == PARENT_GENERATION + 1 ? 0 : 1);
+    }
+
+    int status = 0;
+    waitpid(PID, &status, 0);
+
+    BOOST_TEST(WIFEXITED(status));
+    BOOST_TEST(WEXITSTATUS(status) == 0);
+    BOOST_TEST(visus::cuid2::platform::process_generation() == PARENT_GENERATION);
+}
+#endif
+
 BOOST_AUTO_TEST_CASE(test_get_process_id_consistent)
 {
     const int PID1 = visus::cuid2::platform::get_process_id();
@@ -48,6 +154,22 @@ BOOST_AUTO_TEST_CASE(test_get_process_id_consistent)
     BOOST_TEST(PID1 > 0);
 }
 
+BOOST_AUTO_TEST_CASE(test_get_numa_node_exists)
+{
+    const unsigned NODE = visus::cuid2::platform::get_numa_node();
+
+#ifdef __linux__
+    // Kernels without NUMA support have no node directory and report node 0
+    if (std::filesystem::exists("/sys/devices/system/node")) {
+        BOOST_TEST(std::filesystem::exists("/sys/devices/system/node/node" + std::to_string(NODE)));
+    } else {
+        BOOST_TEST(NODE == 0U);
+    }
+#else
+    BOOST_TEST(NODE < 1024U);
+#endif
+}
+
 BOOST_AUTO_TEST_CASE(test_get_hostname_not_empty)
 {
     const std::string HOSTNAME = visus::cuid2::platform::get_hostname();
@@ -78,4 +200,51 @@ BOOST_AUTO_TEST_CASE(test_get_environment_variables_sorted)
     BOOST_TEST(IS_SORTED);
 }
 
+BOOST_AUTO_TEST_CASE(test_append_environment_matches_map)
+{
+    const auto ENV_VARS = visus::cuid2::platform::get_environment_variables();
+
+    std::vector<uint8_t> expected = {'x', 'y'};
+    for (const auto& [key, value] : ENV_VARS) {
+        expected.insert(expected.end(), key.begin(), key.end());
+        expected.push_back('=');
+        expected.insert(expected.end(), value.begin(), value.end());
+    }
+
+    // Existing contents are preserved and the environment is appended
+    std::vector<uint8_t> actual = {'x', 'y'};
+    visus::cuid2::platform::append_environment(actual);
+
+    BOOST_TEST(actual == expected);
+}
+
+#ifndef _WIN32
+BOOST_AUTO_TEST_CASE(test_append_environment_sorts_and_deduplicates)
+{
+    std::array<char, 8> zeta = {'Z', 'E', 'T', 'A', '=', '1', '\0'};
+    std::array<char, 8> alpha_first = {'A', '=', 'x', '=', 'y', '\0'};
+    std::array<char, 8> no_delimiter = {'B', 'O', 'G', 'U', 'S', '\0'};
+    std::array<char, 8> alpha_second = {'A', '=', 'z', '\0'};
+    std::array<char, 8> alphabet = {'A', 'B', '=', '2', '\0'};
+    std::array<char *, 6> custom_environ = {
+        zeta.data(), alpha_first.data(), no_delimiter.data(), alpha_second.data(), alphabet.data(), nullptr};
+
+    char **saved_environ = environ;
+    environ = custom_environ.data();
+
+    std::vector<uint8_t> actual;
+    visus::cuid2::platform::append_environment(actual);
+    const auto ENV_VARS = visus::cuid2::platform::get_environment_variables();
+
+    environ = saved_environ;
+
+    // The first of duplicated keys wins, entries without '=' are skipped
+    const std::string EXPECTED = "A=x=yAB=2ZETA=1";
+    BOOST_TEST(std::string(actual.begin(), actual.end()) == EXPECTED);
+
+    BOOST_TEST(ENV_VARS.size() == 3U);
+    BOOST_TEST(ENV_VARS.at("A") == "x=y");
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
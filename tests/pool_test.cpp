@@ -0,0 +1,260 @@
+#define BOOST_TEST_MODULE PoolTest
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "cuid2/platform.hpp"
+#include "cuid2/pool.hpp"
+
+namespace {
+    /// Polls until the pool is back at its high watermark.
+    ///
+    /// @return false if the refill thread did not catch up within a few seconds
+    bool wait_for_refill(const visus::cuid2::Pool& pool, const std::size_t HIGH_WATERMARK) {
+        const auto DEADLINE = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+        while (pool.stats().available < HIGH_WATERMARK) {
+            if (std::chrono::steady_clock::now() > DEADLINE) {
+                return false;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        return true;
+    }
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(PoolTests)
+
+BOOST_AUTO_TEST_CASE(test_pool_prefills_to_high_watermark)
+{
+    const visus::cuid2::Pool POOL({.length = 16, .capacity = 1000});
+
+    BOOST_TEST(POOL.capacity() == 1024U);
+    BOOST_TEST(POOL.length() == 16);
+
+    const auto STATS = POOL.stats();
+    BOOST_TEST(STATS.available == 1024U);
+    BOOST_TEST(STATS.hits == 0U);
+    BOOST_TEST(STATS.misses == 0U);
+    BOOST_TEST(STATS.hit_rate() == 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(test_pool_acquire_format)
+{
+    visus::cuid2::Pool pool({.length = 24, .capacity = 64});
+
+    for (int idx = 0; idx < 200; ++idx) {
+        const std::string ID = pool.acquire();
+
+        BOOST_TEST_REQUIRE(visus::cuid2::is_cuid2(ID, 24), "identifier " << ID);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_pool_acquire_into)
+{
+    visus::cuid2::Pool pool({.length = 10, .capacity = 16});
+
+    std::array<char, 12> buffer{};
+    buffer.fill('#');
+
+    BOOST_TEST(pool.acquire_into(buffer) == 10U);
+    BOOST_TEST(visus::cuid2::is_cuid2(std::string_view(buffer.data(), 10), 10));
+    BOOST_TEST(buffer[10] == '#');
+
+    std::array<char, 9> short_buffer{};
+    BOOST_CHECK_THROW(pool.acquire_into(short_buffer), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_pool_rejects_bad_options)
+{
+    BOOST_CHECK_THROW(visus::cuid2::Pool({.length = 3}), std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::Pool({.length = 33}), std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::Pool({.capacity = 0}), std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::Pool({.refill_batch = 0}), std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::Pool({.capacity = 64, .low_watermark = 32, .high_watermark = 32}),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::Pool({.capacity = 64, .low_watermark = 8, .high_watermark = 65}),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_pool_refills_after_low_watermark)
+{
+    constexpr std::size_t CAPACITY = 256;
+    constexpr std::size_t LOW = 64;
+    constexpr std::size_t HIGH = 192;
+
+    visus::cuid2::Pool pool({.length = 16, .capacity = CAPACITY, .low_watermark = LOW, .high_watermark = HIGH,
+                             .refill_batch = 32});
+    BOOST_TEST(pool.stats().available == HIGH);
+
+    // Take just enough to reach the low watermark
+    std::set<std::string> ids;
+    for (std::size_t idx = 0; idx < HIGH - LOW; ++idx) {
+        ids.insert(pool.acquire());
+    }
+
+    BOOST_TEST_REQUIRE(wait_for_refill(pool, HIGH));
+
+    const auto STATS = pool.stats();
+    BOOST_TEST(STATS.refills >= 1U);
+    BOOST_TEST(STATS.hits == HIGH - LOW);
+    BOOST_TEST(STATS.misses == 0U);
+    BOOST_TEST(STATS.max_refill_lag.count() > 0);
+    BOOST_TEST((STATS.max_refill_lag >= STATS.last_refill_lag));
+    BOOST_TEST((STATS.total_refill_lag >= STATS.max_refill_lag));
+    BOOST_TEST(ids.size() == HIGH - LOW);
+}
+
+BOOST_AUTO_TEST_CASE(test_pool_falls_back_when_empty)
+{
+    // Draining a small ring faster than one refill completes must still
+    // return unique identifiers
+    constexpr std::size_t COUNT = 20000;
+
+    visus::cuid2::Pool pool({.length = 24, .capacity = 8, .refill_batch = 8});
+    std::set<std::string> ids;
+
+    for (std::size_t idx = 0; idx < COUNT; ++idx) {
+        ids.insert(pool.acquire());
+    }
+
+    const auto STATS = pool.stats();
+    BOOST_TEST(ids.size() == COUNT);
+    BOOST_TEST(STATS.hits + STATS.misses == COUNT);
+    BOOST_TEST(STATS.hit_rate() >= 0.0);
+    BOOST_TEST(STATS.hit_rate() <= 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(test_pool_concurrent_acquire)
+{
+    constexpr int THREAD_COUNT = 8;
+    constexpr int PER_THREAD = 5000;
+
+    visus::cuid2::Pool pool({.length = 24, .capacity = 1024, .refill_batch = 128});
+
+    std::mutex mutex;
+    std::set<std::string> ids;
+    std::vector<std::thread> threads;
+
+    for (int thread = 0; thread < THREAD_COUNT; ++thread) {
+        threads.emplace_back([&] {
+            std::vector<std::string> local;
+            local.reserve(PER_THREAD);
+
+            for (int idx = 0; idx < PER_THREAD; ++idx) {
+                local.push_back(pool.acquire());
+            }
+
+            const std::scoped_lock LOCK(mutex);
+            ids.insert(local.begin(), local.end());
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto STATS = pool.stats();
+    BOOST_TEST(ids.size() == static_cast<std::size_t>(THREAD_COUNT * PER_THREAD));
+    BOOST_TEST(STATS.hits + STATS.misses == static_cast<uint64_t>(THREAD_COUNT * PER_THREAD));
+}
+
+BOOST_AUTO_TEST_CASE(test_pool_discards_after_new_generation)
+{
+    constexpr std::size_t CAPACITY = 128;
+
+    visus::cuid2::Pool pool({.length = 24, .capacity = CAPACITY});
+    const std::string BEFORE = pool.acquire();
+
+    visus::cuid2::platform::start_new_generation();
+
+    // Everything left in the ring predates the new generation
+    const std::string AFTER = pool.acquire();
+    BOOST_TEST(visus::cuid2::is_cuid2(AFTER, 24));
+    BOOST_TEST(AFTER != BEFORE);
+    BOOST_TEST(pool.stats().discarded == CAPACITY - 1);
+    BOOST_TEST(pool.stats().misses == 1U);
+
+    BOOST_TEST_REQUIRE(wait_for_refill(pool, CAPACITY));
+    static_cast<void>(pool.acquire());
+    BOOST_TEST(pool.stats().hits == 2U);
+}
+
+#ifndef _WIN32
+BOOST_AUTO_TEST_CASE(test_pool_child_does_not_repeat_parent)
+{
+    constexpr std::size_t COUNT = 16;
+    constexpr std::size_t LENGTH = 24;
+
+    visus::cuid2::Pool pool({.length = static_cast<int>(LENGTH), .capacity = 64});
+
+    std::array<int, 2> pipe_fds{};
+    BOOST_REQUIRE(pipe(pipe_fds.data()) == 0);
+
+    const pid_t PID = fork();
+    BOOST_REQUIRE(PID >= 0);
+
+    if (PID == 0) {
+        std::array<char, COUNT * LENGTH> child_ids{};
+        for (std::size_t idx = 0; idx < COUNT; ++idx) {
+            pool.acquire_into(std::span<char>(child_ids).subspan(idx * LENGTH, LENGTH));
+        }
+
+        const bool WRITTEN = write(pipe_fds[1], child_ids.data(), child_ids.size()) ==
+                             static_cast<ssize_t>(child_ids.size());
+        _exit(WRITTEN ? 0 : 1);
+    }
+
+    close(pipe_fds[1]);
+
+    std::set<std::string> parent_ids;
+    for (std::size_t idx = 0; idx < COUNT; ++idx) {
+        parent_ids.insert(pool.acquire());
+    }
+
+    std::array<char, COUNT * LENGTH> child_ids{};
+    std::size_t received = 0;
+    while (received < child_ids.size()) {
+        const ssize_t READ = read(pipe_fds[0], child_ids.data() + received, child_ids.size() - received);
+        if (READ <= 0) {
+            break;
+        }
+        received += static_cast<std::size_t>(READ);
+    }
+    close(pipe_fds[0]);
+
+    int status = 0;
+    waitpid(PID, &status, 0);
+
+    BOOST_REQUIRE(received == child_ids.size());
+    BOOST_TEST(WIFEXITED(status));
+    BOOST_TEST(WEXITSTATUS(status) == 0);
+
+    for (std::size_t idx = 0; idx < COUNT; ++idx) {
+        const std::string CHILD_ID(child_ids.data() + idx * LENGTH, LENGTH);
+
+        BOOST_TEST(visus::cuid2::is_cuid2(CHILD_ID, static_cast<int>(LENGTH)));
+        BOOST_TEST(!parent_ids.contains(CHILD_ID), "child repeated " << CHILD_ID);
+    }
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,142 @@
+#define BOOST_TEST_MODULE StatsTest
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+
+#include "cuid2/generator.hpp"
+#include "cuid2/stats.hpp"
+
+namespace {
+    using visus::cuid2::Stage;
+
+    /// Removes any installed callback when a test ends.
+    struct CallbackGuard {
+        ~CallbackGuard() {
+            visus::cuid2::set_stats_callback({}, 0);
+        }
+    };
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(StatsTests)
+
+BOOST_AUTO_TEST_CASE(test_enabled)
+{
+    BOOST_TEST(visus::cuid2::instrumentation_enabled());
+}
+
+BOOST_AUTO_TEST_CASE(test_single_identifiers_record_every_stage)
+{
+    visus::cuid2::Generator generator;
+    visus::cuid2::reset_stats();
+
+    constexpr uint64_t COUNT = 100;
+    for (uint64_t idx = 0; idx < COUNT; ++idx) {
+        static_cast<void>(generator.next());
+    }
+
+    const auto SNAPSHOT = visus::cuid2::stats();
+
+    BOOST_TEST(SNAPSHOT.identifiers == COUNT);
+    BOOST_TEST(SNAPSHOT[Stage::counter].calls == COUNT);
+    BOOST_TEST(SNAPSHOT[Stage::random].calls == COUNT);
+    BOOST_TEST(SNAPSHOT[Stage::hash].calls == COUNT);
+    BOOST_TEST(SNAPSHOT[Stage::encode].calls == COUNT);
+    BOOST_TEST(SNAPSHOT[Stage::hash].cycles > 0U);
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_reserves_counter_once)
+{
+    visus::cuid2::Generator generator;
+    visus::cuid2::reset_stats();
+
+    std::vector<std::string> ids(300);
+    generator.next_batch(ids);
+
+    const auto SNAPSHOT = visus::cuid2::stats();
+
+    BOOST_TEST(SNAPSHOT.identifiers == ids.size());
+    BOOST_TEST(SNAPSHOT[Stage::counter].calls == 1U);
+    BOOST_TEST(SNAPSHOT[Stage::encode].calls == ids.size());
+}
+
+BOOST_AUTO_TEST_CASE(test_reset_starts_new_window)
+{
+    visus::cuid2::Generator generator;
+    static_cast<void>(generator.next());
+
+    visus::cuid2::reset_stats();
+    const auto SNAPSHOT = visus::cuid2::stats();
+
+    BOOST_TEST(SNAPSHOT.identifiers == 0U);
+    for (const auto& stage : SNAPSHOT.stages) {
+        BOOST_TEST(stage.calls == 0U);
+        BOOST_TEST(stage.cycles == 0U);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_counts_survive_thread_exit)
+{
+    constexpr int THREADS = 4;
+    constexpr uint64_t PER_THREAD = 50;
+
+    visus::cuid2::reset_stats();
+
+    std::vector<std::thread> workers;
+    for (int idx = 0; idx < THREADS; ++idx) {
+        workers.emplace_back([] {
+            visus::cuid2::Generator generator;
+            for (uint64_t count = 0; count < PER_THREAD; ++count) {
+                static_cast<void>(generator.next());
+            }
+        });
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    BOOST_TEST(visus::cuid2::stats().identifiers == THREADS * PER_THREAD);
+}
+
+BOOST_AUTO_TEST_CASE(test_callback_interval)
+{
+    const CallbackGuard GUARD;
+    visus::cuid2::Generator generator;
+
+    std::atomic<int> calls{0};
+    uint64_t last_identifiers = 0;
+
+    visus::cuid2::set_stats_callback([&](const visus::cuid2::Stats& snapshot) {
+        ++calls;
+        last_identifiers = snapshot.identifiers;
+    }, 10);
+
+    visus::cuid2::reset_stats();
+    for (int idx = 0; idx < 35; ++idx) {
+        static_cast<void>(generator.next());
+    }
+
+    BOOST_TEST(calls.load() == 3);
+    BOOST_TEST(last_identifiers == 30U);
+
+    visus::cuid2::set_stats_callback({}, 0);
+    for (int idx = 0; idx < 20; ++idx) {
+        static_cast<void>(generator.next());
+    }
+
+    BOOST_TEST(calls.load() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_callback_rejects_zero_interval)
+{
+    BOOST_CHECK_THROW(visus::cuid2::set_stats_callback([](const visus::cuid2::Stats&) {}, 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
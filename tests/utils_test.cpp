@@ -1,6 +1,9 @@
 #define BOOST_TEST_MODULE UtilsTest
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <span>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
@@ -48,6 +51,90 @@ BOOST_AUTO_TEST_CASE(test_encode_base36_known_values)
     BOOST_TEST(RESULT_256 == "74");
 }
 
+BOOST_AUTO_TEST_CASE(test_encode_base36_digest_all_zeros)
+{
+    const visus::cuid2::utils::Digest DIGEST{};
+
+    BOOST_TEST(visus::cuid2::utils::encode_base36(DIGEST) == "0");
+}
+
+BOOST_AUTO_TEST_CASE(test_encode_base36_digest_known_values)
+{
+    visus::cuid2::utils::Digest digest{};
+
+    digest.back() = 42;
+    BOOST_TEST(visus::cuid2::utils::encode_base36(digest) == "16");
+
+    // 36^12 exercises a full chunk of zero digits below the leading digit
+    const std::array<uint8_t, 8> CHUNK_DIVISOR{0x41, 0xC2, 0x1C, 0xB8, 0xE1, 0x00, 0x00, 0x00};
+    digest = {};
+    std::copy(CHUNK_DIVISOR.begin(), CHUNK_DIVISOR.end(), digest.end() - CHUNK_DIVISOR.size());
+    BOOST_TEST(visus::cuid2::utils::encode_base36(digest) == "1000000000000");
+}
+
+BOOST_AUTO_TEST_CASE(test_encode_base36_digest_matches_generic)
+{
+    std::vector<visus::cuid2::utils::Digest> digests;
+
+    visus::cuid2::utils::Digest all_ones{};
+    all_ones.fill(0xFF);
+    digests.push_back(all_ones);
+
+    for (size_t leading_zeros = 0; leading_zeros <= visus::cuid2::utils::DIGEST_SIZE; leading_zeros += 7) {
+        visus::cuid2::utils::Digest digest{};
+        visus::cuid2::platform::get_random_bytes(digest.data(), digest.size());
+        std::fill_n(digest.begin(), leading_zeros, 0);
+        digests.push_back(digest);
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+        visus::cuid2::utils::Digest digest{};
+        visus::cuid2::platform::get_random_bytes(digest.data(), digest.size());
+        digests.push_back(digest);
+    }
+
+    for (const auto& digest : digests) {
+        const std::string FAST = visus::cuid2::utils::encode_base36(digest);
+        const std::string GENERIC = visus::cuid2::utils::encode_base36(std::span<const uint8_t>(digest));
+
+        BOOST_TEST(FAST == GENERIC);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_encode_base36_prefix_edge_cases)
+{
+    const std::vector<uint8_t> EMPTY_DATA{};
+    const std::vector<uint8_t> ZERO_DATA{0, 0, 0, 0};
+    const std::vector<uint8_t> DATA_256{1, 0};
+
+    BOOST_TEST(visus::cuid2::utils::encode_base36_prefix(EMPTY_DATA, 5) == "0");
+    BOOST_TEST(visus::cuid2::utils::encode_base36_prefix(ZERO_DATA, 5) == "0");
+    BOOST_TEST(visus::cuid2::utils::encode_base36_prefix(DATA_256, 0).empty());
+    BOOST_TEST(visus::cuid2::utils::encode_base36_prefix(DATA_256, 1) == "7");
+    BOOST_TEST(visus::cuid2::utils::encode_base36_prefix(DATA_256, 10) == "74");
+}
+
+BOOST_AUTO_TEST_CASE(test_encode_base36_prefix_matches_full_encoding)
+{
+    const std::vector<size_t> SIZES{1, 7, 8, 9, 15, 16, 31, 32, 63, 64, 65, 100, 200};
+
+    for (const size_t SIZE : SIZES) {
+        for (int i = 0; i < 50; ++i) {
+            std::vector<uint8_t> data(SIZE);
+            visus::cuid2::platform::get_random_bytes(data.data(), data.size());
+            if (i % 5 == 0) {
+                std::fill_n(data.begin(), SIZE / 2, 0);
+            }
+
+            const std::string FULL = visus::cuid2::utils::encode_base36(std::span<const uint8_t>(data));
+
+            for (const size_t DIGITS : {size_t{1}, size_t{3}, size_t{11}, size_t{12}, size_t{13}, size_t{23}, size_t{31}, FULL.size(), FULL.size() + 5}) {
+                BOOST_TEST(visus::cuid2::utils::encode_base36_prefix(data, DIGITS) == FULL.substr(0, DIGITS));
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_generate_prefix_valid_letters)
 {
     for (int i = 0; i < 100; ++i) {
@@ -73,4 +160,37 @@ BOOST_AUTO_TEST_CASE(test_get_timestamp_ticks_monotonic)
     BOOST_TEST(T2 >= T1);
 }
 
+BOOST_AUTO_TEST_CASE(test_get_coarse_timestamp_ticks_tracks_precise)
+{
+    // Within a generous multiple of any scheduler tick of the precise clock
+    constexpr int64_t TOLERANCE = 1'000'000; // 100 ms in ticks
+
+    const int64_t BEFORE = visus::cuid2::utils::get_timestamp_ticks();
+    const int64_t COARSE = visus::cuid2::utils::get_coarse_timestamp_ticks();
+    const int64_t AFTER = visus::cuid2::utils::get_timestamp_ticks();
+
+    BOOST_TEST(COARSE > BEFORE - TOLERANCE);
+    BOOST_TEST(COARSE <= AFTER + TOLERANCE);
+
+#ifdef __linux__
+    BOOST_TEST(visus::cuid2::utils::has_coarse_clock());
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(test_get_coarse_timestamp_ticks_advances)
+{
+    const int64_t FIRST = visus::cuid2::utils::get_coarse_timestamp_ticks();
+    const auto DEADLINE = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    int64_t last = FIRST;
+    while (last == FIRST && std::chrono::steady_clock::now() < DEADLINE) {
+        const int64_t NOW = visus::cuid2::utils::get_coarse_timestamp_ticks();
+
+        BOOST_TEST_REQUIRE(NOW >= last);
+        last = NOW;
+    }
+
+    BOOST_TEST(last > FIRST);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
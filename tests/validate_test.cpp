@@ -0,0 +1,209 @@
+#define BOOST_TEST_MODULE ValidateTest
+
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+
+#include "cuid2/cuid2.hpp"
+#include "validate_kernels.hpp"
+
+namespace {
+    using visus::cuid2::validation::Backend;
+
+    constexpr std::array<Backend, 4> ALL_BACKENDS = {Backend::scalar, Backend::sse42, Backend::avx2, Backend::neon};
+
+    /// Reference check written directly from the grammar.
+    bool is_base36_reference(const std::string_view TEXT) {
+        for (const char CHR : TEXT) {
+            if (!((CHR >= '0' && CHR <= '9') || (CHR >= 'a' && CHR <= 'z'))) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /// Returns a valid identifier of LENGTH characters using every digit and letter.
+    std::string make_identifier(const size_t LENGTH) {
+        std::string result(LENGTH, '\0');
+
+        for (size_t idx = 0; idx < LENGTH; ++idx) {
+            result[idx] = visus::cuid2::utils::BASE36_ALPHABET[(idx * 7 + 10) % 36];
+        }
+        result[0] = 'k';
+
+        return result;
+    }
+
+    /// Boolean results without std::vector<bool>'s packed storage.
+    struct Results {
+        std::unique_ptr<bool[]> values;
+        size_t count;
+
+        explicit Results(const size_t COUNT) : values(std::make_unique<bool[]>(COUNT)), count(COUNT) {}
+
+        std::span<bool> span() const {
+            return {values.get(), count};
+        }
+    };
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(ValidateTests)
+
+BOOST_AUTO_TEST_CASE(test_detected_backend_supported)
+{
+    BOOST_TEST(visus::cuid2::validation::is_supported(Backend::scalar));
+    BOOST_TEST(visus::cuid2::validation::is_supported(visus::cuid2::validation::detect_backend()));
+}
+
+BOOST_AUTO_TEST_CASE(test_kernels_match_reference)
+{
+    // Every byte value at every position, for every length, so each overlapping
+    // load and every vector lane is exercised
+    for (const Backend BACKEND : ALL_BACKENDS) {
+        if (!visus::cuid2::validation::is_supported(BACKEND)) {
+            continue;
+        }
+
+        const auto KERNELS = visus::cuid2::validation::kernels_for(BACKEND);
+
+        BOOST_TEST_CONTEXT("backend " << visus::cuid2::validation::backend_name(BACKEND)) {
+            for (size_t length = visus::cuid2::MIN_CUID2_LENGTH; length <= visus::cuid2::MAX_CUID2_LENGTH; ++length) {
+                // Exact kernels get a buffer of exactly LENGTH bytes; padded
+                // ones get PADDED_READ bytes with invalid bytes after LENGTH
+                std::vector<char> exact(length);
+                std::vector<char> padded(visus::cuid2::validation::PADDED_READ, '!');
+
+                for (size_t position = 0; position < length; ++position) {
+                    for (int byte = 0; byte < 256; ++byte) {
+                        const std::string BASE = make_identifier(length);
+                        std::copy(BASE.begin(), BASE.end(), exact.begin());
+                        std::copy(BASE.begin(), BASE.end(), padded.begin());
+                        exact[position] = static_cast<char>(byte);
+                        padded[position] = static_cast<char>(byte);
+
+                        const bool EXPECTED = is_base36_reference(std::string_view(exact.data(), length));
+
+                        BOOST_TEST_REQUIRE(KERNELS.exact(exact.data(), length) == EXPECTED,
+                            "exact length " << length << " position " << position << " byte " << byte);
+                        BOOST_TEST_REQUIRE(KERNELS.padded(padded.data(), length) == EXPECTED,
+                            "padded length " << length << " position " << position << " byte " << byte);
+                    }
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_is_cuid2)
+{
+    BOOST_TEST(visus::cuid2::is_cuid2("a000"));
+    BOOST_TEST(visus::cuid2::is_cuid2("zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz"));
+    BOOST_TEST(visus::cuid2::is_cuid2(make_identifier(24)));
+
+    BOOST_TEST(!visus::cuid2::is_cuid2(""));
+    BOOST_TEST(!visus::cuid2::is_cuid2("abc"));
+    BOOST_TEST(!visus::cuid2::is_cuid2(std::string(33, 'a')));
+    BOOST_TEST(!visus::cuid2::is_cuid2("0abc"));
+    BOOST_TEST(!visus::cuid2::is_cuid2("Abcd"));
+    BOOST_TEST(!visus::cuid2::is_cuid2("abcD"));
+    BOOST_TEST(!visus::cuid2::is_cuid2("abc-"));
+    BOOST_TEST(!visus::cuid2::is_cuid2(std::string_view("ab\0d", 4)));
+}
+
+BOOST_AUTO_TEST_CASE(test_is_cuid2_expected_length)
+{
+    const std::string ID = make_identifier(24);
+
+    BOOST_TEST(visus::cuid2::is_cuid2(ID, 24));
+    BOOST_TEST(!visus::cuid2::is_cuid2(ID, 23));
+    BOOST_TEST(!visus::cuid2::is_cuid2(ID, 25));
+    BOOST_TEST(!visus::cuid2::is_cuid2("abc", 3));
+    BOOST_TEST(!visus::cuid2::is_cuid2(ID, -1));
+}
+
+BOOST_AUTO_TEST_CASE(test_validate_batch_views)
+{
+    const std::string LONG = make_identifier(32);
+    const std::vector<std::string_view> IDS = {"a000", "0abc", LONG, "abc", "abcd-", "k2p9"};
+    const Results RESULTS(IDS.size());
+
+    visus::cuid2::validate_batch(IDS, RESULTS.span());
+
+    const std::array<bool, 6> EXPECTED = {true, false, true, false, false, true};
+    for (size_t idx = 0; idx < IDS.size(); ++idx) {
+        BOOST_TEST(RESULTS.values[idx] == EXPECTED[idx], "index " << idx);
+    }
+
+    visus::cuid2::validate_batch(IDS, RESULTS.span(), 4);
+    BOOST_TEST(RESULTS.values[0]);
+    BOOST_TEST(!RESULTS.values[2]);
+    BOOST_TEST(RESULTS.values[5]);
+}
+
+BOOST_AUTO_TEST_CASE(test_validate_batch_views_size_mismatch)
+{
+    const std::vector<std::string_view> IDS = {"a000", "b000"};
+    const Results RESULTS(1);
+
+    BOOST_CHECK_THROW(visus::cuid2::validate_batch(IDS, RESULTS.span()), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_validate_column)
+{
+    // Enough records that early ones take the padded path and the last ones
+    // the exact path, for packed and padded layouts
+    for (const int LENGTH : {4, 16, 24, 32}) {
+        for (const size_t STRIDE : {static_cast<size_t>(LENGTH), static_cast<size_t>(LENGTH) + 3, size_t{40}}) {
+            constexpr size_t COUNT = 20;
+            const auto RECORD_LENGTH = static_cast<size_t>(LENGTH);
+
+            // Trailing padding of a record is garbage and must be ignored;
+            // the buffer ends right after the last record
+            std::vector<char> column((COUNT - 1) * STRIDE + RECORD_LENGTH, '#');
+            for (size_t idx = 0; idx < COUNT; ++idx) {
+                const std::string ID = make_identifier(RECORD_LENGTH);
+                std::copy(ID.begin(), ID.end(), column.begin() + static_cast<std::ptrdiff_t>(idx * STRIDE));
+            }
+
+            // Break every third record at a different position
+            for (size_t idx = 0; idx < COUNT; idx += 3) {
+                column[idx * STRIDE + idx % RECORD_LENGTH] = idx % 2 == 0 ? 'A' : '.';
+            }
+
+            const Results RESULTS(COUNT);
+            visus::cuid2::validate_batch(column, STRIDE, LENGTH, RESULTS.span());
+
+            for (size_t idx = 0; idx < COUNT; ++idx) {
+                BOOST_TEST(RESULTS.values[idx] == (idx % 3 != 0),
+                    "length " << LENGTH << " stride " << STRIDE << " record " << idx);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_validate_column_rejects_bad_layout)
+{
+    const std::vector<char> COLUMN(96, 'a');
+    const Results RESULTS(4);
+
+    BOOST_CHECK_THROW(visus::cuid2::validate_batch(COLUMN, 24, 3, RESULTS.span()), std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::validate_batch(COLUMN, 24, 33, RESULTS.span()), std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::validate_batch(COLUMN, 20, 24, RESULTS.span()), std::invalid_argument);
+    BOOST_CHECK_THROW(visus::cuid2::validate_batch(COLUMN, 32, 24, RESULTS.span()), std::invalid_argument);
+    BOOST_CHECK_THROW(
+        visus::cuid2::validate_batch(std::span<const char>(COLUMN.data(), 8), 24, 24, RESULTS.span()),
+        std::invalid_argument);
+
+    // Four packed records fit exactly; an empty batch needs no data at all
+    BOOST_CHECK_NO_THROW(visus::cuid2::validate_batch(COLUMN, 24, 24, RESULTS.span()));
+    BOOST_CHECK_NO_THROW(visus::cuid2::validate_batch(std::span<const char>(), 24, 24, std::span<bool>()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()